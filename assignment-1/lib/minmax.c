@@ -0,0 +1,89 @@
+/*
+ * libminmax public entry points: argument checking and strategy dispatch.
+ */
+#include "minmax_impl.h"
+#include <stddef.h>
+
+static const struct {
+    const char     *name;
+    minmax_flat_fn  fn;
+} flat_strategies[MINMAX_NUM_STRATEGIES] = {
+    [MINMAX_SEQUENTIAL]   = { "sequential",   minmax_sequential   },
+    [MINMAX_PARALLEL_FOR] = { "parallel_for", minmax_parallel_for },
+    [MINMAX_SECTIONS]     = { "sections",     minmax_sections     },
+    [MINMAX_NESTED]       = { "nested",       minmax_nested       },
+    [MINMAX_SIMD]         = { "simd",         minmax_simd         },
+    [MINMAX_OMP_SIMD]     = { "omp_simd",     minmax_omp_simd     },
+    [MINMAX_TILED]        = { "tiled",        minmax_tiled        },
+    [MINMAX_TASKS]        = { "tasks",        minmax_tasks        },
+    [MINMAX_BRANCHLESS]   = { "branchless",   minmax_branchless   },
+    [MINMAX_ULTIMATE]     = { "ultimate",     minmax_ultimate     },
+    [MINMAX_TASKS_ADAPTIVE] = { "tasks_adaptive", minmax_tasks_adaptive },
+    [MINMAX_NUMA]         = { "numa",         minmax_numa         },
+    [MINMAX_STREAM]       = { "stream",       minmax_stream       },
+    [MINMAX_FIXED]        = { "fixed",        minmax_fixed        },
+};
+
+static const struct {
+    const char    *name;
+    minmax_ptr_fn  fn;
+} ptr_strategies[MINMAX_PTR_NUM_STRATEGIES] = {
+    [MINMAX_PTR_SEQUENTIAL]   = { "ptr_sequential",   minmax_ptr_sequential   },
+    [MINMAX_PTR_PARALLEL_FOR] = { "ptr_parallel_for", minmax_ptr_parallel_for },
+    [MINMAX_PTR_SECTIONS]     = { "ptr_sections",     minmax_ptr_sections     },
+    [MINMAX_PTR_COMBINED]     = { "ptr_combined",     minmax_ptr_combined     },
+};
+
+int minmax_loc_3d(const int *a, int M, int N, int P, minmax_strategy s,
+                  MinMaxLoc *min, MinMaxLoc *max)
+{
+    if (!a || !min || !max || M <= 0 || N <= 0 || P <= 0)
+        return -1;
+    if ((unsigned)s >= MINMAX_NUM_STRATEGIES)
+        return -1;
+
+    flat_strategies[s].fn(a, M, N, P, min, max);
+    return 0;
+}
+
+int minmax_loc_3d_ptr(int *const *const *a, int M, int N, int P,
+                      minmax_ptr_strategy s, MinMaxLoc *min, MinMaxLoc *max)
+{
+    if (!a || !min || !max || M <= 0 || N <= 0 || P <= 0)
+        return -1;
+    if ((unsigned)s >= MINMAX_PTR_NUM_STRATEGIES)
+        return -1;
+
+    ptr_strategies[s].fn(a, M, N, P, min, max);
+    return 0;
+}
+
+int minmax_loc_3d_roi(const int *a, int M, int N, int P, const minmax_box *box,
+                      MinMaxLoc *min, MinMaxLoc *max)
+{
+    if (!a || !box || !min || !max || M <= 0 || N <= 0 || P <= 0)
+        return -1;
+    if (box->i0 < 0 || box->i0 >= box->i1 || box->i1 > M ||
+        box->j0 < 0 || box->j0 >= box->j1 || box->j1 > N ||
+        box->k0 < 0 || box->k0 >= box->k1 || box->k1 > P)
+        return -1;
+
+    minmax_ultimate_box(a, N, P, box->i0, box->i1, box->j0, box->j1,
+                        box->k0, box->k1, min, max);
+    return 0;
+}
+
+const char *minmax_strategy_name(minmax_strategy s)
+{
+    return (unsigned)s < MINMAX_NUM_STRATEGIES ? flat_strategies[s].name : NULL;
+}
+
+const char *minmax_ptr_strategy_name(minmax_ptr_strategy s)
+{
+    return (unsigned)s < MINMAX_PTR_NUM_STRATEGIES ? ptr_strategies[s].name : NULL;
+}
+
+const char *minmax_isa(void)
+{
+    return scan_kernels()->name;
+}
@@ -0,0 +1,734 @@
+#ifndef MINMAX_H
+#define MINMAX_H
+
+/*
+ * libminmax — minimum and maximum (with location) of a 3D int matrix.
+ *
+ * Every strategy from assignment 1 is available behind one entry point, so
+ * the kernels can be called from other code without copying the drivers:
+ *
+ *     MinMaxLoc mn, mx;
+ *     minmax_loc_3d(a, M, N, P, MINMAX_ULTIMATE, &mn, &mx);
+ *
+ * The matrix is a contiguous row-major a[M][N][P] (element (i,j,k) at
+ * IDX(i,j,k,N,P)), or the int*** layout for the original required versions.
+ * All functions are thread-safe; parallel strategies use the calling
+ * thread's OpenMP settings (OMP_NUM_THREADS, omp_set_num_threads, ...).
+ *
+ * Link with -lminmax (static bin/libminmax.a or shared bin/libminmax.so)
+ * and -fopenmp.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Value plus its (i, j, k) position. On ties the first position in
+ * row-major order is reported. */
+typedef struct {
+    int val;
+    int i, j, k;
+} MinMaxLoc;
+
+/* Flat 3D indexing of the contiguous layout (64-bit, so M*N*P may exceed 2^31) */
+#define IDX(i, j, k, N, P) ((long)(i)*(N)*(P) + (long)(j)*(P) + (k))
+
+/* Strategies over the contiguous layout (one per *_flat / optimized / novel driver) */
+typedef enum {
+    MINMAX_SEQUENTIAL = 0,  /* sequential_flat:    single-threaded reference      */
+    MINMAX_PARALLEL_FOR,    /* version1_optimized: collapse(2) + declare reduction */
+    MINMAX_SECTIONS,        /* version2_optimized: min / max in two sections       */
+    MINMAX_NESTED,          /* version3_optimized: sections + inner parallel for   */
+    MINMAX_SIMD,            /* novel_simd_avx2:    per-thread SIMD chunks          */
+    MINMAX_OMP_SIMD,        /* novel_omp_simd:     omp simd values, then indices   */
+    MINMAX_TILED,           /* novel_tiled:        cache tiles + prefetch          */
+    MINMAX_TASKS,           /* novel_tasks:        fused min+max task tree, 64K leaves */
+    MINMAX_BRANCHLESS,      /* novel_branchless:   mask-select updates             */
+    MINMAX_ULTIMATE,        /* novel_ultimate:     tiles + prefetch + SIMD rows    */
+    MINMAX_TASKS_ADAPTIVE,  /* novel_tasks_adaptive: task tree, leaves per thread  */
+    MINMAX_NUMA,            /* novel_numa:         pinned node slabs, two-level merge */
+    MINMAX_STREAM,          /* novel_stream:       aligned thread ranges, 4 accumulators, NT loads */
+    MINMAX_FIXED,           /* novel_fixed:        compile-time (N, P) kernels, else ultimate */
+    MINMAX_NUM_STRATEGIES
+} minmax_strategy;
+
+/* Strategies over the int*** layout (the required Q1-Q3 versions) */
+typedef enum {
+    MINMAX_PTR_SEQUENTIAL = 0,  /* sequential:            pseudocode translation */
+    MINMAX_PTR_PARALLEL_FOR,    /* version1_parallel_for: parallel for + critical */
+    MINMAX_PTR_SECTIONS,        /* version2_sections:     two sections            */
+    MINMAX_PTR_COMBINED,        /* version3_combined:     sections + parallel for */
+    MINMAX_PTR_NUM_STRATEGIES
+} minmax_ptr_strategy;
+
+/*
+ * Find the minimum and maximum of a[M][N][P] with strategy s.
+ * Returns 0 on success, -1 if an argument is invalid (NULL pointer,
+ * non-positive dimension, unknown strategy); *min / *max are then untouched.
+ */
+int minmax_loc_3d(const int *a, int M, int N, int P, minmax_strategy s,
+                  MinMaxLoc *min, MinMaxLoc *max);
+
+/* Same for the pointer-of-pointer layout a[i][j][k] */
+int minmax_loc_3d_ptr(int *const *const *a, int M, int N, int P,
+                      minmax_ptr_strategy s, MinMaxLoc *min, MinMaxLoc *max);
+
+/* Region of interest [i0,i1) x [j0,j1) x [k0,k1) of a parent volume */
+typedef struct {
+    int i0, i1;
+    int j0, j1;
+    int k0, k1;
+} minmax_box;
+
+/*
+ * Min/max of the sub-volume *box of the parent a[M][N][P], scanned in place
+ * (no copy) with the ultimate tiled SIMD strategy. Positions are reported
+ * in parent coordinates; minmax_roi_local() converts them to box-relative
+ * ones. Returns 0, or -1 on invalid arguments (including an empty box or
+ * one not inside the parent).
+ */
+int minmax_loc_3d_roi(const int *a, int M, int N, int P, const minmax_box *box,
+                      MinMaxLoc *min, MinMaxLoc *max);
+
+/* Parent-space position -> position relative to the box origin */
+static inline MinMaxLoc minmax_roi_local(const minmax_box *box, MinMaxLoc loc)
+{
+    loc.i -= box->i0;
+    loc.j -= box->j0;
+    loc.k -= box->k0;
+    return loc;
+}
+
+/* ---- Known value bounds (minmax_bounded.c) ----
+ *
+ * When every value is known to lie in [lo, hi] (a sensor range, a clipped
+ * or saturated volume), a block holding lo settles the minimum: nothing
+ * after it can be smaller or come first. The scan walks the volume in
+ * blocks, in index order across the team, and stops looking for the min
+ * past the first such block, and for the max past the first block that
+ * holds hi; once both are settled the remaining blocks are skipped.
+ * Blocks before the settling one are still scanned, so ties resolve to
+ * the first occurrence as in minmax_loc_3d(). If some value lies outside
+ * the bounds the result is only guaranteed for the blocks scanned.
+ */
+
+/* *scanned (may be NULL) gets the number of elements read. Returns 0, or
+ * -1 on invalid arguments (including lo > hi). */
+int minmax_loc_3d_bounded(const int *a, int M, int N, int P, int lo, int hi,
+                          MinMaxLoc *min, MinMaxLoc *max, long *scanned);
+
+/* ---- Fused statistics (minmax_stats.c) ----
+ *
+ * Min/max with location, exact int64 sum, mean, population variance and
+ * an optional histogram in one pass: the extra arithmetic runs on blocks
+ * already in L1, so it costs about as much as the min/max scan alone.
+ */
+typedef struct {
+    MinMaxLoc min, max;         /* same positions as minmax_loc_3d()        */
+    long      count;
+    long long sum;              /* exact                                    */
+    double    mean;
+    double    variance;         /* population: sum((x - mean)^2) / count    */
+} minmax_stats;
+
+#define MINMAX_HIST_MAX_BINS (1 << 24)
+
+/* nbins equal-width bins over [lo, hi]: bin of v = (v - lo) * nbins / (hi - lo + 1) */
+typedef struct {
+    int   lo, hi;
+    int   nbins;                /* 1..MINMAX_HIST_MAX_BINS                  */
+    long *bins;                 /* caller-owned, nbins entries; overwritten */
+    long  below, above;         /* out: values < lo / > hi                  */
+} minmax_hist;
+
+/* h may be NULL (no histogram). Returns 0, or -1 on invalid arguments or
+ * out of memory. */
+int minmax_stats_3d(const int *a, int M, int N, int P, minmax_stats *st, minmax_hist *h);
+
+/* ---- Batched queries (minmax_batch.c) ----
+ *
+ * Several questions about one volume answered in a single tiled pass:
+ * each tile is brought into cache once and every query whose box covers
+ * it is updated from there, so a batch of 16 queries costs about one
+ * memory pass over their bounding box instead of 16.
+ */
+typedef enum {
+    MINMAX_QUERY_MINMAX = 0,    /* min / max with location over the box   */
+    MINMAX_QUERY_COUNT_ABOVE,   /* number of elements > threshold         */
+    MINMAX_QUERY_NUM_KINDS
+} minmax_query_kind;
+
+typedef struct {
+    /* in */
+    int        kind;            /* minmax_query_kind                      */
+    minmax_box box;             /* {0, M, 0, N, 0, P} for the whole volume */
+    int        threshold;       /* COUNT_ABOVE only                       */
+    /* out */
+    MinMaxLoc  min, max;        /* MINMAX: parent coordinates, as _roi()  */
+    long       count;           /* COUNT_ABOVE                            */
+} minmax_query;
+
+/*
+ * Answer q[0..nq) over a[M][N][P]. Returns 0, or -1 on invalid arguments
+ * (same box rules as minmax_loc_3d_roi(), unknown kind) or out of memory;
+ * no results are written then.
+ */
+int minmax_query_batch(const int *a, int M, int N, int P, minmax_query *q, int nq);
+
+/* ---- Zone map (minmax_zonemap.c) ----
+ *
+ * A tree of per-tile min/max summaries over a volume, built once in one
+ * parallel pass. Full-volume queries (box == NULL) are answered from the
+ * tree alone; ROI queries only scan the shell cut by the box boundary.
+ * The index references a[] (no copy): keep the buffer alive and change it
+ * only through minmax_index_update(). Results match minmax_loc_3d() / _roi().
+ */
+typedef struct minmax_index minmax_index;
+
+/* NULL on invalid arguments or out of memory */
+minmax_index *minmax_index_build(const int *a, int M, int N, int P);
+void          minmax_index_free(minmax_index *ix);
+
+/* Returns 0, or -1 on invalid arguments (same box rules as _roi()) */
+int minmax_index_query(const minmax_index *ix, const minmax_box *box,
+                       MinMaxLoc *min, MinMaxLoc *max);
+
+/* One point write: a[i][j][k] = val */
+typedef struct {
+    int i, j, k;
+    int val;
+} minmax_update;
+
+/*
+ * Apply n updates to a[] (the indexed buffer) and the index, in batch
+ * order, so the last write to a cell wins. Only tiles whose extreme cell
+ * was overwritten with a worse value are rescanned. Returns 0, or -1 if a
+ * is not the indexed buffer, a position is out of range (nothing is
+ * written then) or out of memory.
+ */
+int minmax_index_update(minmax_index *ix, int *a, const minmax_update *u, long n);
+
+/* ---- Bit-packed volumes (minmax_bitpack.c) ----
+ *
+ * A compressed copy of a[M][N][P]: blocks of MINMAX_BITPACK_BLOCK
+ * elements, each stored frame-of-reference as (value - block min) in just
+ * enough bits for the block's range, behind a header holding the block's
+ * exact min and max. 17-bit data (the generator's [0, 99999] plus the
+ * planted -1 / 100000) takes about 54% of the int32 footprint. A scan
+ * reads only the headers: a block whose header cannot beat the running
+ * best is skipped, and the two winning blocks are decoded, in registers,
+ * to locate the first occurrence. Results and tie-breaking are those of
+ * minmax_loc_3d().
+ */
+typedef struct minmax_bitpack minmax_bitpack;
+
+#define MINMAX_BITPACK_BLOCK 1024
+
+/* Pack in one parallel pass; NULL on invalid arguments or out of memory */
+minmax_bitpack *minmax_bitpack_build(const int *a, int M, int N, int P);
+void            minmax_bitpack_free(minmax_bitpack *bp);
+
+/* Bytes held by the packed copy (headers + codes) */
+size_t minmax_bitpack_bytes(const minmax_bitpack *bp);
+
+/* Returns 0, or -1 on invalid arguments */
+int minmax_bitpack_loc(const minmax_bitpack *bp, MinMaxLoc *min, MinMaxLoc *max);
+
+/* Decode the whole volume into a[M][N][P]. Returns 0, or -1 on invalid arguments. */
+int minmax_bitpack_unpack(const minmax_bitpack *bp, int *a);
+
+/* Short names ("ultimate", "tiled", ...), NULL for an unknown strategy */
+const char *minmax_strategy_name(minmax_strategy s);
+const char *minmax_ptr_strategy_name(minmax_ptr_strategy s);
+
+/* Instruction set the SIMD kernels were dispatched to ("avx2", "neon", ...) */
+const char *minmax_isa(void);
+
+/* Whether MINMAX_FIXED has a compile-time specialised kernel for rows of
+ * P elements in planes of N rows on this host (any M); other shapes run
+ * MINMAX_ULTIMATE (minmax_fixed.c) */
+int minmax_fixed_specialized(int N, int P);
+
+/* ---- Merge of per-thread winners (minmax_merge.c) ----
+ *
+ * The strategies that fold their threads' results under a lock
+ * (MINMAX_PTR_PARALLEL_FOR, MINMAX_PTR_COMBINED, MINMAX_SIMD,
+ * MINMAX_BRANCHLESS) can instead merge lock-free: every thread does one
+ * CAS-based fetch-min on a packed 64-bit (value, flat index) word, which
+ * keeps the lowest index on ties. CRITICAL, the default, is the code as
+ * written for the assignment. The initial mode comes from
+ * MINMAX_MERGE=critical|lockfree; volumes of 2^32 elements or more always
+ * merge under the lock. Set the mode before starting kernels, not while
+ * they run.
+ */
+typedef enum {
+    MINMAX_MERGE_CRITICAL = 0,
+    MINMAX_MERGE_LOCKFREE,
+    MINMAX_MERGE_NUM_MODES
+} minmax_merge;
+
+/* Returns 0, or -1 for an unknown mode */
+int          minmax_set_merge(minmax_merge m);
+minmax_merge minmax_get_merge(void);
+
+/* "critical", "lockfree"; NULL for an unknown mode */
+const char *minmax_merge_name(minmax_merge m);
+
+/* ---- Streaming scan (minmax_stream.c) ----
+ *
+ * MINMAX_STREAM gives each thread one contiguous, 64 B-aligned range and
+ * runs the dispatched streaming kernel over it: SCAN_STREAM_ACC
+ * independent accumulator sets, software prefetch prefetch_bytes ahead
+ * (0 = hardware prefetcher only) and, with nontemporal set, NTA prefetches
+ * and MOVNTDQA loads for data that is read once. The initial settings come
+ * from MINMAX_PREFETCH=<bytes> (default 4096) and MINMAX_NT=0|1 (default 0).
+ * Like the merge mode, set them before starting kernels.
+ */
+typedef struct {
+    long prefetch_bytes;
+    int  nontemporal;
+} minmax_stream_params;
+
+#define MINMAX_STREAM_PREFETCH_DEFAULT 4096
+
+/* Returns 0, or -1 for a negative prefetch distance */
+int  minmax_set_stream(const minmax_stream_params *p);
+void minmax_get_stream(minmax_stream_params *p);
+
+/* ---- Top-K (minmax_topk.c) ----
+ *
+ * The k smallest and k largest values of a[M][N][P] with their positions,
+ * in one parallel pass. smallest[] is filled in ascending order, largest[]
+ * in descending order (arrays of k entries; either may be NULL); equal
+ * values are ordered by position, so smallest[0] / largest[0] match
+ * minmax_loc_3d(). Intended for k up to a few thousand. Returns 0, or -1
+ * on invalid arguments (including k <= 0 or k > M*N*P) or out of memory.
+ */
+int minmax_topk_3d(const int *a, int M, int N, int P, int k,
+                   MinMaxLoc *smallest, MinMaxLoc *largest);
+
+/* ---- Other element types (minmax_typed.c) ----
+ *
+ * MINMAX_TYPES(X) expands X(suffix, type) once per supported element type;
+ * for each it declares
+ *
+ *     typedef struct { type val; int i, j, k; } MinMaxLoc_<suffix>;
+ *     int minmax_loc_3d_<suffix>(const type *a, int M, int N, int P,
+ *                                MinMaxLoc_<suffix> *min, MinMaxLoc_<suffix> *max);
+ *
+ * e.g. minmax_loc_3d_u16() for uint16_t sensor volumes. These always run
+ * the parallel SIMD scan (no strategy argument). Ties report the first
+ * position, as above. Floating-point NaNs are ignored; if every element is
+ * NaN the result is a[0] at (0, 0, 0). Returns 0, or -1 on invalid arguments.
+ */
+#define MINMAX_TYPES(X) \
+    X(i8,  int8_t)   X(u8,  uint8_t)  \
+    X(i16, int16_t)  X(u16, uint16_t) \
+    X(i32, int32_t)  X(u32, uint32_t) \
+    X(i64, int64_t)  X(u64, uint64_t) \
+    X(f32, float)    X(f64, double)
+
+#define MINMAX_DECLARE_TYPED(sfx, T) \
+    typedef struct { T val; int i, j, k; } MinMaxLoc_##sfx; \
+    int minmax_loc_3d_##sfx(const T *a, int M, int N, int P, \
+                            MinMaxLoc_##sfx *min, MinMaxLoc_##sfx *max);
+MINMAX_TYPES(MINMAX_DECLARE_TYPED)
+
+/* ---- File-backed volumes (minmax_io.c) ----
+ *
+ * Files hold little-endian int32 a[M][N][P], raw or behind a 32-byte
+ * "MINMAXV1" header carrying the shape (written by minmax_volume_write()).
+ */
+
+#define MINMAX_VOLUME_HEADER_BYTES 32
+
+/* minmax_volume_open() flags */
+#define MINMAX_MAP_POPULATE 1u   /* prefault the whole mapping (MAP_POPULATE) */
+
+/* Default streaming chunk: 64 MB per buffer, two buffers in flight */
+#define MINMAX_STREAM_DEFAULT_CHUNK ((size_t)64 << 20)
+
+typedef struct {
+    const int *data;    /* a[M][N][P], read-only, directly in the mapping */
+    int M, N, P;
+    void  *map;         /* internal: mapping base and length */
+    size_t map_len;
+} minmax_volume;
+
+/*
+ * Map a volume file read-only (no copy into a heap buffer) and advise the
+ * kernel for sequential access and transparent huge pages. Pass M = N = P
+ * = 0 to take the shape from the header; raw files need the shape. Any
+ * minmax_loc_3d() strategy can then run on vol->data. Returns 0 or -1.
+ */
+int  minmax_volume_open(const char *path, int M, int N, int P, unsigned flags,
+                        minmax_volume *vol);
+void minmax_volume_close(minmax_volume *vol);
+
+/*
+ * Shape and byte offset of the data in a volume file, without mapping it
+ * (for readers that fetch their own part, e.g. MPI-IO). *M, *N, *P in/out
+ * with the same rules as minmax_volume_open(). Returns 0 or -1.
+ */
+int  minmax_volume_probe(const char *path, int *M, int *N, int *P, long *data_offset);
+
+/* Write a[M][N][P] as a headed volume file. Returns 0 or -1. */
+int  minmax_volume_write(const char *path, const int *a, int M, int N, int P);
+
+/*
+ * Out-of-core scan: read the file in chunk_bytes pieces (0 = default) into
+ * two buffers, reducing one with the OpenMP team while an I/O thread fills
+ * the other. Memory use is 2 x chunk_bytes regardless of file size; indices
+ * are global. Same shape rules as minmax_volume_open(). Returns 0 or -1.
+ */
+int  minmax_loc_file_stream(const char *path, int M, int N, int P, size_t chunk_bytes,
+                            MinMaxLoc *min, MinMaxLoc *max);
+
+/* ---- Query service (minmax_service.c) ----
+ *
+ * Serves minmax_query requests from many client threads over one shared,
+ * read-only volume. Calling the kernels directly from C clients starts C
+ * OpenMP teams of omp_get_max_threads() threads each and oversubscribes
+ * the machine. Instead, clients enqueue requests into a bounded queue, and
+ * `workers` service threads each run one pass at a time on a fixed share
+ * of threads / workers cores, so the passes in flight never use more than
+ * `threads` cores. A worker takes everything queued (up to batch_max) in
+ * one go: MINMAX requests are answered from the zone map when the service
+ * built one, and the rest are coalesced into a single
+ * minmax_query_batch() pass. At low load requests therefore run alone,
+ * and under load they share memory passes instead of competing for
+ * bandwidth. Each request reports its queueing, run and total latency.
+ * The volume must stay unchanged while the service exists.
+ */
+typedef struct minmax_service minmax_service;
+
+#define MINMAX_SERVICE_DEFAULT_QUEUE 1024
+#define MINMAX_SERVICE_DEFAULT_BATCH 16
+
+/* Zero-initialised fields take the defaults */
+typedef struct {
+    int threads;    /* cores for all passes together; <= 0: omp_get_num_procs()     */
+    int workers;    /* passes in flight; <= 0: threads / 4, at least 1, <= threads  */
+    int queue;      /* request queue capacity; <= 0: MINMAX_SERVICE_DEFAULT_QUEUE    */
+    int batch_max;  /* requests per pass; <= 0: MINMAX_SERVICE_DEFAULT_BATCH, 1: off */
+    int index;      /* build a zone map, answer MINMAX requests from it             */
+} minmax_service_config;
+
+typedef struct {
+    /* in / out: kind, box, threshold; results as minmax_query_batch() */
+    minmax_query q;
+    /* out */
+    int    status;          /* 0, or -1 if the pass failed (out of memory)     */
+    double queue_us;        /* submit -> a worker takes it                     */
+    double run_us;          /* pass that answered it                           */
+    double total_us;        /* submit -> done                                  */
+    int    batch;           /* requests answered by that pass (1: alone/index) */
+    int    threads;         /* cores the pass ran on                           */
+    /* internal */
+    int    done_;
+    double submit_;
+} minmax_request;
+
+/* NULL on invalid arguments, out of memory or if any worker could not start */
+minmax_service *minmax_service_create(const int *a, int M, int N, int P,
+                                      const minmax_service_config *cfg);
+/* Answers every queued request, then stops the workers */
+void            minmax_service_free(minmax_service *s);
+
+/* Enqueue r, blocking while the queue is full. r must stay valid until
+ * minmax_service_wait() returns. Returns 0, or -1 for an invalid query
+ * (minmax_query_batch() rules) or a stopping service. */
+int minmax_service_submit(minmax_service *s, minmax_request *r);
+/* Block until r is answered; returns r->status */
+int minmax_service_wait(minmax_service *s, minmax_request *r);
+/* submit + wait */
+int minmax_service_query(minmax_service *s, minmax_request *r);
+
+typedef struct {
+    long   submitted, completed, failed;
+    long   passes;          /* batch passes and index lookups run              */
+    long   coalesced;       /* requests answered by a pass of two or more      */
+    long   index_hits;
+    double max_total_us;
+    int    threads, workers, share;   /* share: cores per pass                */
+} minmax_service_stats;
+
+void minmax_service_get_stats(minmax_service *s, minmax_service_stats *st);
+
+/* ---- Pipelined ingest (minmax_pipeline.c) ----
+ *
+ * For volumes that arrive in slabs of i-planes: a producer fills slab s+1
+ * (from a file, a socket, a generator) while OpenMP tasks scan slab s and
+ * fold it into the running result, so the end-to-end time approaches
+ * max(ingest, scan) instead of their sum. The producer is called in slab
+ * order, one call at a time, on one of the team's threads.
+ */
+
+/* Fill buf with planes i0 .. i0+planes-1 of a[M][N][P] (buf[0] is
+ * a[i0][0][0]); return 0, or non-zero to abort the pipeline */
+typedef int (*minmax_slab_fn)(void *user, int *buf, int i0, int planes, int N, int P);
+
+/* Default slab: 16 MB of whole planes (at least one) */
+#define MINMAX_PIPELINE_DEFAULT_SLAB ((size_t)16 << 20)
+
+typedef struct {
+    double produce;     /* seconds inside produce(), summed over slabs */
+    double scan;        /* seconds scanning and folding, summed over slabs */
+    double wall;        /* end to end */
+    int    slabs, slab_planes;
+} minmax_pipeline_timing;
+
+/*
+ * Min/max with location over a volume delivered by produce(), slab_planes
+ * planes at a time (0 = MINMAX_PIPELINE_DEFAULT_SLAB) with depth buffers
+ * in flight (0 = 2, double buffering). timing may be NULL. Results and
+ * tie-breaking are those of minmax_loc_3d(). Returns 0, or -1 on invalid
+ * arguments, allocation failure or a failed produce() call.
+ */
+int minmax_loc_pipeline(int M, int N, int P, int slab_planes, int depth,
+                        minmax_slab_fn produce, void *user,
+                        MinMaxLoc *min, MinMaxLoc *max, minmax_pipeline_timing *timing);
+
+/* ---- Arena allocation and padded rows (minmax_alloc.c) ----
+ *
+ * An arena is one anonymous mapping, 2 MB aligned and rounded up to whole
+ * 2 MB pages, from which the matrix, its pointer tables or per-thread
+ * scratch are carved with a bump pointer. Huge pages cut the TLB misses of
+ * a streaming scan over hundreds of MB; carving the int*** layout from one
+ * arena replaces M*N + M + 1 small mallocs. Pages are not touched at init,
+ * so first-touch placement (parallel fills, minmax_numa_touch()) still
+ * decides where they land.
+ */
+typedef enum {
+    MINMAX_PAGES_THP = 0,       /* madvise(MADV_HUGEPAGE): transparent huge pages */
+    MINMAX_PAGES_HUGETLB,       /* MAP_HUGETLB from the reserved pool, else THP   */
+    MINMAX_PAGES_SMALL,         /* MADV_NOHUGEPAGE: 4 KB pages, for comparison    */
+    MINMAX_PAGES_NUM_KINDS
+} minmax_pages;
+
+typedef struct {
+    char        *base;
+    size_t       bytes;         /* mapped                                     */
+    size_t       used;
+    minmax_pages pages;         /* what was obtained (HUGETLB may fall back)  */
+} minmax_arena;
+
+/* Returns 0, or -1 on bytes == 0, an unknown kind or if mmap fails */
+int   minmax_arena_init(minmax_arena *ar, size_t bytes, minmax_pages pages);
+/* align: a power of two (0 = MINMAX_ROW_ALIGN). NULL if the arena is full. */
+void *minmax_arena_alloc(minmax_arena *ar, size_t bytes, size_t align);
+void  minmax_arena_release(minmax_arena *ar);
+
+/* "thp", "hugetlb", "small"; NULL for an unknown kind */
+const char *minmax_pages_name(minmax_pages p);
+
+/* Row alignment of the padded layout: one cache line, a whole AVX-512 vector */
+#define MINMAX_ROW_ALIGN 64
+
+/* Elements per row of the padded layout: P rounded up to MINMAX_ROW_ALIGN */
+static inline long minmax_row_stride(int P)
+{
+    long per = MINMAX_ROW_ALIGN / (long)sizeof(int);
+    return ((long)P + per - 1) / per * per;
+}
+
+/*
+ * Min/max of a padded a[M][N][stride] (element (i,j,k) at
+ * ((long)i*N + j)*stride + k, stride >= P; the padding is never read).
+ * With a MINMAX_ROW_ALIGN-aligned base and stride = minmax_row_stride(P)
+ * every row starts on a cache line, so no vector load straddles two lines.
+ * Positions are logical (i, j, k), ties as minmax_loc_3d(). Returns 0, or
+ * -1 on invalid arguments.
+ */
+int minmax_loc_3d_padded(const int *a, int M, int N, int P, long stride,
+                         MinMaxLoc *min, MinMaxLoc *max);
+
+/* ---- Query context (minmax_ctx.c) ----
+ *
+ * For many small scans of one shape: a context keeps a pool of spinning
+ * worker threads, padded per-worker result slots and a fixed partition of
+ * the volume, so a query costs one wake-up and one fold instead of a
+ * parallel region. Inputs below 64K elements are scanned by the caller
+ * alone, larger ones use at most one worker per 64K elements. Results
+ * match minmax_loc_3d(). One query at a time per context; the array may
+ * change between queries, the shape may not.
+ */
+typedef struct minmax_ctx minmax_ctx;
+
+/* threads <= 0: omp_get_max_threads(). NULL on invalid arguments or if the
+ * workers could not be started. */
+minmax_ctx *minmax_ctx_create(int M, int N, int P, int threads);
+void        minmax_ctx_free(minmax_ctx *c);
+
+/* Min/max of a[M][N][P] (the context's shape). Returns 0, or -1 on NULL. */
+int minmax_ctx_query(minmax_ctx *c, const int *a, MinMaxLoc *min, MinMaxLoc *max);
+
+/* Threads a query runs on, the caller included */
+int minmax_ctx_threads(const minmax_ctx *c);
+
+/* ---- NUMA placement (minmax_numa.c) ----
+ *
+ * MINMAX_NUMA pins the OpenMP threads node by node (topology from
+ * /sys/devices/system/node; MINMAX_NUMA_NODES=n fakes n nodes) and gives
+ * every node one contiguous slab of the volume, scanned by its own
+ * threads and reduced per node before the nodes are merged. The scan only
+ * stays node-local if the pages were first touched by the same threads:
+ * call minmax_numa_touch() on a freshly allocated buffer, before filling
+ * it, with the thread count the scans will use. Worker threads stay
+ * pinned afterwards; the caller's own affinity is restored.
+ */
+
+/* Number of NUMA nodes with usable CPUs (1 on UMA hosts) */
+int minmax_numa_nodes(void);
+
+/* Zero a[0..n) from the thread that will scan each page. Returns the node
+ * count, or -1 on invalid arguments. */
+int minmax_numa_touch(int *a, long n);
+
+/* ---- Accelerator offload (minmax_offload.c, minmax_cuda.cu) ----
+ *
+ * A device volume is a copy of a[M][N][P] in accelerator memory, uploaded
+ * once and then queried any number of times, so repeated queries pay only
+ * the kernel. MINMAX_DEV_OPENMP runs `omp target teams distribute parallel
+ * for` with a (value, index) reduction on the default OpenMP device; with
+ * no device configured (plain -fopenmp, or OMP_TARGET_OFFLOAD=disabled) the
+ * region falls back to the host, so the backend always works. MINMAX_DEV_CUDA
+ * is a hand-written warp-shuffle argmin/argmax, built with `make CUDA=1`.
+ * Results match minmax_loc_3d(). The host array may be freed after upload.
+ */
+typedef enum {
+    MINMAX_DEV_OPENMP = 0,
+    MINMAX_DEV_CUDA,
+    MINMAX_DEV_NUM_BACKENDS
+} minmax_dev_backend;
+
+typedef struct minmax_dev minmax_dev;
+
+/* Seconds spent, filled by the calls below (either pointer may be NULL) */
+typedef struct {
+    double transfer;        /* allocation + host -> device copy (upload)  */
+    double kernel;          /* reduction on the device, result readback   */
+} minmax_dev_timing;
+
+/* Devices the backend can use: 0 means the OpenMP backend runs on the host,
+ * -1 that the backend was not built. */
+int minmax_dev_count(minmax_dev_backend b);
+
+/* Copy a[M][N][P] to the device. NULL on invalid arguments, an unavailable
+ * backend or out of device memory. */
+minmax_dev *minmax_dev_upload(minmax_dev_backend b, const int *a, int M, int N, int P,
+                              minmax_dev_timing *t);
+void        minmax_dev_free(minmax_dev *d);
+
+/* Min/max of the resident volume. Returns 0, or -1 on NULL or a device error. */
+int minmax_dev_query(minmax_dev *d, MinMaxLoc *min, MinMaxLoc *max, minmax_dev_timing *t);
+
+/* "openmp", "cuda"; NULL for an unknown backend */
+const char *minmax_dev_backend_name(minmax_dev_backend b);
+
+/* ---- Tuning (minmax_tune.c) ----
+ *
+ * The tiled, ultimate, ROI and task strategies read their tile size,
+ * prefetch distance, schedule and task leaf size from a per-host table
+ * keyed by shape and thread count; shapes without an entry use the
+ * built-in defaults (minmax_tuning_default()). At startup the library loads
+ * the entries for this CPU model from the cache file: $MINMAX_TUNE_FILE,
+ * else $XDG_CACHE_HOME/minmax/tuning.tsv, else ~/.cache/minmax/tuning.tsv
+ * (MINMAX_TUNE_FILE= disables it). `bench --tune` searches the space and
+ * writes the file. Changing the table while kernels run is not supported.
+ */
+typedef enum {
+    MINMAX_SCHED_STATIC = 0,
+    MINMAX_SCHED_DYNAMIC,
+    MINMAX_SCHED_GUIDED,
+    MINMAX_SCHED_NUM
+} minmax_schedule;
+
+typedef struct {
+    int  tile_target;       /* elements per cache tile (32768 = 128 KB)           */
+    int  tiles_per_thread;  /* tiles are split until each thread gets this many   */
+    int  prefetch_rows;     /* ultimate look-ahead in rows for row segments, 0 = off */
+    int  schedule;          /* minmax_schedule of the tile loops                  */
+    int  chunk;             /* schedule chunk in tiles, 0 = OpenMP default        */
+    long task_leaf;         /* MINMAX_TASKS leaf size in elements                 */
+} minmax_tuning;
+
+void minmax_tuning_default(minmax_tuning *t);
+
+/* Entry used for a[M][N][P] on `threads` threads (the defaults if none) */
+void minmax_tuning_get(int M, int N, int P, int threads, minmax_tuning *t);
+
+/* Add or replace the entry for (M, N, P, threads). Returns 0 or -1. */
+int  minmax_tuning_set(int M, int N, int P, int threads, const minmax_tuning *t);
+
+/* Read / write a cache file (NULL = the default path above). Loading keeps
+ * only this CPU model's lines; saving rewrites this model's lines and
+ * keeps the rest. Return the number of entries read / 0, or -1. */
+int  minmax_tuning_load(const char *path);
+int  minmax_tuning_save(const char *path);
+
+/* Cache key for this host: /proc/cpuinfo model name (or implementer/part) */
+const char *minmax_cpu_model(void);
+
+/* "static", "dynamic", "guided"; NULL for an unknown schedule */
+const char *minmax_schedule_name(minmax_schedule s);
+
+/* ---- Hardware counters (minmax_perf.c) ----
+ *
+ * Optional perf_event counters, compiled in with `make PERF=1`
+ * (-DMINMAX_PERF, Linux only); otherwise minmax_perf_open() returns NULL
+ * and the other calls do nothing. Every OpenMP thread counts its own work:
+ * start/stop run a parallel region in which each thread (re)opens,
+ * resets and reads counters bound to itself, so a kernel called in between
+ * with the same team is counted per thread. Events the CPU or kernel does
+ * not offer (no PMU in a VM, perf_event_paranoid) are left out of `valid`.
+ * Spin-waiting at barriers counts as work; run with
+ * OMP_WAIT_POLICY=passive to see imbalance as idle time instead.
+ */
+typedef enum {
+    MINMAX_PERF_CYCLES = 0,
+    MINMAX_PERF_INSTRUCTIONS,
+    MINMAX_PERF_LLC_REFERENCES,
+    MINMAX_PERF_LLC_MISSES,
+    MINMAX_PERF_BRANCHES,
+    MINMAX_PERF_BRANCH_MISSES,
+    MINMAX_PERF_TASK_CLOCK,     /* ns on a CPU */
+    MINMAX_PERF_PAGE_FAULTS,
+    MINMAX_PERF_NUM_EVENTS
+} minmax_perf_event;
+
+/* Bytes per LLC miss, for the memory traffic estimate */
+#define MINMAX_PERF_LINE_BYTES 64
+
+typedef struct {
+    uint64_t count[MINMAX_PERF_NUM_EVENTS];   /* scaled if multiplexed */
+} minmax_perf_counts;
+
+typedef struct minmax_perf minmax_perf;
+
+/* NULL if built without MINMAX_PERF or out of memory */
+minmax_perf *minmax_perf_open(void);
+void         minmax_perf_close(minmax_perf *pc);
+
+/* Returns 0, or -1 if pc is NULL */
+int minmax_perf_start(minmax_perf *pc);
+int minmax_perf_stop(minmax_perf *pc);
+
+/* After minmax_perf_stop(): threads that took part, one thread's counts,
+ * their sum, and the mask of events (1u << e) measured on every thread */
+int      minmax_perf_threads(const minmax_perf *pc);
+const minmax_perf_counts *minmax_perf_thread(const minmax_perf *pc, int t);
+void     minmax_perf_total(const minmax_perf *pc, minmax_perf_counts *sum);
+unsigned minmax_perf_valid(const minmax_perf *pc);
+
+/* Short names ("cycles", "llc-misses", ...), NULL for an unknown event */
+const char *minmax_perf_event_name(minmax_perf_event e);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MINMAX_H */
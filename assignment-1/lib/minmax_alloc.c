@@ -0,0 +1,134 @@
+/*
+ * Arena allocator (huge pages, 2 MB alignment) and the padded-row scan.
+ *
+ * malloc() hands a 477 MB matrix to mmap with 4 KB pages at an address
+ * that is 16 bytes past a page boundary, and the int*** layout does
+ * 250,501 separate mallocs scattered over the heap. An arena maps one
+ * region instead: over-allocate by 2 MB, unmap the ragged ends so the
+ * base is 2 MB aligned, then ask for transparent huge pages; with
+ * MINMAX_PAGES_HUGETLB it first tries the explicit hugetlbfs pool, which
+ * is usually empty unless vm.nr_hugepages was raised. Allocation is a bump
+ * pointer with per-request alignment and nothing is freed individually.
+ *
+ * The padded scan takes rows of stride >= P elements. With a 64 B stride
+ * every row begins on a cache line, so the dispatched kernels' unaligned
+ * load instructions never split a line (on current x86 and ARM cores an
+ * unaligned load of aligned data costs the same as an aligned load, so
+ * the kernels need no separate aligned variant). Each thread scans a
+ * contiguous run of rows; padded flat indices ascend with (i, j, k), so the
+ * flat combiners keep the first occurrence and one conversion at the end
+ * gives the logical position.
+ */
+#include "minmax_impl.h"
+#include <string.h>
+#include <sys/mman.h>
+
+#define ARENA_HUGE (2UL << 20)
+
+static const char *const pages_names[MINMAX_PAGES_NUM_KINDS] = { "thp", "hugetlb", "small" };
+
+const char *minmax_pages_name(minmax_pages p)
+{
+    return (unsigned)p < MINMAX_PAGES_NUM_KINDS ? pages_names[p] : NULL;
+}
+
+/* Anonymous mapping of len bytes (a multiple of 2 MB) at a 2 MB boundary */
+static void *map_aligned(size_t len)
+{
+    char *raw = mmap(NULL, len + ARENA_HUGE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED)
+        return NULL;
+    char *base = (char *)(((uintptr_t)raw + ARENA_HUGE - 1) & ~(uintptr_t)(ARENA_HUGE - 1));
+    if (base > raw)
+        munmap(raw, (size_t)(base - raw));
+    if (base + len < raw + len + ARENA_HUGE)
+        munmap(base + len, (size_t)(raw + len + ARENA_HUGE - (base + len)));
+    return base;
+}
+
+int minmax_arena_init(minmax_arena *ar, size_t bytes, minmax_pages pages)
+{
+    if (!ar || bytes == 0 || (unsigned)pages >= MINMAX_PAGES_NUM_KINDS)
+        return -1;
+    if (bytes > SIZE_MAX - 2 * ARENA_HUGE)
+        return -1;
+
+    size_t len = (bytes + ARENA_HUGE - 1) & ~(ARENA_HUGE - 1);
+    void *base = NULL;
+
+#ifdef MAP_HUGETLB
+    if (pages == MINMAX_PAGES_HUGETLB) {
+        base = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base == MAP_FAILED)
+            base = NULL;
+    }
+#endif
+    if (!base) {
+        if (pages == MINMAX_PAGES_HUGETLB)
+            pages = MINMAX_PAGES_THP;
+        base = map_aligned(len);
+        if (!base)
+            return -1;
+#ifdef MADV_HUGEPAGE
+        if (pages == MINMAX_PAGES_THP)
+            madvise(base, len, MADV_HUGEPAGE);
+#endif
+#ifdef MADV_NOHUGEPAGE
+        if (pages == MINMAX_PAGES_SMALL)
+            madvise(base, len, MADV_NOHUGEPAGE);
+#endif
+    }
+
+    *ar = (minmax_arena){ base, len, 0, pages };
+    return 0;
+}
+
+void *minmax_arena_alloc(minmax_arena *ar, size_t bytes, size_t align)
+{
+    if (!ar || !ar->base)
+        return NULL;
+    if (align == 0)
+        align = MINMAX_ROW_ALIGN;
+    if (align & (align - 1))
+        return NULL;
+
+    size_t off = (ar->used + align - 1) & ~(align - 1);
+    if (off > ar->bytes || bytes > ar->bytes - off)
+        return NULL;
+    ar->used = off + bytes;
+    return ar->base + off;
+}
+
+void minmax_arena_release(minmax_arena *ar)
+{
+    if (!ar || !ar->base)
+        return;
+    munmap(ar->base, ar->bytes);
+    memset(ar, 0, sizeof(*ar));
+}
+
+int minmax_loc_3d_padded(const int *a, int M, int N, int P, long stride,
+                         MinMaxLoc *min, MinMaxLoc *max)
+{
+    if (!a || !min || !max || M <= 0 || N <= 0 || P <= 0 || stride < P)
+        return -1;
+
+    const ScanKernels *sk = scan_kernels();
+    long rows = (long)M * N;
+    ValIdx vmin = { INT_MAX, LONG_MAX }, vmax = { INT_MIN, LONG_MAX };
+
+    #pragma omp parallel for schedule(static) reduction(valmin : vmin) reduction(valmax : vmax)
+    for (long r = 0; r < rows; r++)
+        sk->minmax(a, r * stride, r * stride + P, &vmin, &vmax);
+
+    vmin.idx = validx_index(&vmin);
+    vmax.idx = validx_index(&vmax);
+
+    /* Padded flat index -> row, then logical (i, j, k) */
+    long rmin = vmin.idx / stride, rmax = vmax.idx / stride;
+    *min = (MinMaxLoc){ vmin.val, (int)(rmin / N), (int)(rmin % N), (int)(vmin.idx % stride) };
+    *max = (MinMaxLoc){ vmax.val, (int)(rmax / N), (int)(rmax % N), (int)(vmax.idx % stride) };
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Flat-layout baseline and optimized versions: sequential_flat and
+ * version{1,2,3}_optimized. See the driver files for the rationale behind
+ * each improvement (contiguous memory, declare reduction, collapse(2)).
+ */
+#include "minmax_impl.h"
+
+/* sequential_flat.c — fair single-threaded baseline on the contiguous layout */
+void minmax_sequential(const int *a, int M, int N, int P,
+                       MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    int min_i = 0, min_j = 0, min_k = 0;
+    int max_i = 0, max_j = 0, max_k = 0;
+
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < N; j++) {
+            for (int k = 0; k < P; k++) {
+                if (a[IDX(i, j, k, N, P)] > a[IDX(max_i, max_j, max_k, N, P)]) {
+                    max_i = i;
+                    max_j = j;
+                    max_k = k;
+                }
+                if (a[IDX(i, j, k, N, P)] < a[IDX(min_i, min_j, min_k, N, P)]) {
+                    min_i = i;
+                    min_j = j;
+                    min_k = k;
+                }
+            }
+        }
+    }
+
+    *vmin = (MinMaxLoc){ a[IDX(min_i, min_j, min_k, N, P)], min_i, min_j, min_k };
+    *vmax = (MinMaxLoc){ a[IDX(max_i, max_j, max_k, N, P)], max_i, max_j, max_k };
+}
+
+/* version1_optimized.c — collapse(2) + declare reduction(minloc/maxloc) */
+void minmax_parallel_for(const int *a, int M, int N, int P,
+                         MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    MinMaxLoc vmin = { .val = INT_MAX, .i = 0, .j = 0, .k = 0 };
+    MinMaxLoc vmax = { .val = INT_MIN, .i = 0, .j = 0, .k = 0 };
+
+    #pragma omp parallel for collapse(2) schedule(static) \
+            reduction(minloc : vmin) reduction(maxloc : vmax)
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < N; j++) {
+            for (int k = 0; k < P; k++) {
+                int val = a[IDX(i, j, k, N, P)];
+                if (val > vmax.val) {
+                    vmax.val = val;
+                    vmax.i = i;
+                    vmax.j = j;
+                    vmax.k = k;
+                }
+                if (val < vmin.val) {
+                    vmin.val = val;
+                    vmin.i = i;
+                    vmin.j = j;
+                    vmin.k = k;
+                }
+            }
+        }
+    }
+
+    *out_min = vmin;
+    *out_max = vmax;
+}
+
+/* version2_optimized.c — two sections over contiguous memory */
+void minmax_sections(const int *a, int M, int N, int P,
+                     MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    int min_i = 0, min_j = 0, min_k = 0;
+    int max_i = 0, max_j = 0, max_k = 0;
+
+    #pragma omp parallel sections shared(a, M, N, P, min_i, min_j, min_k, max_i, max_j, max_k)
+    {
+        /* Section 1: find minimum */
+        #pragma omp section
+        {
+            for (int i = 0; i < M; i++) {
+                for (int j = 0; j < N; j++) {
+                    for (int k = 0; k < P; k++) {
+                        if (a[IDX(i, j, k, N, P)] < a[IDX(min_i, min_j, min_k, N, P)]) {
+                            min_i = i;
+                            min_j = j;
+                            min_k = k;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* Section 2: find maximum */
+        #pragma omp section
+        {
+            for (int i = 0; i < M; i++) {
+                for (int j = 0; j < N; j++) {
+                    for (int k = 0; k < P; k++) {
+                        if (a[IDX(i, j, k, N, P)] > a[IDX(max_i, max_j, max_k, N, P)]) {
+                            max_i = i;
+                            max_j = j;
+                            max_k = k;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    *vmin = (MinMaxLoc){ a[IDX(min_i, min_j, min_k, N, P)], min_i, min_j, min_k };
+    *vmax = (MinMaxLoc){ a[IDX(max_i, max_j, max_k, N, P)], max_i, max_j, max_k };
+}
+
+/* version3_optimized.c — sections + inner collapse(2) parallel for with declare reduction */
+void minmax_nested(const int *a, int M, int N, int P,
+                   MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    MinMaxLoc vmin = { .val = INT_MAX, .i = 0, .j = 0, .k = 0 };
+    MinMaxLoc vmax = { .val = INT_MIN, .i = 0, .j = 0, .k = 0 };
+
+    int saved_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+
+    int total_threads = omp_get_max_threads();
+    int inner_threads = (total_threads > 2) ? total_threads / 2 : 1;
+
+    #pragma omp parallel sections num_threads(2)
+    {
+        /* Section 1: find minimum */
+        #pragma omp section
+        {
+            #pragma omp parallel for collapse(2) schedule(static) \
+                    reduction(minloc : vmin) num_threads(inner_threads)
+            for (int i = 0; i < M; i++) {
+                for (int j = 0; j < N; j++) {
+                    for (int k = 0; k < P; k++) {
+                        int val = a[IDX(i, j, k, N, P)];
+                        if (val < vmin.val) {
+                            vmin.val = val;
+                            vmin.i = i;
+                            vmin.j = j;
+                            vmin.k = k;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* Section 2: find maximum */
+        #pragma omp section
+        {
+            #pragma omp parallel for collapse(2) schedule(static) \
+                    reduction(maxloc : vmax) num_threads(inner_threads)
+            for (int i = 0; i < M; i++) {
+                for (int j = 0; j < N; j++) {
+                    for (int k = 0; k < P; k++) {
+                        int val = a[IDX(i, j, k, N, P)];
+                        if (val > vmax.val) {
+                            vmax.val = val;
+                            vmax.i = i;
+                            vmax.j = j;
+                            vmax.k = k;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    omp_set_max_active_levels(saved_levels);
+
+    *out_min = vmin;
+    *out_max = vmax;
+}
@@ -0,0 +1,220 @@
+/*
+ * Batched queries: answer many min/max and count questions about one
+ * volume in a single tiled traversal.
+ *
+ * Tiles from minmax_tile_shape() are laid over the bounding box of all
+ * queries, as in minmax_ultimate_box(). Before the traversal every query is
+ * turned into the range of tiles it touches and the queries are sorted by
+ * their first tile plane, so a tile only walks the prefix of queries that
+ * can reach its plane. For each tile, each overlapping query scans its
+ * intersection with the tile; the tile (~128 KB) stays in L2 between
+ * queries, so DRAM is read about once however many queries cover it.
+ * Runs are merged across rows / planes where the intersection spans them.
+ *
+ * Each thread folds into its own row of accumulators (padded apart); rows
+ * are merged at the end with the position-aware combiners, so results
+ * match minmax_loc_3d_roi() exactly, first occurrence on ties.
+ */
+#include "minmax_impl.h"
+#include <stdlib.h>
+
+#define BATCH_PARALLEL_MIN (1L << 16)
+
+typedef struct {
+    MinMaxLoc min, max;
+    long      count;
+} BatchAcc;
+
+/* Accumulators a thread adds past its row, so rows never share a line */
+#define BATCH_ROW_PAD ((64 + (int)sizeof(BatchAcc) - 1) / (int)sizeof(BatchAcc))
+
+typedef struct {
+    int q;                  /* index into the caller's array       */
+    int t0[3], t1[3];       /* tile range [t0, t1) along i, j, k   */
+} BatchRef;
+
+static int cmp_ref(const void *x, const void *y)
+{
+    const BatchRef *a = x, *b = y;
+    return (a->t0[0] > b->t0[0]) - (a->t0[0] < b->t0[0]);
+}
+
+static long count_above(const int *a, long base, long len, int thr)
+{
+    long cnt = 0;
+    #pragma omp simd reduction(+ : cnt)
+    for (long x = 0; x < len; x++)
+        cnt += a[base + x] > thr;
+    return cnt;
+}
+
+/* Runs shorter than this are scanned inline: with thin boxes over a small
+ * P the kernel call would cost more than the handful of elements */
+#define BATCH_SHORT_RUN 16
+
+/* Runs of one box ascend in flat order, so they fold into one flat best
+ * with strict compares and are converted to (i, j, k) once per box */
+typedef struct {
+    ValIdx min, max;
+    long   count;
+} BoxAcc;
+
+static inline void scan_run(const ScanKernels *sk, const int *a, long base, long len,
+                            const minmax_query *q, BoxAcc *acc)
+{
+    if (q->kind != MINMAX_QUERY_MINMAX) {
+        acc->count += count_above(a, base, len, q->threshold);
+    } else if (len >= BATCH_SHORT_RUN) {
+        sk->minmax(a, base, base + len, &acc->min, &acc->max);
+    } else {
+        for (long x = base; x < base + len; x++) {
+            if (a[x] < acc->min.val) { acc->min.val = a[x]; acc->min.idx = x; }
+            if (a[x] > acc->max.val) { acc->max.val = a[x]; acc->max.idx = x; }
+        }
+    }
+}
+
+/* Scan [i0,i1) x [j0,j1) x [k0,k1) for one query, in contiguous runs */
+static void scan_box(const ScanKernels *sk, const int *a, int N, int P,
+                     int i0, int i1, int j0, int j1, int k0, int k1,
+                     const minmax_query *q, BatchAcc *out)
+{
+    BoxAcc acc = { { INT_MAX, -1 }, { INT_MIN, -1 }, 0 };
+
+    if (k0 == 0 && k1 == P && j0 == 0 && j1 == N) {
+        scan_run(sk, a, IDX(i0, 0, 0, N, P), (long)(i1 - i0) * N * P, q, &acc);
+    } else {
+        for (int i = i0; i < i1; i++) {
+            if (k0 == 0 && k1 == P) {
+                scan_run(sk, a, IDX(i, j0, 0, N, P), (long)(j1 - j0) * P, q, &acc);
+                continue;
+            }
+            for (int j = j0; j < j1; j++)
+                scan_run(sk, a, IDX(i, j, k0, N, P), k1 - k0, q, &acc);
+        }
+    }
+
+    out->count += acc.count;
+    if (acc.min.idx >= 0) {
+        MinMaxLoc r = loc_from_flat(acc.min.val, acc.min.idx, N, P);
+        minloc_combine(&out->min, &r);
+    }
+    if (acc.max.idx >= 0) {
+        MinMaxLoc r = loc_from_flat(acc.max.val, acc.max.idx, N, P);
+        maxloc_combine(&out->max, &r);
+    }
+}
+
+static int query_valid(const minmax_query *q, int M, int N, int P)
+{
+    const minmax_box *b = &q->box;
+    return (unsigned)q->kind < MINMAX_QUERY_NUM_KINDS &&
+           b->i0 >= 0 && b->i0 < b->i1 && b->i1 <= M &&
+           b->j0 >= 0 && b->j0 < b->j1 && b->j1 <= N &&
+           b->k0 >= 0 && b->k0 < b->k1 && b->k1 <= P;
+}
+
+static inline int imax(int x, int y) { return x > y ? x : y; }
+static inline int imin(int x, int y) { return x < y ? x : y; }
+
+int minmax_query_batch(const int *a, int M, int N, int P, minmax_query *q, int nq)
+{
+    if (!a || !q || nq <= 0 || M <= 0 || N <= 0 || P <= 0)
+        return -1;
+    for (int x = 0; x < nq; x++)
+        if (!query_valid(&q[x], M, N, P))
+            return -1;
+
+    /* Bounding box of the batch: nothing outside it is read */
+    minmax_box bb = q[0].box;
+    for (int x = 1; x < nq; x++) {
+        bb.i0 = imin(bb.i0, q[x].box.i0); bb.i1 = imax(bb.i1, q[x].box.i1);
+        bb.j0 = imin(bb.j0, q[x].box.j0); bb.j1 = imax(bb.j1, q[x].box.j1);
+        bb.k0 = imin(bb.k0, q[x].box.k0); bb.k1 = imax(bb.k1, q[x].box.k1);
+    }
+    int bm = bb.i1 - bb.i0, bn = bb.j1 - bb.j0, bp = bb.k1 - bb.k0;
+
+    const minmax_tuning *tn = minmax_tuning_active(bm, bn, bp);
+    int ts[3];
+    minmax_tile_shape(bm, bn, bp, tn, &ts[0], &ts[1], &ts[2]);
+    int nt[3] = { (bm + ts[0] - 1) / ts[0], (bn + ts[1] - 1) / ts[1], (bp + ts[2] - 1) / ts[2] };
+    int org[3] = { bb.i0, bb.j0, bb.k0 };
+
+    int T = omp_get_max_threads();
+    int stride = nq + BATCH_ROW_PAD;
+    BatchRef *ref = malloc((size_t)nq * sizeof(BatchRef));
+    BatchAcc *acc = malloc((size_t)T * stride * sizeof(BatchAcc));
+    if (!ref || !acc) {
+        free(ref);
+        free(acc);
+        return -1;
+    }
+
+    /* Tile range of every query, sorted by first i-tile */
+    for (int x = 0; x < nq; x++) {
+        const int lo[3] = { q[x].box.i0, q[x].box.j0, q[x].box.k0 };
+        const int hi[3] = { q[x].box.i1, q[x].box.j1, q[x].box.k1 };
+        ref[x].q = x;
+        for (int d = 0; d < 3; d++) {
+            ref[x].t0[d] = (lo[d] - org[d]) / ts[d];
+            ref[x].t1[d] = (hi[d] - org[d] + ts[d] - 1) / ts[d];
+        }
+    }
+    qsort(ref, (size_t)nq, sizeof(BatchRef), cmp_ref);
+
+    /* Every row starts from the box's first element, so a box whose values
+     * all equal INT_MAX (resp. INT_MIN) still reports a position inside it */
+    for (int x = 0; x < nq; x++) {
+        const minmax_box *b = &q[x].box;
+        MinMaxLoc first = { a[IDX(b->i0, b->j0, b->k0, N, P)], b->i0, b->j0, b->k0 };
+        for (int t = 0; t < T; t++)
+            acc[(long)t * stride + x] = (BatchAcc){ first, first, 0 };
+    }
+
+    const ScanKernels *sk = scan_kernels();
+    long elems = (long)bm * bn * bp;
+
+    minmax_sched_saved saved = minmax_schedule_apply(tn);
+    #pragma omp parallel for collapse(3) schedule(runtime) if (elems >= BATCH_PARALLEL_MIN)
+    for (int ti = 0; ti < nt[0]; ti++) {
+        for (int tj = 0; tj < nt[1]; tj++) {
+            for (int tk = 0; tk < nt[2]; tk++) {
+                BatchAcc *mine = &acc[(long)omp_get_thread_num() * stride];
+                int i_start = org[0] + ti * ts[0], i_end = imin(i_start + ts[0], bb.i1);
+                int j_start = org[1] + tj * ts[1], j_end = imin(j_start + ts[1], bb.j1);
+                int k_start = org[2] + tk * ts[2], k_end = imin(k_start + ts[2], bb.k1);
+
+                for (int r = 0; r < nq && ref[r].t0[0] <= ti; r++) {
+                    const BatchRef *f = &ref[r];
+                    if (ti >= f->t1[0] || tj < f->t0[1] || tj >= f->t1[1] ||
+                        tk < f->t0[2] || tk >= f->t1[2])
+                        continue;
+                    const minmax_box *b = &q[f->q].box;
+                    scan_box(sk, a, N, P,
+                             imax(i_start, b->i0), imin(i_end, b->i1),
+                             imax(j_start, b->j0), imin(j_end, b->j1),
+                             imax(k_start, b->k0), imin(k_end, b->k1),
+                             &q[f->q], &mine[f->q]);
+                }
+            }
+        }
+    }
+    minmax_schedule_restore(saved);
+
+    for (int x = 0; x < nq; x++) {
+        BatchAcc r = acc[x];
+        for (int t = 1; t < T; t++) {
+            BatchAcc *o = &acc[(long)t * stride + x];
+            minloc_combine(&r.min, &o->min);
+            maxloc_combine(&r.max, &o->max);
+            r.count += o->count;
+        }
+        q[x].min   = r.min;
+        q[x].max   = r.max;
+        q[x].count = r.count;
+    }
+
+    free(ref);
+    free(acc);
+    return 0;
+}
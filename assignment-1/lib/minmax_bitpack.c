@@ -0,0 +1,239 @@
+/*
+ * Bit-packed volumes: frame-of-reference blocks with min/max headers.
+ *
+ * The volume is cut into MINMAX_BITPACK_BLOCK-element blocks in flat index
+ * order (the last one padded). Each block stores its exact min and max and
+ * the codes value - min in bits = width(max - min) bits each, laid out as
+ * described in minmax_impl.h; a block of one repeated value takes no code
+ * words at all. Building takes two parallel passes over blocks (headers
+ * with the dispatched min/max kernel, then packing) around a prefix sum of
+ * the block sizes.
+ *
+ * Because the headers are exact, a scan never has to touch a code word
+ * to find the extreme values. Each thread walks its blocks' headers in
+ * order, and a block replaces the thread's best only if its header
+ * strictly beats it, so every other block is skipped outright. The
+ * valmin/valmax reductions over (value, block) keep the lowest block on
+ * ties. Only the two winning blocks are decoded, in registers, to
+ * locate the first occurrence: the first code 0 for the min, the first
+ * code max - min for the max (bitpack_find_avx2(), 8 elements per shift).
+ * Padding holds code 0 and always comes after a real element with the
+ * same code, so it is never reported.
+ *
+ * The AVX2 decoders are used when the dispatched ISA is avx2 or avx512, as
+ * for the fixed-shape kernels; otherwise the scalar decoder below runs.
+ */
+#include "minmax_impl.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int  min, max;
+    long word;                  /* first code word of the block */
+} BitpackBlock;
+
+struct minmax_bitpack {
+    int           M, N, P;
+    long          total, nblocks, nwords;
+    BitpackBlock *blocks;
+    uint32_t     *words;
+};
+
+static inline int block_bits(const BitpackBlock *h)
+{
+    uint32_t range = (uint32_t)h->max - (uint32_t)h->min;
+    return range ? 32 - __builtin_clz(range) : 0;
+}
+
+static inline uint32_t scalar_code(const uint32_t *w, int bits, int x)
+{
+    int pos = (x / BITPACK_LANES) * bits, l = x % BITPACK_LANES;
+    int word = pos >> 5, shift = pos & 31;
+    uint32_t v = w[word * BITPACK_LANES + l] >> shift;
+    if (shift + bits > 32)
+        v |= w[(word + 1) * BITPACK_LANES + l] << (32 - shift);
+    return bits < 32 ? v & ((1u << bits) - 1) : v;
+}
+
+static long scalar_find(const uint32_t *w, int bits, uint32_t code)
+{
+    if (bits == 0)
+        return 0;
+    for (int x = 0; x < MINMAX_BITPACK_BLOCK; x++)
+        if (scalar_code(w, bits, x) == code)
+            return x;
+    return 0;
+}
+
+static void scalar_decode(const uint32_t *w, int bits, int base, int *out)
+{
+    for (int x = 0; x < MINMAX_BITPACK_BLOCK; x++)
+        out[x] = (int)((uint32_t)base + (bits ? scalar_code(w, bits, x) : 0));
+}
+
+/* Whether the AVX2 decoders may run (dispatched ISA avx2 or avx512) */
+static int bitpack_use_avx2(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    const ScanKernels *sk = scan_kernels();
+    return sk == &scan_kernels_avx2 || sk == &scan_kernels_avx512;
+#else
+    return 0;
+#endif
+}
+
+static long bitpack_find(const uint32_t *w, int bits, uint32_t code)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (bitpack_use_avx2())
+        return bitpack_find_avx2(w, bits, code);
+#endif
+    return scalar_find(w, bits, code);
+}
+
+minmax_bitpack *minmax_bitpack_build(const int *a, int M, int N, int P)
+{
+    if (!a || M <= 0 || N <= 0 || P <= 0)
+        return NULL;
+
+    minmax_bitpack *bp = calloc(1, sizeof(*bp));
+    if (!bp)
+        return NULL;
+    bp->M = M; bp->N = N; bp->P = P;
+    bp->total = (long)M * N * P;
+    bp->nblocks = (bp->total + MINMAX_BITPACK_BLOCK - 1) / MINMAX_BITPACK_BLOCK;
+    bp->blocks = malloc((size_t)bp->nblocks * sizeof(BitpackBlock));
+    if (!bp->blocks) {
+        minmax_bitpack_free(bp);
+        return NULL;
+    }
+
+    const ScanKernels *sk = scan_kernels();
+    long total = bp->total;
+
+    /* Pass 1: exact block headers */
+    #pragma omp parallel for schedule(static)
+    for (long b = 0; b < bp->nblocks; b++) {
+        long lo = b * MINMAX_BITPACK_BLOCK;
+        long hi = total - lo > MINMAX_BITPACK_BLOCK ? lo + MINMAX_BITPACK_BLOCK : total;
+        ValIdx bmin = { INT_MAX, LONG_MAX }, bmax = { INT_MIN, LONG_MAX };
+        sk->minmax(a, lo, hi, &bmin, &bmax);
+        /* Strict compares leave the identity when it is the block's value */
+        bp->blocks[b].min = bmin.idx == LONG_MAX ? INT_MAX : bmin.val;
+        bp->blocks[b].max = bmax.idx == LONG_MAX ? INT_MIN : bmax.val;
+    }
+
+    /* Block offsets: 32 words per bit of width */
+    long words = 0;
+    for (long b = 0; b < bp->nblocks; b++) {
+        bp->blocks[b].word = words;
+        words += (long)block_bits(&bp->blocks[b]) * (MINMAX_BITPACK_BLOCK / 32);
+    }
+    bp->nwords = words;
+    if (posix_memalign((void **)&bp->words, 64, (size_t)(words ? words : 1) * sizeof(uint32_t))) {
+        bp->words = NULL;
+        minmax_bitpack_free(bp);
+        return NULL;
+    }
+
+    /* Pass 2: codes, one block per iteration so no word is shared */
+    #pragma omp parallel for schedule(static)
+    for (long b = 0; b < bp->nblocks; b++) {
+        const BitpackBlock *h = &bp->blocks[b];
+        int bits = block_bits(h);
+        if (bits == 0)
+            continue;
+        uint32_t *w = bp->words + h->word;
+        memset(w, 0, (size_t)bits * (MINMAX_BITPACK_BLOCK / 32) * sizeof(uint32_t));
+
+        long lo = b * MINMAX_BITPACK_BLOCK;
+        long n = total - lo > MINMAX_BITPACK_BLOCK ? MINMAX_BITPACK_BLOCK : total - lo;
+        for (long x = 0; x < n; x++) {
+            uint32_t code = (uint32_t)a[lo + x] - (uint32_t)h->min;
+            int pos = (int)(x / BITPACK_LANES) * bits, l = (int)(x % BITPACK_LANES);
+            int word = pos >> 5, shift = pos & 31;
+            w[word * BITPACK_LANES + l] |= code << shift;
+            if (shift + bits > 32)
+                w[(word + 1) * BITPACK_LANES + l] |= code >> (32 - shift);
+        }
+    }
+    return bp;
+}
+
+void minmax_bitpack_free(minmax_bitpack *bp)
+{
+    if (!bp)
+        return;
+    free(bp->blocks);
+    free(bp->words);
+    free(bp);
+}
+
+size_t minmax_bitpack_bytes(const minmax_bitpack *bp)
+{
+    if (!bp)
+        return 0;
+    return sizeof(*bp) + (size_t)bp->nblocks * sizeof(BitpackBlock) +
+           (size_t)bp->nwords * sizeof(uint32_t);
+}
+
+int minmax_bitpack_loc(const minmax_bitpack *bp, MinMaxLoc *min, MinMaxLoc *max)
+{
+    if (!bp || !min || !max)
+        return -1;
+
+    /* idx holds the winning block until the end */
+    ValIdx gmin = { INT_MAX, LONG_MAX }, gmax = { INT_MIN, LONG_MAX };
+
+    #pragma omp parallel for schedule(static) reduction(valmin : gmin) reduction(valmax : gmax)
+    for (long b = 0; b < bp->nblocks; b++) {
+        const BitpackBlock *h = &bp->blocks[b];
+        if (h->min < gmin.val) { gmin.val = h->min; gmin.idx = b; }
+        if (h->max > gmax.val) { gmax.val = h->max; gmax.idx = b; }
+    }
+
+    gmin.idx = validx_index(&gmin);
+    gmax.idx = validx_index(&gmax);
+
+    /* Only the two winning blocks are decoded */
+    const BitpackBlock *hmin = &bp->blocks[gmin.idx], *hmax = &bp->blocks[gmax.idx];
+    long min_idx = gmin.idx * MINMAX_BITPACK_BLOCK +
+                   bitpack_find(bp->words + hmin->word, block_bits(hmin), 0);
+    long max_idx = gmax.idx * MINMAX_BITPACK_BLOCK +
+                   bitpack_find(bp->words + hmax->word, block_bits(hmax),
+                                (uint32_t)hmax->max - (uint32_t)hmax->min);
+
+    *min = loc_from_flat(gmin.val, min_idx, bp->N, bp->P);
+    *max = loc_from_flat(gmax.val, max_idx, bp->N, bp->P);
+    return 0;
+}
+
+int minmax_bitpack_unpack(const minmax_bitpack *bp, int *a)
+{
+    if (!bp || !a)
+        return -1;
+
+    void (*decode)(const uint32_t *, int, int, int *) = scalar_decode;
+#if defined(__x86_64__) || defined(__i386__)
+    if (bitpack_use_avx2())
+        decode = bitpack_decode_avx2;
+#endif
+
+    long full = bp->total / MINMAX_BITPACK_BLOCK;
+
+    #pragma omp parallel for schedule(static)
+    for (long b = 0; b < full; b++) {
+        const BitpackBlock *h = &bp->blocks[b];
+        decode(bp->words + h->word, block_bits(h), h->min, a + b * MINMAX_BITPACK_BLOCK);
+    }
+
+    /* Padded last block through a scratch buffer */
+    if (full < bp->nblocks) {
+        int tail[MINMAX_BITPACK_BLOCK];
+        const BitpackBlock *h = &bp->blocks[full];
+        decode(bp->words + h->word, block_bits(h), h->min, tail);
+        memcpy(a + full * MINMAX_BITPACK_BLOCK, tail,
+               (size_t)(bp->total - full * MINMAX_BITPACK_BLOCK) * sizeof(int));
+    }
+    return 0;
+}
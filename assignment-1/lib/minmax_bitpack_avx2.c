@@ -0,0 +1,62 @@
+/*
+ * AVX2 decoders for the bit-packed blocks of minmax_bitpack.c.
+ *
+ * Group t of a block (elements 8t .. 8t+7) starts at the same bit offset
+ * t * bits in all eight lanes, so one load, one vpsrld by that offset,
+ * for codes that straddle a word an OR with the next word shifted left,
+ * and one vpand yield the eight codes in element order. The offset
+ * advances by `bits` per group without any per-lane arithmetic.
+ *
+ * bitpack_find_avx2() compares each decoded group with the code it looks
+ * for and stops at the first match (cmpeq + movemask + ctz), so locating
+ * a block's min or max never writes the expanded values anywhere.
+ *
+ * Compile with: -mavx2
+ */
+#include "minmax_impl.h"
+#include <immintrin.h>
+
+static inline __m256i decode_group(const uint32_t *w, int bits, __m256i mask, int pos)
+{
+    int word = pos >> 5, shift = pos & 31;
+    __m256i v = _mm256_srl_epi32(_mm256_loadu_si256((const __m256i *)(w + word * BITPACK_LANES)),
+                                 _mm_cvtsi32_si128(shift));
+    if (shift + bits > 32) {
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(w + (word + 1) * BITPACK_LANES));
+        v = _mm256_or_si256(v, _mm256_sll_epi32(hi, _mm_cvtsi32_si128(32 - shift)));
+    }
+    return _mm256_and_si256(v, mask);
+}
+
+static inline __m256i code_mask(int bits)
+{
+    return _mm256_set1_epi32(bits < 32 ? (int)((1u << bits) - 1) : -1);
+}
+
+long bitpack_find_avx2(const uint32_t *w, int bits, uint32_t code)
+{
+    if (bits == 0)
+        return 0;
+    __m256i mask = code_mask(bits), vcode = _mm256_set1_epi32((int)code);
+    for (int t = 0, pos = 0; t < MINMAX_BITPACK_BLOCK / BITPACK_LANES; t++, pos += bits) {
+        __m256i eq = _mm256_cmpeq_epi32(decode_group(w, bits, mask, pos), vcode);
+        int m = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (m)
+            return (long)t * BITPACK_LANES + __builtin_ctz((unsigned)m);
+    }
+    return 0;
+}
+
+void bitpack_decode_avx2(const uint32_t *w, int bits, int base, int *out)
+{
+    __m256i vbase = _mm256_set1_epi32(base);
+    if (bits == 0) {
+        for (int x = 0; x < MINMAX_BITPACK_BLOCK; x += BITPACK_LANES)
+            _mm256_storeu_si256((__m256i *)(out + x), vbase);
+        return;
+    }
+    __m256i mask = code_mask(bits);
+    for (int t = 0, pos = 0; t < MINMAX_BITPACK_BLOCK / BITPACK_LANES; t++, pos += bits)
+        _mm256_storeu_si256((__m256i *)(out + t * BITPACK_LANES),
+                            _mm256_add_epi32(decode_group(w, bits, mask, pos), vbase));
+}
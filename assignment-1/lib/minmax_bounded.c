@@ -0,0 +1,77 @@
+/*
+ * Early termination when the value range [lo, hi] is known in advance.
+ *
+ * The volume is cut into BOUNDED_BLOCK-element blocks, handed out in
+ * increasing order by a monotonic dynamic schedule, so at any time the
+ * team works on a narrow window of consecutive blocks. Two shared words
+ * hold the first block found to contain lo (min_stop) and hi (max_stop);
+ * a thread that finds one lowers it with a CAS fetch-min.
+ *
+ * Every block is checked against both words before it is read: a block
+ * past min_stop cannot hold the first minimum (value lo comes earlier,
+ * and nothing is below lo), and likewise for the max. A block past both
+ * is skipped at the cost of one loop iteration. Blocks before min_stop are
+ * always scanned whatever the timing, so the first occurrence of lo still
+ * wins. Because blocks are claimed in order, little more than one block
+ * per thread is read beyond the settling block.
+ *
+ * `#pragma omp cancel for` would stop the loop outright, but only when
+ * OMP_CANCELLATION=true is set in the environment on start-up; the flag
+ * checked per block works without it, and the skipped iterations cost
+ * next to nothing.
+ */
+#include "minmax_impl.h"
+
+/* Elements per block: 64 KB, the granularity at which the scan can stop */
+#define BOUNDED_BLOCK 16384L
+
+static inline void stop_at(_Atomic long *stop, long b)
+{
+    long cur = atomic_load_explicit(stop, memory_order_relaxed);
+    while (b < cur &&
+           !atomic_compare_exchange_weak_explicit(stop, &cur, b, memory_order_relaxed,
+                                                  memory_order_relaxed))
+        ;
+}
+
+int minmax_loc_3d_bounded(const int *a, int M, int N, int P, int lo, int hi,
+                          MinMaxLoc *min, MinMaxLoc *max, long *scanned)
+{
+    if (!a || !min || !max || M <= 0 || N <= 0 || P <= 0 || lo > hi)
+        return -1;
+
+    long total = (long)M * N * P;
+    long nblocks = (total + BOUNDED_BLOCK - 1) / BOUNDED_BLOCK;
+    const ScanKernels *sk = scan_kernels();
+
+    _Atomic long min_stop = LONG_MAX, max_stop = LONG_MAX;
+    ValIdx gmin = { INT_MAX, LONG_MAX }, gmax = { INT_MIN, LONG_MAX };
+    long read = 0;
+
+    #pragma omp parallel for schedule(monotonic : dynamic) \
+            reduction(valmin : gmin) reduction(valmax : gmax) reduction(+ : read)
+    for (long b = 0; b < nblocks; b++) {
+        if (b > atomic_load_explicit(&min_stop, memory_order_relaxed) &&
+            b > atomic_load_explicit(&max_stop, memory_order_relaxed))
+            continue;
+
+        long lo_i = b * BOUNDED_BLOCK;
+        long hi_i = total - lo_i > BOUNDED_BLOCK ? lo_i + BOUNDED_BLOCK : total;
+        ValIdx bmin = { INT_MAX, LONG_MAX }, bmax = { INT_MIN, LONG_MAX };
+        sk->minmax(a, lo_i, hi_i, &bmin, &bmax);
+        read += hi_i - lo_i;
+
+        valmin_combine(&gmin, &bmin);
+        valmax_combine(&gmax, &bmax);
+        if (bmin.val == lo)
+            stop_at(&min_stop, b);
+        if (bmax.val == hi)
+            stop_at(&max_stop, b);
+    }
+
+    *min = loc_from_validx(&gmin, 0, N, P);
+    *max = loc_from_validx(&gmax, 0, N, P);
+    if (scanned)
+        *scanned = read;
+    return 0;
+}
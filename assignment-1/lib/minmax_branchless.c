@@ -0,0 +1,76 @@
+/*
+ * novel_branchless.c — XOR/mask conditional select instead of branches,
+ * nowait loop followed by a critical-section merge (or one packed CAS per
+ * thread with MINMAX_MERGE_LOCKFREE).
+ */
+#include "minmax_impl.h"
+
+/* Branchless conditional select: returns a if cond != 0, else b.
+ * Pure arithmetic — no branch instructions generated. */
+static inline int select_int(int cond, int a, int b)
+{
+    int mask = -cond;  /* 0 -> 0x00000000, 1 -> 0xFFFFFFFF */
+    return (a & mask) | (b & ~mask);
+}
+
+static inline long select_long(int cond, long a, long b)
+{
+    long mask = -(long)cond;
+    return (a & mask) | (b & ~mask);
+}
+
+void minmax_branchless(const int *a, int M, int N, int P,
+                       MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    long total = (long)M * N * P;
+
+    int gmin_val = INT_MAX, gmax_val = INT_MIN;
+    long gmin_idx = 0, gmax_idx = 0;
+    _Atomic uint64_t kmin = PACKED_EMPTY, kmax = PACKED_EMPTY;
+    int lockfree = minmax_merge_lockfree(total);
+
+    #pragma omp parallel
+    {
+        int lmin_val = INT_MAX, lmax_val = INT_MIN;
+        long lmin_idx = 0, lmax_idx = 0;
+
+        #pragma omp for schedule(static) nowait
+        for (long i = 0; i < total; i++) {
+            int val = a[i];
+
+            /* Branchless min update */
+            int is_less = (val < lmin_val);
+            lmin_val = select_int(is_less, val, lmin_val);
+            lmin_idx = select_long(is_less, i, lmin_idx);
+
+            /* Branchless max update */
+            int is_greater = (val > lmax_val);
+            lmax_val = select_int(is_greater, val, lmax_val);
+            lmax_idx = select_long(is_greater, i, lmax_idx);
+        }
+
+        if (lockfree) {
+            packed_merge(&kmin, packed_min_key(lmin_val, lmin_idx));
+            packed_merge(&kmax, packed_max_key(lmax_val, lmax_idx));
+        } else {
+            /* Equal values keep the lower index, whatever the merge order */
+            #pragma omp critical
+            {
+                if (lmin_val < gmin_val || (lmin_val == gmin_val && lmin_idx < gmin_idx)) {
+                    gmin_val = lmin_val; gmin_idx = lmin_idx;
+                }
+                if (lmax_val > gmax_val || (lmax_val == gmax_val && lmax_idx < gmax_idx)) {
+                    gmax_val = lmax_val; gmax_idx = lmax_idx;
+                }
+            }
+        }
+    }
+    if (lockfree) {
+        ValIdx m = packed_min_unpack(kmin), x = packed_max_unpack(kmax);
+        gmin_val = m.val; gmin_idx = m.idx;
+        gmax_val = x.val; gmax_idx = x.idx;
+    }
+
+    *vmin = loc_from_flat(gmin_val, gmin_idx, N, P);
+    *vmax = loc_from_flat(gmax_val, gmax_idx, N, P);
+}
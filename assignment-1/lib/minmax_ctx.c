@@ -0,0 +1,233 @@
+/*
+ * Reusable query context: a persistent worker pool for many small scans.
+ *
+ * At a few MB per query the scan itself takes tens of microseconds, and
+ * opening an OpenMP parallel region (wake the team, reduction setup, join
+ * barrier) is a large share of that. A context pays the setup once: it
+ * fixes the shape, cuts the flat range into one contiguous, cache-line
+ * aligned part per worker, allocates a padded result slot per worker and
+ * starts threads - 1 pthreads that stay alive until minmax_ctx_free().
+ *
+ * A query publishes the array and bumps a generation counter; workers
+ * that are spinning on it see the change within a few hundred cycles,
+ * scan their part with the dispatched SIMD kernel, store both winners in
+ * their slot and bump a done counter. The caller scans part 0 meanwhile,
+ * waits for the count and folds the slots in part order, so the first
+ * occurrence wins on ties as everywhere else.
+ *
+ * Workers spin for CTX_SPIN_POLLS polls (~100 us) after each query and
+ * then sleep on a condition variable, so an idle context does not burn
+ * CPUs; the first query after a pause pays one wake-up. Volumes below
+ * CTX_PARALLEL_MIN elements use no workers, and larger ones only as many
+ * as give each CTX_MIN_PER_WORKER elements.
+ */
+#include "minmax_impl.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define CTX_PARALLEL_MIN   (1L << 16)   /* below this the caller scans alone   */
+#define CTX_MIN_PER_WORKER (1L << 16)   /* 256 KB: less does not pay the sync  */
+#define CTX_SPIN_POLLS     (1 << 15)
+#define CTX_YIELD_EVERY    64           /* let an oversubscribed CPU run others */
+
+typedef struct {
+    ValIdx min, max;
+} __attribute__((aligned(64))) CtxSlot;
+
+struct minmax_ctx {
+    int   M, N, P;
+    long  n;
+    int   nparts;           /* caller + workers                             */
+    long *bounds;           /* part p is [bounds[p], bounds[p+1])           */
+    const ScanKernels *sk;
+    CtxSlot   *slot;
+    pthread_t *workers;
+    int        nworkers;    /* started; may be < nparts - 1 if create failed */
+
+    const int *a;           /* array of the running query                   */
+    int        stop;
+
+    _Atomic unsigned gen   __attribute__((aligned(64)));
+    _Atomic int      done  __attribute__((aligned(64)));
+    _Atomic int      sleepers;
+    pthread_mutex_t  mu;
+    pthread_cond_t   cv;
+};
+
+typedef struct {
+    minmax_ctx *c;
+    int         part;
+} CtxWorkerArg;
+
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void scan_part(minmax_ctx *c, int p)
+{
+    long lo = c->bounds[p], hi = c->bounds[p + 1];
+    CtxSlot s = { { INT_MAX, lo }, { INT_MIN, lo } };
+    if (lo < hi)
+        c->sk->minmax(c->a, lo, hi, &s.min, &s.max);
+    c->slot[p] = s;
+}
+
+/* Wait for the generation to move past seen: spin, then sleep */
+static unsigned wait_generation(minmax_ctx *c, unsigned seen)
+{
+    unsigned g;
+    for (int spins = 0; spins < CTX_SPIN_POLLS; spins++) {
+        if ((g = atomic_load_explicit(&c->gen, memory_order_acquire)) != seen)
+            return g;
+        cpu_relax();
+        if (spins % CTX_YIELD_EVERY == CTX_YIELD_EVERY - 1)
+            sched_yield();
+    }
+
+    /* sleepers is raised before gen is re-read, and the caller bumps gen
+     * before reading sleepers: one of the two sees the other's write */
+    pthread_mutex_lock(&c->mu);
+    atomic_fetch_add(&c->sleepers, 1);
+    while ((g = atomic_load(&c->gen)) == seen)
+        pthread_cond_wait(&c->cv, &c->mu);
+    atomic_fetch_sub(&c->sleepers, 1);
+    pthread_mutex_unlock(&c->mu);
+    return g;
+}
+
+static void *ctx_worker(void *arg)
+{
+    minmax_ctx *c = ((CtxWorkerArg *)arg)->c;
+    int part = ((CtxWorkerArg *)arg)->part;
+    free(arg);
+
+    unsigned seen = 0;
+    for (;;) {
+        seen = wait_generation(c, seen);
+        if (c->stop)
+            return NULL;
+        scan_part(c, part);
+        atomic_fetch_add_explicit(&c->done, 1, memory_order_release);
+    }
+}
+
+/* Publish a new generation (query or stop) and wake sleeping workers */
+static void ctx_signal(minmax_ctx *c)
+{
+    atomic_fetch_add(&c->gen, 1);
+    if (atomic_load(&c->sleepers) > 0) {
+        pthread_mutex_lock(&c->mu);
+        pthread_cond_broadcast(&c->cv);
+        pthread_mutex_unlock(&c->mu);
+    }
+}
+
+minmax_ctx *minmax_ctx_create(int M, int N, int P, int threads)
+{
+    if (M <= 0 || N <= 0 || P <= 0)
+        return NULL;
+    if (threads <= 0)
+        threads = omp_get_max_threads();
+
+    minmax_ctx *c = calloc(1, sizeof(*c));
+    if (!c)
+        return NULL;
+    c->M = M; c->N = N; c->P = P;
+    c->n = (long)M * N * P;
+    c->sk = scan_kernels();
+    pthread_mutex_init(&c->mu, NULL);
+    pthread_cond_init(&c->cv, NULL);
+
+    long parts = c->n < CTX_PARALLEL_MIN ? 1 : c->n / CTX_MIN_PER_WORKER;
+    if (parts > threads) parts = threads;
+    if (parts < 1)       parts = 1;
+    c->nparts = (int)parts;
+
+    c->bounds  = malloc((size_t)(parts + 1) * sizeof(long));
+    c->slot    = aligned_alloc(64, (size_t)parts * sizeof(CtxSlot));
+    c->workers = malloc((size_t)parts * sizeof(pthread_t));
+    if (!c->bounds || !c->slot || !c->workers) {
+        minmax_ctx_free(c);
+        return NULL;
+    }
+
+    /* Contiguous parts, inner boundaries on 16-element (64-byte) lines */
+    for (int p = 0; p <= c->nparts; p++)
+        c->bounds[p] = p == c->nparts ? c->n : (c->n / parts * p + c->n % parts * p / parts) & ~15L;
+
+    for (int p = 1; p < c->nparts; p++) {
+        CtxWorkerArg *arg = malloc(sizeof(*arg));
+        if (!arg)
+            break;
+        *arg = (CtxWorkerArg){ c, p };
+        if (pthread_create(&c->workers[c->nworkers], NULL, ctx_worker, arg) != 0) {
+            free(arg);
+            break;
+        }
+        c->nworkers++;
+    }
+    if (c->nworkers != c->nparts - 1) {
+        minmax_ctx_free(c);
+        return NULL;
+    }
+    return c;
+}
+
+void minmax_ctx_free(minmax_ctx *c)
+{
+    if (!c)
+        return;
+    if (c->nworkers > 0) {
+        c->stop = 1;
+        ctx_signal(c);
+        for (int w = 0; w < c->nworkers; w++)
+            pthread_join(c->workers[w], NULL);
+    }
+    pthread_mutex_destroy(&c->mu);
+    pthread_cond_destroy(&c->cv);
+    free(c->bounds);
+    free(c->slot);
+    free(c->workers);
+    free(c);
+}
+
+int minmax_ctx_threads(const minmax_ctx *c)
+{
+    return c ? c->nparts : 0;
+}
+
+int minmax_ctx_query(minmax_ctx *c, const int *a, MinMaxLoc *min, MinMaxLoc *max)
+{
+    if (!c || !a || !min || !max)
+        return -1;
+
+    c->a = a;
+    if (c->nparts > 1) {
+        atomic_store_explicit(&c->done, 0, memory_order_relaxed);
+        ctx_signal(c);
+    }
+    scan_part(c, 0);
+
+    int spins = 0;
+    while (atomic_load_explicit(&c->done, memory_order_acquire) < c->nparts - 1) {
+        cpu_relax();
+        if (++spins % CTX_YIELD_EVERY == 0)
+            sched_yield();
+    }
+
+    ValIdx vmin = c->slot[0].min, vmax = c->slot[0].max;
+    for (int p = 1; p < c->nparts; p++) {
+        valmin_combine(&vmin, &c->slot[p].min);
+        valmax_combine(&vmax, &c->slot[p].max);
+    }
+    *min = loc_from_flat(vmin.val, vmin.idx, c->N, c->P);
+    *max = loc_from_flat(vmax.val, vmax.idx, c->N, c->P);
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * Hand-written CUDA argmin/argmax for minmax_dev_*() (MINMAX_DEV_CUDA),
+ * built only with `make CUDA=1`.
+ *
+ * One pass with a grid-stride loop: each thread reads int4 vectors (16 B
+ * per load, the volume is cudaMalloc'd so it is 256-byte aligned) and keeps
+ * its own (value, index) best for min and max. A warp then folds its 32
+ * pairs with __shfl_down_sync in five steps, lane 0 of each warp parks the
+ * result in shared memory and the first warp folds those, so a block writes
+ * one min and one max pair. The grid is sized to a few blocks per SM, not
+ * to the data, so the per-block partials stay a few KB; the host folds them
+ * after the copy back. Every fold keeps the lower index among equal values,
+ * so results match minmax_loc_3d().
+ */
+#include <cuda_runtime.h>
+#include <climits>
+#include <cstdlib>
+
+#define CUDA_BLOCK          256
+#define CUDA_BLOCKS_PER_SM  8
+#define FULL_MASK           0xffffffffu
+
+/* Same layout as ValIdx in scan.h ({ int val; long idx; } on LP64) */
+struct Best {
+    int  val;
+    long idx;
+};
+
+struct CudaVolume {
+    int  *data;
+    Best *part;             /* 2 per block: min, max          */
+    Best *host_part;
+    int   grid;
+};
+
+__device__ __forceinline__ void take_min(Best &b, int v, long i)
+{
+    if (v < b.val || (v == b.val && i < b.idx)) { b.val = v; b.idx = i; }
+}
+
+__device__ __forceinline__ void take_max(Best &b, int v, long i)
+{
+    if (v > b.val || (v == b.val && i < b.idx)) { b.val = v; b.idx = i; }
+}
+
+/* Fold the warp's pairs into lane 0 */
+__device__ __forceinline__ void warp_fold(Best &mn, Best &mx)
+{
+    for (int off = 16; off > 0; off >>= 1) {
+        int  v  = __shfl_down_sync(FULL_MASK, mn.val, off);
+        long i  = __shfl_down_sync(FULL_MASK, mn.idx, off);
+        take_min(mn, v, i);
+        v = __shfl_down_sync(FULL_MASK, mx.val, off);
+        i = __shfl_down_sync(FULL_MASK, mx.idx, off);
+        take_max(mx, v, i);
+    }
+}
+
+__global__ void __launch_bounds__(CUDA_BLOCK)
+minmax_kernel(const int *__restrict__ a, long n, Best *__restrict__ part)
+{
+    Best mn = { INT_MAX, LONG_MAX }, mx = { INT_MIN, LONG_MAX };
+    long stride = (long)gridDim.x * blockDim.x;
+    long tid    = (long)blockIdx.x * blockDim.x + threadIdx.x;
+
+    /* A thread's indices ascend, so strict compares keep the first */
+    const int4 *a4 = reinterpret_cast<const int4 *>(a);
+    for (long q = tid; q < n / 4; q += stride) {
+        int4 v = __ldg(&a4[q]);
+        long i = q * 4;
+        if (v.x < mn.val) { mn.val = v.x; mn.idx = i; }
+        if (v.x > mx.val) { mx.val = v.x; mx.idx = i; }
+        if (v.y < mn.val) { mn.val = v.y; mn.idx = i + 1; }
+        if (v.y > mx.val) { mx.val = v.y; mx.idx = i + 1; }
+        if (v.z < mn.val) { mn.val = v.z; mn.idx = i + 2; }
+        if (v.z > mx.val) { mx.val = v.z; mx.idx = i + 2; }
+        if (v.w < mn.val) { mn.val = v.w; mn.idx = i + 3; }
+        if (v.w > mx.val) { mx.val = v.w; mx.idx = i + 3; }
+    }
+    for (long x = n / 4 * 4 + tid; x < n; x += stride) {
+        take_min(mn, a[x], x);
+        take_max(mx, a[x], x);
+    }
+
+    __shared__ Best smin[CUDA_BLOCK / 32], smax[CUDA_BLOCK / 32];
+    int lane = threadIdx.x & 31, warp = threadIdx.x >> 5;
+    warp_fold(mn, mx);
+    if (lane == 0) {
+        smin[warp] = mn;
+        smax[warp] = mx;
+    }
+    __syncthreads();
+
+    if (warp == 0) {
+        Best none_min = { INT_MAX, LONG_MAX }, none_max = { INT_MIN, LONG_MAX };
+        mn = lane < CUDA_BLOCK / 32 ? smin[lane] : none_min;
+        mx = lane < CUDA_BLOCK / 32 ? smax[lane] : none_max;
+        warp_fold(mn, mx);
+        if (lane == 0) {
+            part[2 * blockIdx.x]     = mn;
+            part[2 * blockIdx.x + 1] = mx;
+        }
+    }
+}
+
+extern "C" int minmax_cuda_count(void)
+{
+    int n = 0;
+    return cudaGetDeviceCount(&n) == cudaSuccess ? n : 0;
+}
+
+extern "C" void minmax_cuda_free(void *h)
+{
+    CudaVolume *v = static_cast<CudaVolume *>(h);
+    if (!v)
+        return;
+    cudaFree(v->data);
+    cudaFree(v->part);
+    free(v->host_part);
+    free(v);
+}
+
+extern "C" void *minmax_cuda_upload(const int *a, long n)
+{
+    CudaVolume *v = static_cast<CudaVolume *>(calloc(1, sizeof(CudaVolume)));
+    if (!v)
+        return NULL;
+
+    int dev = 0, sms = 1;
+    cudaGetDevice(&dev);
+    cudaDeviceGetAttribute(&sms, cudaDevAttrMultiProcessorCount, dev);
+    long want = (n / 4 + CUDA_BLOCK - 1) / CUDA_BLOCK;
+    long cap  = (long)sms * CUDA_BLOCKS_PER_SM;
+    v->grid = (int)(want < 1 ? 1 : want < cap ? want : cap);
+
+    size_t part_bytes = (size_t)v->grid * 2 * sizeof(Best);
+    v->host_part = static_cast<Best *>(malloc(part_bytes));
+    if (!v->host_part ||
+        cudaMalloc(&v->data, (size_t)n * sizeof(int)) != cudaSuccess ||
+        cudaMalloc(&v->part, part_bytes) != cudaSuccess ||
+        cudaMemcpy(v->data, a, (size_t)n * sizeof(int), cudaMemcpyHostToDevice) != cudaSuccess) {
+        minmax_cuda_free(v);
+        return NULL;
+    }
+    return v;
+}
+
+extern "C" int minmax_cuda_query(void *h, long n, Best *vmin, Best *vmax)
+{
+    CudaVolume *v = static_cast<CudaVolume *>(h);
+    minmax_kernel<<<v->grid, CUDA_BLOCK>>>(v->data, n, v->part);
+    if (cudaMemcpy(v->host_part, v->part, (size_t)v->grid * 2 * sizeof(Best),
+                   cudaMemcpyDeviceToHost) != cudaSuccess)
+        return -1;
+
+    /* Blocks cover interleaved indices, so fold with the tie rule */
+    Best mn = v->host_part[0], mx = v->host_part[1];
+    for (int b = 1; b < v->grid; b++) {
+        const Best &pmn = v->host_part[2 * b], &pmx = v->host_part[2 * b + 1];
+        if (pmn.val < mn.val || (pmn.val == mn.val && pmn.idx < mn.idx)) mn = pmn;
+        if (pmx.val > mx.val || (pmx.val == mx.val && pmx.idx < mx.idx)) mx = pmx;
+    }
+    /* idx stays LONG_MAX on a volume of INT_MAX / INT_MIN only; the
+     * caller's loc_from_validx() maps it to index 0 */
+    *vmin = mn;
+    *vmax = mx;
+    return 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * novel_fixed — dispatch to a compile-time specialised kernel when the
+ * volume's (N, P) is one of MINMAX_FIXED_SHAPES, and to the ultimate
+ * strategy otherwise.
+ *
+ * The specialisations are AVX2 code (minmax_fixed_avx2.c); they are used
+ * when the dispatched ISA is avx2 or avx512, so MINMAX_ISA=sse4.1 or a
+ * host without AVX2 takes the generic path for every shape.
+ */
+#include "minmax_impl.h"
+#include <stddef.h>
+
+static const FixedKernel *fixed_lookup(int N, int P)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    const ScanKernels *sk = scan_kernels();
+    if (sk != &scan_kernels_avx2 && sk != &scan_kernels_avx512)
+        return NULL;
+    for (const FixedKernel *f = minmax_fixed_avx2; f->fn; f++)
+        if (f->N == N && f->P == P)
+            return f;
+#else
+    (void)N;
+    (void)P;
+#endif
+    return NULL;
+}
+
+int minmax_fixed_specialized(int N, int P)
+{
+    return fixed_lookup(N, P) != NULL;
+}
+
+void minmax_fixed(const int *a, int M, int N, int P,
+                  MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    const FixedKernel *f = fixed_lookup(N, P);
+    if (f)
+        f->fn(a, M, vmin, vmax);
+    else
+        minmax_ultimate(a, M, N, P, vmin, vmax);
+}
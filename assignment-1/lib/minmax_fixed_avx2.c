@@ -0,0 +1,123 @@
+/*
+ * AVX2 kernels specialised at compile time for the MINMAX_FIXED_SHAPES
+ * of minmax_impl.h.
+ *
+ * fixed_scan() is always inlined into one function per (N, P, rows)
+ * entry, so the row length, the block size and every index computation
+ * are constants: the P / 8 loads of a row unroll completely, with no
+ * `k < simd_end` test and no scalar tail, and block offsets and the final
+ * flat -> (i, j, k) conversion become multiplies and shifts.
+ *
+ * Each block of ROWS rows (16 KB, L1-resident) is first folded by value
+ * only, vpminsd / vpmaxsd into two accumulator pairs, without tracking
+ * positions, with one prefetch per cache line 4 KB ahead. A block that
+ * strictly beats the thread's best is searched again with cmpeq +
+ * movemask for the first lane that holds the new value. On most inputs
+ * that happens in a handful of blocks per thread. Blocks are taken in
+ * order within a thread and the valmin/valmax reductions keep the lower
+ * index across threads, so ties resolve to the first occurrence as
+ * everywhere else.
+ *
+ * Compile with: -mavx2
+ */
+#include "minmax_impl.h"
+#include <immintrin.h>
+
+/* Software prefetch distance in elements (4 KB, as MINMAX_STREAM's default) */
+#define FIXED_PREFETCH 1024
+
+static inline int hmin_epi32(__m256i v)
+{
+    __m128i m = _mm_min_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(m);
+}
+
+static inline int hmax_epi32(__m256i v)
+{
+    __m128i m = _mm_max_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    m = _mm_max_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(m);
+}
+
+/* Offset of the first p[x] == val in a block of E elements known to hold it */
+static inline long fixed_find(const int *p, const long E, int val)
+{
+    __m256i vval = _mm256_set1_epi32(val);
+    for (long x = 0; x < E; x += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(p + x)), vval);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask)
+            return x + __builtin_ctz((unsigned)mask);
+    }
+    return 0;
+}
+
+static inline __attribute__((always_inline))
+void fixed_scan(const int *a, int M, const long N, const long P, const long ROWS,
+                MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    const long E = ROWS * P;
+    long nblocks = (long)M * (N / ROWS);
+
+    ValIdx gmin = { INT_MAX, LONG_MAX }, gmax = { INT_MIN, LONG_MAX };
+
+    #pragma omp parallel for schedule(static) reduction(valmin : gmin) reduction(valmax : gmax)
+    for (long b = 0; b < nblocks; b++) {
+        const int *p = a + b * E;
+        __m256i mn0 = _mm256_set1_epi32(INT_MAX), mn1 = mn0;
+        __m256i mx0 = _mm256_set1_epi32(INT_MIN), mx1 = mx0;
+
+        for (long r = 0; r < ROWS; r++) {
+            const int *row = p + r * P;
+            /* Constant trip count: unrolled into P / 8 loads, the parity
+             * test picks the accumulator pair at compile time */
+            #pragma GCC unroll 128
+            for (long v = 0; v < P / 8; v++) {
+                if (v % 2 == 0)
+                    __builtin_prefetch(row + 8 * v + FIXED_PREFETCH, 0, 3);
+                __m256i d = _mm256_loadu_si256((const __m256i *)(row + 8 * v));
+                if (v & 1) {
+                    mn1 = _mm256_min_epi32(mn1, d);
+                    mx1 = _mm256_max_epi32(mx1, d);
+                } else {
+                    mn0 = _mm256_min_epi32(mn0, d);
+                    mx0 = _mm256_max_epi32(mx0, d);
+                }
+            }
+        }
+
+        int bmin = hmin_epi32(_mm256_min_epi32(mn0, mn1));
+        int bmax = hmax_epi32(_mm256_max_epi32(mx0, mx1));
+        if (bmin < gmin.val) {
+            gmin.val = bmin;
+            gmin.idx = b * E + fixed_find(p, E, bmin);
+        }
+        if (bmax > gmax.val) {
+            gmax.val = bmax;
+            gmax.idx = b * E + fixed_find(p, E, bmax);
+        }
+    }
+
+    *vmin = loc_from_validx(&gmin, 0, (int)N, (int)P);
+    *vmax = loc_from_validx(&gmax, 0, (int)N, (int)P);
+}
+
+#define FIXED_KERNEL(N_, P_, ROWS_)                                                  \
+    _Static_assert((P_) % 8 == 0 && (P_) <= 1024 && (N_) % (ROWS_) == 0,            \
+                   "MINMAX_FIXED_SHAPES entry " #N_ "x" #P_ " cannot be specialised"); \
+    static void fixed_##N_##x##P_(const int *a, int M, MinMaxLoc *vmin, MinMaxLoc *vmax) \
+    {                                                                                \
+        fixed_scan(a, M, N_, P_, ROWS_, vmin, vmax);                                 \
+    }
+MINMAX_FIXED_SHAPES(FIXED_KERNEL)
+#undef FIXED_KERNEL
+
+#define FIXED_ENTRY(N_, P_, ROWS_) { N_, P_, fixed_##N_##x##P_ },
+const FixedKernel minmax_fixed_avx2[] = {
+    MINMAX_FIXED_SHAPES(FIXED_ENTRY)
+    { 0, 0, NULL }
+};
+#undef FIXED_ENTRY
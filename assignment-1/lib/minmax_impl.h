@@ -0,0 +1,263 @@
+#ifndef MINMAX_IMPL_H
+#define MINMAX_IMPL_H
+
+/*
+ * Internal helpers shared by the libminmax strategy files. Not installed.
+ */
+#include "minmax.h"
+#include "scan.h"
+#include <limits.h>
+#include <omp.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+/* Lexicographic (i, j, k) order, i.e. flat index order */
+static inline int loc_before(const MinMaxLoc *a, const MinMaxLoc *b) {
+    if (a->i != b->i) return a->i < b->i;
+    if (a->j != b->j) return a->j < b->j;
+    return a->k < b->k;
+}
+
+/* Combiners (used by declare reduction; may appear unused in some translation units).
+ * Equal values keep the earlier position, so the merged result is the first
+ * occurrence no matter in which order OpenMP combines the partial results. */
+__attribute__((unused))
+static void minloc_combine(MinMaxLoc *out, MinMaxLoc *in) {
+    if (in->val < out->val || (in->val == out->val && loc_before(in, out))) *out = *in;
+}
+__attribute__((unused))
+static void maxloc_combine(MinMaxLoc *out, MinMaxLoc *in) {
+    if (in->val > out->val || (in->val == out->val && loc_before(in, out))) *out = *in;
+}
+
+/* Custom reductions */
+#pragma omp declare reduction(minloc : MinMaxLoc : \
+        minloc_combine(&omp_out, &omp_in)) \
+        initializer(omp_priv = (MinMaxLoc){ .val = INT_MAX, .i = 0, .j = 0, .k = 0 })
+
+#pragma omp declare reduction(maxloc : MinMaxLoc : \
+        maxloc_combine(&omp_out, &omp_in)) \
+        initializer(omp_priv = (MinMaxLoc){ .val = INT_MIN, .i = 0, .j = 0, .k = 0 })
+
+/* Same, but every private copy starts from the caller's seed (an element of
+ * the range being scanned) instead of the identity at (0, 0, 0), which
+ * would win ties against the range's own elements. For sub-volumes. */
+#pragma omp declare reduction(minloc_seeded : MinMaxLoc : \
+        minloc_combine(&omp_out, &omp_in)) initializer(omp_priv = omp_orig)
+
+#pragma omp declare reduction(maxloc_seeded : MinMaxLoc : \
+        maxloc_combine(&omp_out, &omp_in)) initializer(omp_priv = omp_orig)
+
+/* Flat-index counterparts of minloc/maxloc over ValIdx; ties keep the lower
+ * index. Used where kernels work on flat ranges (chunks, slabs, leaves). */
+__attribute__((unused))
+static void valmin_combine(ValIdx *out, const ValIdx *in) {
+    if (in->val < out->val || (in->val == out->val && in->idx < out->idx)) *out = *in;
+}
+__attribute__((unused))
+static void valmax_combine(ValIdx *out, const ValIdx *in) {
+    if (in->val > out->val || (in->val == out->val && in->idx < out->idx)) *out = *in;
+}
+
+#pragma omp declare reduction(valmin : ValIdx : \
+        valmin_combine(&omp_out, &omp_in)) \
+        initializer(omp_priv = (ValIdx){ INT_MAX, LONG_MAX })
+
+#pragma omp declare reduction(valmax : ValIdx : \
+        valmax_combine(&omp_out, &omp_in)) \
+        initializer(omp_priv = (ValIdx){ INT_MIN, LONG_MAX })
+
+/*
+ * Lock-free merge of per-thread winners (MINMAX_MERGE_LOCKFREE).
+ *
+ * A (value, flat index) pair is packed into one 64-bit key whose unsigned
+ * order is the merge order: the value in the high half, biased so that
+ * smaller (min) or larger (max) values give smaller keys, and the index in
+ * the low half, so equal values fall back to the lower index. Merging is
+ * then an atomic fetch-min, done as a CAS loop that returns at once when
+ * the key cannot win (most threads after the first few). The low half
+ * limits indices to 32 bits: larger volumes take the critical path.
+ * Relaxed ordering is enough, the region's closing barrier publishes the
+ * final key.
+ */
+#define PACKED_MAX_ELEMS (1L << 32)
+#define PACKED_EMPTY     UINT64_MAX
+
+static inline uint64_t packed_min_key(int val, long idx)
+{
+    return (uint64_t)((uint32_t)val ^ 0x80000000u) << 32 | (uint32_t)idx;
+}
+static inline uint64_t packed_max_key(int val, long idx)
+{
+    return (uint64_t)((uint32_t)val ^ 0x7fffffffu) << 32 | (uint32_t)idx;
+}
+static inline ValIdx packed_min_unpack(uint64_t key)
+{
+    return (ValIdx){ (int)((uint32_t)(key >> 32) ^ 0x80000000u), (long)(uint32_t)key };
+}
+static inline ValIdx packed_max_unpack(uint64_t key)
+{
+    return (ValIdx){ (int)((uint32_t)(key >> 32) ^ 0x7fffffffu), (long)(uint32_t)key };
+}
+static inline void packed_merge(_Atomic uint64_t *best, uint64_t key)
+{
+    uint64_t cur = atomic_load_explicit(best, memory_order_relaxed);
+    while (key < cur &&
+           !atomic_compare_exchange_weak_explicit(best, &cur, key, memory_order_relaxed,
+                                                  memory_order_relaxed))
+        ;
+}
+
+/* Whether a merge over n elements runs lock-free (mode set and n fits) */
+int minmax_merge_lockfree(long n);
+
+/* Convert a flat index into a MinMaxLoc */
+static inline MinMaxLoc loc_from_flat(int val, long idx, int N, int P)
+{
+    MinMaxLoc r;
+    r.val = val;
+    r.i = (int)(idx / ((long)N * P));
+    r.j = (int)((idx % ((long)N * P)) / P);
+    r.k = (int)(idx % P);
+    return r;
+}
+
+/*
+ * Index held by a valmin/valmax result or a scan-kernel fold. Strict
+ * compares never move off the identity { INT_MAX / INT_MIN, LONG_MAX }
+ * when every element equals it; the first occurrence is then index 0.
+ */
+static inline long validx_index(const ValIdx *v)
+{
+    return v->idx == LONG_MAX ? 0 : v->idx;
+}
+
+/* loc_from_flat() of such a result, whose index is relative to base */
+static inline MinMaxLoc loc_from_validx(const ValIdx *v, long base, int N, int P)
+{
+    return loc_from_flat(v->val, base + validx_index(v), N, P);
+}
+
+/*
+ * SIMD scan of one contiguous run a[base..base+len) for both min and max.
+ * A run is normally one row (len = P), but when a tile covers whole rows or
+ * whole i-planes it is the entire contiguous stretch, so shapes with tiny P
+ * do not pay one kernel call per handful of elements.
+ *
+ * The vector work is done by the runtime-dispatched kernel (AVX-512, AVX2,
+ * SSE4.1, NEON or scalar — see scan.h); here we only translate its flat
+ * winner back into (i, j, k). Callers (tiled strategies, zone-map edges)
+ * do not visit runs in flat index order, so the run result is merged with
+ * the position-aware combiners to keep the first occurrence on ties.
+ */
+static inline void simd_scan_run(const ScanKernels *sk, const int *a, long base, long len,
+                                 MinMaxLoc *vmin, MinMaxLoc *vmax, int N, int P)
+{
+    ValIdx rmin = { INT_MAX, -1 };
+    ValIdx rmax = { INT_MIN, -1 };
+
+    sk->minmax(a, base, base + len, &rmin, &rmax);
+
+    /* Only a run that can win pays for the index -> (i, j, k) divisions;
+     * with short rows (thin ROIs) that conversion would cost more than the
+     * scan itself */
+    if (rmin.idx >= 0 && rmin.val <= vmin->val) {
+        MinMaxLoc r = loc_from_flat(rmin.val, rmin.idx, N, P);
+        minloc_combine(vmin, &r);
+    }
+    if (rmax.idx >= 0 && rmax.val >= vmax->val) {
+        MinMaxLoc r = loc_from_flat(rmax.val, rmax.idx, N, P);
+        maxloc_combine(vmax, &r);
+    }
+}
+
+/* Tuning entry for this shape and the caller's thread count, looked up
+ * without copying; defined in minmax_tune.c */
+const minmax_tuning *minmax_tuning_active(int M, int N, int P);
+
+/* Apply a tuning entry's schedule to the schedule(runtime) loops that
+ * follow; returns the caller's setting for minmax_schedule_restore() */
+typedef struct { omp_sched_t kind; int chunk; } minmax_sched_saved;
+minmax_sched_saved minmax_schedule_apply(const minmax_tuning *t);
+void               minmax_schedule_restore(minmax_sched_saved s);
+
+/* Cache tile (TI x TJ x TK elements) used by the tiled strategies for this
+ * shape, tuning and the caller's thread count; defined in minmax_tiled.c */
+void minmax_tile_shape(int M, int N, int P, const minmax_tuning *t, int *ti, int *tj, int *tk);
+
+/* The ultimate strategy over the box [i0,i1) x [j0,j1) x [k0,k1) of a
+ * parent a[.][N][P], in place; positions are parent coordinates */
+void minmax_ultimate_box(const int *a, int N, int P,
+                         int i0, int i1, int j0, int j1, int k0, int k1,
+                         MinMaxLoc *vmin, MinMaxLoc *vmax);
+
+/*
+ * Shapes with a compile-time specialised MINMAX_FIXED kernel, as
+ * X(N, P, rows per block): the row length and the rows per 16 KB block
+ * are constants, so the row scan unrolls fully and has no tail. M stays a
+ * runtime loop bound. Each entry needs P % 8 == 0, P <= 1024 and N a
+ * multiple of the block rows (checked at compile time); add a line to
+ * specialise another shape.
+ */
+#define MINMAX_FIXED_SHAPES(X) \
+    X(256, 256, 16)            \
+    X(512, 512, 8)             \
+    X(1024, 64, 64)
+
+typedef struct {
+    int N, P;
+    void (*fn)(const int *a, int M, MinMaxLoc *vmin, MinMaxLoc *vmax);
+} FixedKernel;
+
+/* AVX2 instantiations, terminated by { 0, 0, NULL }; minmax_fixed_avx2.c */
+extern const FixedKernel minmax_fixed_avx2[];
+
+/*
+ * Bit-packed block codes (minmax_bitpack.c). A block's 1024 codes of
+ * `bits` bits are split over BITPACK_LANES interleaved lanes, element x in
+ * lane x % 8 at bit (x / 8) * bits of that lane, lane words stored side
+ * by side (word w of lane l at w * 8 + l). One vector shift therefore
+ * decodes 8 consecutive elements. A block takes 32 * bits words.
+ */
+#define BITPACK_LANES 8
+
+/* AVX2 decoders; minmax_bitpack_avx2.c */
+long bitpack_find_avx2(const uint32_t *w, int bits, uint32_t code);
+void bitpack_decode_avx2(const uint32_t *w, int bits, int base, int *out);
+
+#ifdef MINMAX_CUDA
+/* Warp-shuffle backend behind minmax_dev_*(), defined in minmax_cuda.cu
+ * (make CUDA=1); it mirrors ValIdx with its own layout-identical struct */
+int   minmax_cuda_count(void);
+void *minmax_cuda_upload(const int *a, long n);
+int   minmax_cuda_query(void *h, long n, ValIdx *vmin, ValIdx *vmax);
+void  minmax_cuda_free(void *h);
+#endif
+
+/* Strategy entry points (one per driver), defined in minmax_*.c */
+typedef void (*minmax_flat_fn)(const int *a, int M, int N, int P,
+                               MinMaxLoc *vmin, MinMaxLoc *vmax);
+typedef void (*minmax_ptr_fn)(int *const *const *a, int M, int N, int P,
+                              MinMaxLoc *vmin, MinMaxLoc *vmax);
+
+void minmax_sequential(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_parallel_for(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_sections(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_nested(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_simd(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_omp_simd(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_tiled(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_tasks(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_branchless(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_ultimate(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_tasks_adaptive(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_numa(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_stream(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_fixed(const int *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+
+void minmax_ptr_sequential(int *const *const *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_ptr_parallel_for(int *const *const *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_ptr_sections(int *const *const *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+void minmax_ptr_combined(int *const *const *a, int M, int N, int P, MinMaxLoc *vmin, MinMaxLoc *vmax);
+
+#endif /* MINMAX_IMPL_H */
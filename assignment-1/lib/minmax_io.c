@@ -0,0 +1,368 @@
+/*
+ * File-backed volumes: zero-copy mmap loading and an out-of-core streaming
+ * scan for files larger than RAM.
+ *
+ * File format: little-endian int32 a[M][N][P], either raw (the caller
+ * supplies the shape) or preceded by a 32-byte header
+ *     char     magic[8]     "MINMAXV1"
+ *     uint32_t m, n, p
+ *     uint32_t elem_bytes   4
+ *     uint64_t data_offset  32
+ * minmax_volume_write() produces the headed form.
+ */
+#define _GNU_SOURCE
+#include "minmax_impl.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define VOL_MAGIC "MINMAXV1"
+
+typedef struct {
+    char     magic[8];
+    uint32_t m, n, p;
+    uint32_t elem_bytes;
+    uint64_t data_offset;
+} VolHeader;
+
+_Static_assert(sizeof(VolHeader) == MINMAX_VOLUME_HEADER_BYTES, "header layout");
+
+/*
+ * Work out shape and data offset of an open file. M/N/P of 0 mean "take
+ * them from the header"; non-zero values must match a header if present,
+ * and are required for raw files.
+ */
+static int probe_file(int fd, off_t file_size, int *M, int *N, int *P, off_t *data_off)
+{
+    VolHeader h;
+    int headed = file_size >= (off_t)sizeof h &&
+                 pread(fd, &h, sizeof h, 0) == (ssize_t)sizeof h &&
+                 memcmp(h.magic, VOL_MAGIC, 8) == 0;
+
+    if (headed) {
+        if (h.elem_bytes != sizeof(int) || h.m == 0 || h.n == 0 || h.p == 0 ||
+            h.m > INT_MAX || h.n > INT_MAX || h.p > INT_MAX)
+            return -1;
+        if ((*M && *M != (int)h.m) || (*N && *N != (int)h.n) || (*P && *P != (int)h.p))
+            return -1;
+        /* The data must follow the header and stay int-aligned in the map */
+        if (h.data_offset < sizeof h || h.data_offset % sizeof(int) != 0 ||
+            h.data_offset > (uint64_t)file_size)
+            return -1;
+        *M = (int)h.m; *N = (int)h.n; *P = (int)h.p;
+        *data_off = (off_t)h.data_offset;
+    } else {
+        if (*M <= 0 || *N <= 0 || *P <= 0)
+            return -1;
+        *data_off = 0;
+    }
+
+    off_t need = *data_off + (off_t)((long)*M * *N * *P * (long)sizeof(int));
+    return file_size >= need ? 0 : -1;
+}
+
+int minmax_volume_open(const char *path, int M, int N, int P, unsigned flags,
+                       minmax_volume *vol)
+{
+    if (!path || !vol)
+        return -1;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat st;
+    off_t data_off;
+    if (fstat(fd, &st) != 0 || probe_file(fd, st.st_size, &M, &N, &P, &data_off) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    int mflags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (flags & MINMAX_MAP_POPULATE)
+        mflags |= MAP_POPULATE;
+#endif
+
+    size_t len = (size_t)st.st_size;
+    void *map = mmap(NULL, len, PROT_READ, mflags, fd, 0);
+    close(fd);   /* the mapping keeps the file referenced */
+    if (map == MAP_FAILED)
+        return -1;
+
+    /* Advice only: failures (e.g. no THP for this filesystem) are harmless */
+    madvise(map, len, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(map, len, MADV_HUGEPAGE);
+#endif
+
+    vol->data    = (const int *)((const char *)map + data_off);
+    vol->M       = M;
+    vol->N       = N;
+    vol->P       = P;
+    vol->map     = map;
+    vol->map_len = len;
+    return 0;
+}
+
+int minmax_volume_probe(const char *path, int *M, int *N, int *P, long *data_offset)
+{
+    if (!path || !M || !N || !P || !data_offset)
+        return -1;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat st;
+    off_t data_off;
+    int rc = fstat(fd, &st) == 0 ? probe_file(fd, st.st_size, M, N, P, &data_off) : -1;
+    close(fd);
+    if (rc == 0)
+        *data_offset = (long)data_off;
+    return rc;
+}
+
+void minmax_volume_close(minmax_volume *vol)
+{
+    if (vol && vol->map) {
+        munmap(vol->map, vol->map_len);
+        vol->map  = NULL;
+        vol->data = NULL;
+    }
+}
+
+static int write_all(int fd, const void *buf, size_t len)
+{
+    const char *p = buf;
+    while (len > 0) {
+        ssize_t w = write(fd, p, len);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += w;
+        len -= (size_t)w;
+    }
+    return 0;
+}
+
+int minmax_volume_write(const char *path, const int *a, int M, int N, int P)
+{
+    if (!path || !a || M <= 0 || N <= 0 || P <= 0)
+        return -1;
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+
+    VolHeader h;
+    memcpy(h.magic, VOL_MAGIC, 8);
+    h.m = (uint32_t)M; h.n = (uint32_t)N; h.p = (uint32_t)P;
+    h.elem_bytes  = sizeof(int);
+    h.data_offset = sizeof h;
+
+    int rc = write_all(fd, &h, sizeof h);
+    if (rc == 0)
+        rc = write_all(fd, a, (size_t)M * N * P * sizeof(int));
+    if (close(fd) != 0)
+        rc = -1;
+    return rc;
+}
+
+/* ================================================================
+ *  Streaming: an I/O thread fills one buffer while the OpenMP team
+ *  reduces the other, so scan time hides behind read time.
+ * ================================================================ */
+
+/* Elements per kernel call inside a chunk (keeps static balancing fine-grained) */
+#define STREAM_BLOCK 65536
+
+typedef struct {
+    int    fd;
+    off_t  data_off;
+    long   total, chunk;        /* elements */
+    int   *buf[2];
+    long   len[2];              /* elements in a full slot */
+    int    full[2];
+    int    err;
+    pthread_mutex_t mu;
+    pthread_cond_t  cv;
+} Stream;
+
+static int read_full(int fd, void *buf, size_t len, off_t off)
+{
+    char *p = buf;
+    while (len > 0) {
+        ssize_t r = pread(fd, p, len, off);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        p += r; off += r; len -= (size_t)r;
+    }
+    return 0;
+}
+
+static void *stream_reader(void *arg)
+{
+    Stream *s = arg;
+    long nchunks = (s->total + s->chunk - 1) / s->chunk;
+
+    for (long c = 0; c < nchunks; c++) {
+        int slot = (int)(c & 1);
+
+        pthread_mutex_lock(&s->mu);
+        while (s->full[slot] && !s->err)
+            pthread_cond_wait(&s->cv, &s->mu);
+        int stop = s->err;
+        pthread_mutex_unlock(&s->mu);
+        if (stop)
+            break;
+
+        long first = c * s->chunk;
+        long n = (s->total - first < s->chunk) ? s->total - first : s->chunk;
+        off_t off = s->data_off + (off_t)first * (off_t)sizeof(int);
+        int rc = read_full(s->fd, s->buf[slot], (size_t)n * sizeof(int), off);
+
+#ifdef POSIX_FADV_DONTNEED
+        /* Out-of-core: the bytes are in our buffer now, drop them from the page cache */
+        if (rc == 0)
+            posix_fadvise(s->fd, off, (off_t)n * (off_t)sizeof(int), POSIX_FADV_DONTNEED);
+#endif
+
+        pthread_mutex_lock(&s->mu);
+        if (rc != 0)
+            s->err = 1;
+        s->len[slot]  = n;
+        s->full[slot] = 1;
+        pthread_cond_broadcast(&s->cv);
+        pthread_mutex_unlock(&s->mu);
+        if (rc != 0)
+            break;
+    }
+    return NULL;
+}
+
+/* Reduce one in-memory chunk with the dispatched kernel; indices are chunk-relative */
+static void scan_chunk(const ScanKernels *sk, const int *buf, long n,
+                       ValIdx *cmin_out, ValIdx *cmax_out)
+{
+    ValIdx cmin = { INT_MAX, LONG_MAX };
+    ValIdx cmax = { INT_MIN, LONG_MAX };
+    long nblocks = (n + STREAM_BLOCK - 1) / STREAM_BLOCK;
+
+    #pragma omp parallel for schedule(static) reduction(valmin : cmin) reduction(valmax : cmax)
+    for (long b = 0; b < nblocks; b++) {
+        long lo = b * STREAM_BLOCK;
+        long hi = (lo + STREAM_BLOCK < n) ? lo + STREAM_BLOCK : n;
+        sk->minmax(buf, lo, hi, &cmin, &cmax);
+    }
+
+    *cmin_out = cmin;
+    *cmax_out = cmax;
+}
+
+int minmax_loc_file_stream(const char *path, int M, int N, int P, size_t chunk_bytes,
+                           MinMaxLoc *min, MinMaxLoc *max)
+{
+    if (!path || !min || !max)
+        return -1;
+
+    Stream s;
+    memset(&s, 0, sizeof s);
+
+    s.fd = open(path, O_RDONLY);
+    if (s.fd < 0)
+        return -1;
+
+    struct stat st;
+    if (fstat(s.fd, &st) != 0 || probe_file(s.fd, st.st_size, &M, &N, &P, &s.data_off) != 0) {
+        close(s.fd);
+        return -1;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(s.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    if (chunk_bytes == 0)
+        chunk_bytes = MINMAX_STREAM_DEFAULT_CHUNK;
+    s.total = (long)M * N * P;
+    s.chunk = (long)(chunk_bytes / sizeof(int));
+    if (s.chunk < STREAM_BLOCK)
+        s.chunk = STREAM_BLOCK;
+    if (s.chunk > s.total)
+        s.chunk = s.total;
+
+    for (int b = 0; b < 2; b++) {
+        if (posix_memalign((void **)&s.buf[b], 4096, (size_t)s.chunk * sizeof(int)) != 0) {
+            free(s.buf[0]);
+            close(s.fd);
+            return -1;
+        }
+    }
+    pthread_mutex_init(&s.mu, NULL);
+    pthread_cond_init(&s.cv, NULL);
+
+    pthread_t reader;
+    int started = pthread_create(&reader, NULL, stream_reader, &s) == 0;
+    int rc = started ? 0 : -1;
+
+    const ScanKernels *sk = scan_kernels();
+    MinMaxLoc gmin = { .val = INT_MAX, .i = 0, .j = 0, .k = 0 };
+    MinMaxLoc gmax = { .val = INT_MIN, .i = 0, .j = 0, .k = 0 };
+    long nchunks = (s.total + s.chunk - 1) / s.chunk;
+
+    for (long c = 0; rc == 0 && c < nchunks; c++) {
+        int slot = (int)(c & 1);
+
+        pthread_mutex_lock(&s.mu);
+        while (!s.full[slot] && !s.err)
+            pthread_cond_wait(&s.cv, &s.mu);
+        if (s.err)
+            rc = -1;
+        pthread_mutex_unlock(&s.mu);
+        if (rc != 0)
+            break;
+
+        ValIdx cmin, cmax;
+        scan_chunk(sk, s.buf[slot], s.len[slot], &cmin, &cmax);
+
+        /* Carry global indices across chunks; earlier chunks win ties */
+        long base = c * s.chunk;
+        MinMaxLoc lmin = loc_from_validx(&cmin, base, N, P);
+        MinMaxLoc lmax = loc_from_validx(&cmax, base, N, P);
+        if (c == 0 || lmin.val < gmin.val) gmin = lmin;
+        if (c == 0 || lmax.val > gmax.val) gmax = lmax;
+
+        pthread_mutex_lock(&s.mu);
+        s.full[slot] = 0;
+        pthread_cond_broadcast(&s.cv);
+        pthread_mutex_unlock(&s.mu);
+    }
+
+    if (started) {
+        /* Wake the reader if we bailed out early, then wait for it */
+        pthread_mutex_lock(&s.mu);
+        if (rc != 0) s.err = 1;
+        pthread_cond_broadcast(&s.cv);
+        pthread_mutex_unlock(&s.mu);
+        pthread_join(reader, NULL);
+    }
+
+    pthread_cond_destroy(&s.cv);
+    pthread_mutex_destroy(&s.mu);
+    free(s.buf[0]);
+    free(s.buf[1]);
+    close(s.fd);
+
+    if (rc != 0)
+        return -1;
+    *min = gmin;
+    *max = gmax;
+    return 0;
+}
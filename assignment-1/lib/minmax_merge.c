@@ -0,0 +1,51 @@
+/*
+ * Merge mode for the strategies that fold per-thread winners under a lock.
+ *
+ * The packed-key merge itself is inline in minmax_impl.h; this file only
+ * holds the process-wide switch, read from MINMAX_MERGE at load time.
+ */
+#include "minmax_impl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const merge_names[MINMAX_MERGE_NUM_MODES] = { "critical", "lockfree" };
+
+static _Atomic int merge_mode = MINMAX_MERGE_CRITICAL;
+
+__attribute__((constructor))
+static void merge_select(void)
+{
+    const char *env = getenv("MINMAX_MERGE");
+    if (!env || !*env)
+        return;
+    for (int m = 0; m < MINMAX_MERGE_NUM_MODES; m++)
+        if (strcmp(env, merge_names[m]) == 0) {
+            merge_mode = m;
+            return;
+        }
+    fprintf(stderr, "MINMAX_MERGE=%s is not a merge mode, using critical\n", env);
+}
+
+int minmax_set_merge(minmax_merge m)
+{
+    if ((unsigned)m >= MINMAX_MERGE_NUM_MODES)
+        return -1;
+    merge_mode = m;
+    return 0;
+}
+
+minmax_merge minmax_get_merge(void)
+{
+    return (minmax_merge)merge_mode;
+}
+
+const char *minmax_merge_name(minmax_merge m)
+{
+    return (unsigned)m < MINMAX_MERGE_NUM_MODES ? merge_names[m] : NULL;
+}
+
+int minmax_merge_lockfree(long n)
+{
+    return merge_mode == MINMAX_MERGE_LOCKFREE && n <= PACKED_MAX_ELEMS;
+}
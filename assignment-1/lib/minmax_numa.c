@@ -0,0 +1,308 @@
+/*
+ * novel_numa.c — NUMA-aware placement: pinned threads, node-local slabs and
+ * a two-level (per node, then across nodes) reduction.
+ *
+ * The topology comes from /sys/devices/system/node (the same source
+ * libnuma reads, without linking it), restricted to the CPUs the process
+ * may run on; without sysfs the host is one node. MINMAX_NUMA_NODES=n
+ * instead splits the allowed CPUs into n equal fake nodes, so the layout
+ * and the hierarchy can be exercised on a single-socket machine.
+ *
+ * Layout for a team of T threads: threads are numbered node-major and each
+ * node gets a share of T proportional to its CPU count. Thread t owns the
+ * flat range [n*t/T, n*(t+1)/T) rounded down to page boundaries, so a
+ * node's threads together own one contiguous slab (the planes of M, or
+ * rows when M is too small to split). minmax_numa_touch() writes every
+ * range from its owner, pinned, which under the kernel's first-touch
+ * policy puts each page on the node that will scan it; minmax_numa()
+ * reads the same ranges from the same CPUs, so the scan never crosses the
+ * interconnect.
+ *
+ * Each thread scans its range with the dispatched SIMD kernel into a
+ * padded slot; the first thread of every node folds its node's slots, and
+ * the master folds the node results. Ranges ascend with t, so strict
+ * compares with the flat-index combiners keep the first occurrence.
+ *
+ * Worker threads stay pinned after a call (the pool is reused, so the
+ * next call finds them in place); the calling thread gets its own affinity
+ * mask back.
+ */
+#define _GNU_SOURCE
+#include "minmax_impl.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define NUMA_MAX_NODES 64
+#define NUMA_PAGE_INTS (4096 / (long)sizeof(int))
+
+typedef struct {
+    int  nnodes;
+    int  ncpus;                         /* usable CPUs over all nodes      */
+    int  first_cpu[NUMA_MAX_NODES + 1]; /* node d owns cpus[first_cpu[d]..first_cpu[d+1]) */
+    int *cpus;
+} NumaTopology;
+
+typedef struct {
+    int node;
+    int first, count;   /* threads [first, first+count) share the node */
+    int cpu;
+} NumaPlace;
+
+/* Per-thread scan result on its own cache line */
+typedef struct {
+    ValIdx min, max;
+} __attribute__((aligned(64))) NumaSlot;
+
+static NumaTopology topo;
+static pthread_once_t topo_once = PTHREAD_ONCE_INIT;
+
+/* Parse a sysfs cpulist ("0-3,8-11") into the usable CPUs of node d */
+static void add_cpulist(const char *list, const cpu_set_t *allowed, int *cpus, int *n)
+{
+    const char *p = list;
+    while (*p && *p != '\n') {
+        char *end;
+        long lo = strtol(p, &end, 10), hi = lo;
+        if (end == p)
+            return;
+        if (*end == '-')
+            hi = strtol(end + 1, &end, 10);
+        for (long c = lo; c <= hi && c < CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, allowed))
+                cpus[(*n)++] = (int)c;
+        p = *end == ',' ? end + 1 : end;
+    }
+}
+
+static void discover(void)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        for (int c = 0; c < CPU_SETSIZE; c++)
+            CPU_SET(c, &allowed);
+
+    topo.cpus = malloc((CPU_SETSIZE + NUMA_MAX_NODES) * sizeof(int));
+    if (!topo.cpus)
+        abort();
+
+    int n = 0;
+    const char *fake = getenv("MINMAX_NUMA_NODES");
+    if (!fake || atoi(fake) <= 0) {
+        /* Node ids may have holes; "possible" ("0-3") bounds them */
+        int last = 0;
+        FILE *f = fopen("/sys/devices/system/node/possible", "r");
+        if (f) {
+            char line[64];
+            if (fgets(line, sizeof(line), f)) {
+                char *dash = strrchr(line, '-');
+                last = atoi(dash ? dash + 1 : line);
+            }
+            fclose(f);
+        }
+        for (int d = 0; d <= last && topo.nnodes < NUMA_MAX_NODES; d++) {
+            char path[96], line[4096];
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", d);
+            f = fopen(path, "r");
+            if (!f)
+                continue;
+            int before = n;
+            if (fgets(line, sizeof(line), f))
+                add_cpulist(line, &allowed, topo.cpus, &n);
+            fclose(f);
+            if (n > before)     /* memory-only and fully masked nodes own no threads */
+                topo.first_cpu[topo.nnodes++] = before;
+        }
+    }
+
+    if (topo.nnodes == 0) {
+        /* No sysfs, or fake nodes: allowed CPUs in order, split evenly */
+        n = 0;
+        for (int c = 0; c < CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, &allowed))
+                topo.cpus[n++] = c;
+        int want = fake ? atoi(fake) : 1;
+        if (want < 1) want = 1;
+        if (want > NUMA_MAX_NODES) want = NUMA_MAX_NODES;
+        topo.nnodes = want;
+        for (int d = 0; d < want; d++)
+            topo.first_cpu[d] = (int)((long)n * d / want);
+        /* more fake nodes than CPUs: nodes share CPUs instead of being empty */
+        if (want > n) {
+            for (int d = 0; d < want; d++)
+                topo.cpus[n + d] = topo.cpus[d % n];
+            for (int d = 0; d < want; d++)
+                topo.first_cpu[d] = n + d;
+            topo.first_cpu[want] = n + want;
+            topo.ncpus = want;
+            return;
+        }
+    }
+    topo.first_cpu[topo.nnodes] = n;
+    topo.ncpus = n;
+}
+
+static const NumaTopology *numa_topology(void)
+{
+    pthread_once(&topo_once, discover);
+    return &topo;
+}
+
+int minmax_numa_nodes(void)
+{
+    return numa_topology()->nnodes;
+}
+
+/* Node, node team and CPU of thread t in a team of T */
+static NumaPlace numa_place(const NumaTopology *tp, int t, int T)
+{
+    NumaPlace pl = { 0, 0, T, tp->cpus[tp->first_cpu[0]] };
+    int base = tp->first_cpu[0];
+    int total = tp->first_cpu[tp->nnodes] - base;
+    for (int d = 0; d < tp->nnodes; d++) {
+        int first = (int)((long)T * (tp->first_cpu[d] - base) / total);
+        int next  = (int)((long)T * (tp->first_cpu[d + 1] - base) / total);
+        if (t >= first && t < next) {
+            int ncpu = tp->first_cpu[d + 1] - tp->first_cpu[d];
+            pl.node  = d;
+            pl.first = first;
+            pl.count = next - first;
+            pl.cpu   = tp->cpus[tp->first_cpu[d] + (t - first) % ncpu];
+            break;
+        }
+    }
+    return pl;
+}
+
+/* Flat range of thread t, page-aligned so no page has two owners */
+static void numa_range(long n, int t, int T, long *lo, long *hi)
+{
+    long a = n / T * t + n % T * t / T;
+    long b = n / T * (t + 1) + n % T * (t + 1) / T;
+    *lo = t == 0 ? 0 : a & ~(NUMA_PAGE_INTS - 1);
+    *hi = t == T - 1 ? n : b & ~(NUMA_PAGE_INTS - 1);
+    if (*hi < *lo)
+        *hi = *lo;
+}
+
+/* CPU this thread was pinned to by us, -1 if not (or restored since) */
+static __thread int pinned = -1;
+
+/* Pin the calling thread to cpu; cheap when it already is */
+static void pin_self(int cpu)
+{
+    if (pinned == cpu)
+        return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) == 0)
+        pinned = cpu;
+}
+
+/* The caller's mask is saved and restored around every call */
+static void unpin_self(const cpu_set_t *saved)
+{
+    if (sched_setaffinity(0, sizeof(*saved), saved) == 0)
+        pinned = -1;
+}
+
+int minmax_numa_touch(int *a, long n)
+{
+    if (!a || n <= 0)
+        return -1;
+    const NumaTopology *tp = numa_topology();
+
+    cpu_set_t saved;
+    int have_saved = sched_getaffinity(0, sizeof(saved), &saved) == 0;
+
+    #pragma omp parallel
+    {
+        int t = omp_get_thread_num(), T = omp_get_num_threads();
+        pin_self(numa_place(tp, t, T).cpu);
+        long lo, hi;
+        numa_range(n, t, T, &lo, &hi);
+        memset(a + lo, 0, (size_t)(hi - lo) * sizeof(int));
+    }
+
+    if (have_saved)
+        unpin_self(&saved);
+    return tp->nnodes;
+}
+
+void minmax_numa(const int *a, int M, int N, int P,
+                 MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    const ScanKernels *sk = scan_kernels();
+    const NumaTopology *tp = numa_topology();
+    long n = (long)M * N * P;
+
+    int maxT = omp_get_max_threads();
+    NumaSlot *slot = aligned_alloc(64, (size_t)maxT * sizeof(NumaSlot));
+    NumaSlot *node = aligned_alloc(64, (size_t)tp->nnodes * sizeof(NumaSlot));
+    if (!slot || !node) {
+        free(slot);
+        free(node);
+        minmax_ultimate(a, M, N, P, out_min, out_max);
+        return;
+    }
+
+    cpu_set_t saved;
+    int have_saved = sched_getaffinity(0, sizeof(saved), &saved) == 0;
+    ValIdx vmin = { INT_MAX, 0 }, vmax = { INT_MIN, 0 };
+
+    #pragma omp parallel num_threads(maxT)
+    {
+        int t = omp_get_thread_num(), T = omp_get_num_threads();
+        NumaPlace pl = numa_place(tp, t, T);
+        pin_self(pl.cpu);
+
+        long lo, hi;
+        numa_range(n, t, T, &lo, &hi);
+        NumaSlot s = { { INT_MAX, LONG_MAX }, { INT_MIN, LONG_MAX } };
+        if (lo < hi) {
+            s.min.idx = s.max.idx = lo;
+            sk->minmax(a, lo, hi, &s.min, &s.max);
+        }
+        slot[t] = s;
+
+        #pragma omp barrier
+
+        /* Level 1: the node's first thread folds its node, in thread order */
+        if (t == pl.first) {
+            NumaSlot r = slot[pl.first];
+            for (int x = pl.first + 1; x < pl.first + pl.count; x++) {
+                valmin_combine(&r.min, &slot[x].min);
+                valmax_combine(&r.max, &slot[x].max);
+            }
+            node[pl.node] = r;
+        }
+
+        #pragma omp barrier
+
+        /* Level 2: nodes in order; nodes that got no threads are skipped */
+        #pragma omp master
+        {
+            vmin = slot[0].min;     /* any seed works: node 0's winner is folded again */
+            vmax = slot[0].max;
+            for (int x = 0; x < T; x++) {
+                NumaPlace q = numa_place(tp, x, T);
+                if (x != q.first)
+                    continue;
+                valmin_combine(&vmin, &node[q.node].min);
+                valmax_combine(&vmax, &node[q.node].max);
+            }
+        }
+    }
+
+    if (have_saved)
+        unpin_self(&saved);
+    free(slot);
+    free(node);
+
+    *out_min = loc_from_flat(vmin.val, vmin.idx, N, P);
+    *out_max = loc_from_flat(vmax.val, vmax.idx, N, P);
+}
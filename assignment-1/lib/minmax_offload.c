@@ -0,0 +1,158 @@
+/*
+ * Accelerator offload: device-resident volumes queried with an OpenMP
+ * target reduction, or with the warp-shuffle CUDA kernel (minmax_cuda.cu).
+ *
+ * The CPU kernels stop at DRAM bandwidth; an accelerator with HBM reads
+ * the volume several times faster, but only once it is there. Uploading is
+ * therefore separate from querying: minmax_dev_upload() copies the array
+ * into device memory (omp_target_alloc + omp_target_memcpy, or cudaMemcpy)
+ * and every minmax_dev_query() after that runs on the resident copy and
+ * brings back two (value, index) pairs. Both steps are timed, so callers
+ * can see after how many queries a transfer has paid for itself.
+ *
+ * The OpenMP kernel is one `target teams distribute parallel for simd` over the
+ * flat range with two user-defined reductions over ValIdx. The combiners
+ * are written inline in the declare reduction, not as calls to the host
+ * helpers in minmax_impl.h, so the compiler can emit them for the device.
+ * Each thread sees ascending indices, keeps the first of equal values with
+ * strict compares, and the combiners break ties on the lower index, so
+ * results match minmax_loc_3d(). Without a device the target region runs
+ * on the host (omp_get_initial_device()), at the speed of a plain parallel
+ * for; `make OFFLOAD=nvptx-none` (or amdgcn-amdhsa) emits device code.
+ */
+#include "minmax_impl.h"
+#include <stdlib.h>
+
+#pragma omp declare reduction(devmin : ValIdx : \
+        omp_out = (omp_in.val < omp_out.val || \
+                   (omp_in.val == omp_out.val && omp_in.idx < omp_out.idx)) ? omp_in : omp_out) \
+        initializer(omp_priv = (ValIdx){ INT_MAX, LONG_MAX })
+
+#pragma omp declare reduction(devmax : ValIdx : \
+        omp_out = (omp_in.val > omp_out.val || \
+                   (omp_in.val == omp_out.val && omp_in.idx < omp_out.idx)) ? omp_in : omp_out) \
+        initializer(omp_priv = (ValIdx){ INT_MIN, LONG_MAX })
+
+struct minmax_dev {
+    minmax_dev_backend backend;
+    int   M, N, P;
+    long  n;
+    int   device;           /* OpenMP device number                  */
+    int  *data;             /* OpenMP: device pointer                */
+    void *cuda;             /* CUDA: minmax_cuda.cu state            */
+};
+
+static const char *const backend_names[MINMAX_DEV_NUM_BACKENDS] = { "openmp", "cuda" };
+
+const char *minmax_dev_backend_name(minmax_dev_backend b)
+{
+    return (unsigned)b < MINMAX_DEV_NUM_BACKENDS ? backend_names[b] : NULL;
+}
+
+int minmax_dev_count(minmax_dev_backend b)
+{
+    switch (b) {
+    case MINMAX_DEV_OPENMP:
+        return omp_get_num_devices();
+    case MINMAX_DEV_CUDA:
+#ifdef MINMAX_CUDA
+        return minmax_cuda_count();
+#else
+        return -1;
+#endif
+    default:
+        return -1;
+    }
+}
+
+static int omp_device(void)
+{
+    return omp_get_num_devices() > 0 ? omp_get_default_device() : omp_get_initial_device();
+}
+
+minmax_dev *minmax_dev_upload(minmax_dev_backend b, const int *a, int M, int N, int P,
+                              minmax_dev_timing *t)
+{
+    if (!a || M <= 0 || N <= 0 || P <= 0 || minmax_dev_count(b) < 0)
+        return NULL;
+    if (b == MINMAX_DEV_CUDA && minmax_dev_count(b) == 0)
+        return NULL;
+
+    minmax_dev *d = calloc(1, sizeof(*d));
+    if (!d)
+        return NULL;
+    *d = (minmax_dev){ b, M, N, P, (long)M * N * P, -1, NULL, NULL };
+    size_t bytes = (size_t)d->n * sizeof(int);
+
+    double t0 = omp_get_wtime();
+    if (b == MINMAX_DEV_OPENMP) {
+        d->device = omp_device();
+        d->data = omp_target_alloc(bytes, d->device);
+        if (!d->data ||
+            omp_target_memcpy(d->data, (void *)a, bytes, 0, 0, d->device,
+                              omp_get_initial_device()) != 0) {
+            minmax_dev_free(d);
+            return NULL;
+        }
+    }
+#ifdef MINMAX_CUDA
+    if (b == MINMAX_DEV_CUDA && !(d->cuda = minmax_cuda_upload(a, d->n))) {
+        free(d);
+        return NULL;
+    }
+#endif
+    if (t)
+        t->transfer = omp_get_wtime() - t0;
+    return d;
+}
+
+void minmax_dev_free(minmax_dev *d)
+{
+    if (!d)
+        return;
+    if (d->data)
+        omp_target_free(d->data, d->device);
+#ifdef MINMAX_CUDA
+    if (d->cuda)
+        minmax_cuda_free(d->cuda);
+#endif
+    free(d);
+}
+
+static void omp_dev_scan(const minmax_dev *d, ValIdx *vmin, ValIdx *vmax)
+{
+    const int *a = d->data;
+    long n = d->n;
+    ValIdx mn = { INT_MAX, LONG_MAX }, mx = { INT_MIN, LONG_MAX };
+
+    #pragma omp target teams distribute parallel for simd device(d->device) is_device_ptr(a) \
+            map(tofrom: mn, mx) reduction(devmin : mn) reduction(devmax : mx)
+    for (long x = 0; x < n; x++) {
+        int v = a[x];
+        if (v < mn.val) { mn.val = v; mn.idx = x; }
+        if (v > mx.val) { mx.val = v; mx.idx = x; }
+    }
+    *vmin = mn;
+    *vmax = mx;
+}
+
+int minmax_dev_query(minmax_dev *d, MinMaxLoc *min, MinMaxLoc *max, minmax_dev_timing *t)
+{
+    if (!d || !min || !max)
+        return -1;
+
+    ValIdx vmin = { INT_MAX, 0 }, vmax = { INT_MIN, 0 };
+    double t0 = omp_get_wtime();
+    if (d->backend == MINMAX_DEV_OPENMP)
+        omp_dev_scan(d, &vmin, &vmax);
+#ifdef MINMAX_CUDA
+    else if (minmax_cuda_query(d->cuda, d->n, &vmin, &vmax) != 0)
+        return -1;
+#endif
+    if (t)
+        t->kernel = omp_get_wtime() - t0;
+
+    *min = loc_from_validx(&vmin, 0, d->N, d->P);
+    *max = loc_from_validx(&vmax, 0, d->N, d->P);
+    return 0;
+}
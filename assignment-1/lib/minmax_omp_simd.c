@@ -0,0 +1,74 @@
+/*
+ * novel_omp_simd.c — two phases: an auto-vectorised value-only
+ * reduction(min/max) that also remembers which block held each winner,
+ * then a SIMD search for the first index inside that one block.
+ *
+ * Phase 1 walks the volume in L1-sized blocks (OMP_SIMD_BLOCK elements).
+ * Each block is folded by `omp simd reduction(min/max)` into two values,
+ * so the inner loop is pure vpminsd/vpmaxsd; a block that strictly beats
+ * the thread's best replaces it together with its block number. The
+ * threads' (value, block) pairs are combined by the valmin/valmax
+ * reductions, which keep the lower block on ties, so the result is the
+ * first block that contains the global min (resp. max).
+ *
+ * Phase 2 then looks for the first element equal to the winning value,
+ * only inside that block, with the dispatched find kernel (cmpeq +
+ * movemask, ctz on the first non-zero mask). Index recovery costs one
+ * 16 KB block instead of a second pass over the whole volume.
+ *
+ * Phase 1 relies on the compiler's vectoriser and is built with the
+ * baseline flags only, so the library runs on any host of the target
+ * architecture; the ISA-specific code stays behind scan_kernels().
+ */
+#include "minmax_impl.h"
+
+/* Elements per phase-1 block: 16 KB, a quarter of a typical L1d */
+#define OMP_SIMD_BLOCK 4096L
+
+static inline long block_end(long lo, long total)
+{
+    return total - lo > OMP_SIMD_BLOCK ? lo + OMP_SIMD_BLOCK : total;
+}
+
+/* First i in [lo, hi) with a[i] == val; the block is known to contain it */
+static long find_first(const ScanKernels *sk, const int *a, long lo, long hi, int val)
+{
+    long i = sk->find(a, lo, hi, val);
+    return i < hi ? i : lo;
+}
+
+void minmax_omp_simd(const int *a, int M, int N, int P,
+                     MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    long total = (long)M * N * P;
+    long nblocks = (total + OMP_SIMD_BLOCK - 1) / OMP_SIMD_BLOCK;
+
+    /* idx holds the block number during phase 1 */
+    ValIdx gmin = { INT_MAX, LONG_MAX };
+    ValIdx gmax = { INT_MIN, LONG_MAX };
+
+    /* ---- Phase 1: values per block (auto-vectorised), first winning block ---- */
+    #pragma omp parallel for schedule(static) reduction(valmin : gmin) reduction(valmax : gmax)
+    for (long b = 0; b < nblocks; b++) {
+        long lo = b * OMP_SIMD_BLOCK, hi = block_end(lo, total);
+
+        int bmin = INT_MAX, bmax = INT_MIN;
+        #pragma omp simd reduction(min : bmin) reduction(max : bmax) simdlen(8)
+        for (long i = lo; i < hi; i++) {
+            bmin = a[i] < bmin ? a[i] : bmin;
+            bmax = a[i] > bmax ? a[i] : bmax;
+        }
+
+        if (bmin < gmin.val) { gmin.val = bmin; gmin.idx = b; }
+        if (bmax > gmax.val) { gmax.val = bmax; gmax.idx = b; }
+    }
+
+    /* ---- Phase 2: SIMD search inside the winning block only ---- */
+    long min_lo = validx_index(&gmin) * OMP_SIMD_BLOCK, max_lo = validx_index(&gmax) * OMP_SIMD_BLOCK;
+    const ScanKernels *sk = scan_kernels();
+    long min_idx = find_first(sk, a, min_lo, block_end(min_lo, total), gmin.val);
+    long max_idx = find_first(sk, a, max_lo, block_end(max_lo, total), gmax.val);
+
+    *out_min = loc_from_flat(gmin.val, min_idx, N, P);
+    *out_max = loc_from_flat(gmax.val, max_idx, N, P);
+}
@@ -0,0 +1,226 @@
+/*
+ * Per-thread perf_event counters around a kernel call.
+ *
+ * Each OpenMP thread owns a slot with one fd per event, opened on itself
+ * (pid 0, any CPU, user space only, not grouped so an event the PMU lacks
+ * does not take the others down with it). minmax_perf_start() and _stop()
+ * are parallel regions: libgomp keeps the same pool thread behind a team
+ * slot from one region to the next, so the kernel's threads in between
+ * are the ones being counted. A slot whose OS thread changed (different
+ * team, new pool) is reopened, checked by gettid(). Counts are scaled by
+ * time_enabled / time_running when the kernel multiplexed them.
+ */
+#include "minmax_impl.h"
+#include <stdlib.h>
+
+static const char *const event_names[MINMAX_PERF_NUM_EVENTS] = {
+    "cycles", "instructions", "llc-refs", "llc-misses",
+    "branches", "branch-misses", "task-clock", "page-faults",
+};
+
+const char *minmax_perf_event_name(minmax_perf_event e)
+{
+    return (unsigned)e < MINMAX_PERF_NUM_EVENTS ? event_names[e] : NULL;
+}
+
+#ifdef MINMAX_PERF
+
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const struct { unsigned type; unsigned long long config; } event_attr[MINMAX_PERF_NUM_EVENTS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+};
+
+typedef struct {
+    long tid;                           /* OS thread the fds are bound to, 0 = none */
+    int fd[MINMAX_PERF_NUM_EVENTS];
+    minmax_perf_counts counts;
+} PerfSlot;
+
+struct minmax_perf {
+    PerfSlot *slot;
+    int cap;            /* slots allocated */
+    int nthreads;       /* team size at the last stop */
+};
+
+static void slot_close(PerfSlot *s)
+{
+    for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++) {
+        if (s->fd[e] >= 0)
+            close(s->fd[e]);
+        s->fd[e] = -1;
+    }
+    s->tid = 0;
+}
+
+static void slot_open(PerfSlot *s, long tid)
+{
+    slot_close(s);
+    for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++) {
+        struct perf_event_attr at;
+        memset(&at, 0, sizeof(at));
+        at.size = sizeof(at);
+        at.type = event_attr[e].type;
+        at.config = event_attr[e].config;
+        at.disabled = 1;
+        at.exclude_kernel = at.type == PERF_TYPE_HARDWARE;   /* faults are taken in the kernel */
+        at.exclude_hv = 1;
+        at.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        s->fd[e] = (int)syscall(SYS_perf_event_open, &at, 0, -1, -1, 0);
+    }
+    s->tid = tid;
+}
+
+/* Make room for a team of n threads; new slots start closed */
+static int grow(minmax_perf *pc, int n)
+{
+    if (n <= pc->cap)
+        return 0;
+    PerfSlot *slot = realloc(pc->slot, (size_t)n * sizeof(PerfSlot));
+    if (!slot)
+        return -1;
+    for (int t = pc->cap; t < n; t++) {
+        slot[t].tid = 0;
+        for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++)
+            slot[t].fd[e] = -1;
+        memset(&slot[t].counts, 0, sizeof(slot[t].counts));
+    }
+    pc->slot = slot;
+    pc->cap = n;
+    return 0;
+}
+
+minmax_perf *minmax_perf_open(void)
+{
+    minmax_perf *pc = calloc(1, sizeof(*pc));
+    if (pc && grow(pc, omp_get_max_threads()) != 0) {
+        free(pc);
+        return NULL;
+    }
+    return pc;
+}
+
+void minmax_perf_close(minmax_perf *pc)
+{
+    if (!pc)
+        return;
+    for (int t = 0; t < pc->cap; t++)
+        slot_close(&pc->slot[t]);
+    free(pc->slot);
+    free(pc);
+}
+
+int minmax_perf_start(minmax_perf *pc)
+{
+    if (!pc || grow(pc, omp_get_max_threads()) != 0)
+        return -1;
+
+    #pragma omp parallel
+    {
+        long tid = (long)syscall(SYS_gettid);
+        int t = omp_get_thread_num();
+        if (t < pc->cap) {
+            PerfSlot *s = &pc->slot[t];
+            if (s->tid != tid)
+                slot_open(s, tid);
+            for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++) {
+                if (s->fd[e] < 0)
+                    continue;
+                ioctl(s->fd[e], PERF_EVENT_IOC_RESET, 0);
+                ioctl(s->fd[e], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+    return 0;
+}
+
+int minmax_perf_stop(minmax_perf *pc)
+{
+    if (!pc)
+        return -1;
+
+    int team = 0;
+    #pragma omp parallel
+    {
+        int t = omp_get_thread_num();
+        #pragma omp single
+        team = omp_get_num_threads();
+
+        if (t < pc->cap) {
+            PerfSlot *s = &pc->slot[t];
+            for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++) {
+                uint64_t v[3] = { 0, 0, 0 };    /* value, time enabled, time running */
+                if (s->fd[e] >= 0) {
+                    ioctl(s->fd[e], PERF_EVENT_IOC_DISABLE, 0);
+                    if (read(s->fd[e], v, sizeof(v)) != (ssize_t)sizeof(v))
+                        v[0] = 0;
+                    else if (v[2] > 0 && v[2] < v[1])
+                        v[0] = (uint64_t)((double)v[0] * v[1] / v[2]);
+                }
+                s->counts.count[e] = v[0];
+            }
+        }
+    }
+    pc->nthreads = team < pc->cap ? team : pc->cap;
+    return 0;
+}
+
+int minmax_perf_threads(const minmax_perf *pc)
+{
+    return pc ? pc->nthreads : 0;
+}
+
+const minmax_perf_counts *minmax_perf_thread(const minmax_perf *pc, int t)
+{
+    return pc && t >= 0 && t < pc->nthreads ? &pc->slot[t].counts : NULL;
+}
+
+void minmax_perf_total(const minmax_perf *pc, minmax_perf_counts *sum)
+{
+    memset(sum, 0, sizeof(*sum));
+    for (int t = 0; pc && t < pc->nthreads; t++)
+        for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++)
+            sum->count[e] += pc->slot[t].counts.count[e];
+}
+
+unsigned minmax_perf_valid(const minmax_perf *pc)
+{
+    if (!pc || pc->nthreads == 0)
+        return 0;
+    unsigned mask = (1u << MINMAX_PERF_NUM_EVENTS) - 1;
+    for (int t = 0; t < pc->nthreads; t++)
+        for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++)
+            if (pc->slot[t].fd[e] < 0)
+                mask &= ~(1u << e);
+    return mask;
+}
+
+#else /* !MINMAX_PERF */
+
+minmax_perf *minmax_perf_open(void) { return NULL; }
+void minmax_perf_close(minmax_perf *pc) { (void)pc; }
+int  minmax_perf_start(minmax_perf *pc) { (void)pc; return -1; }
+int  minmax_perf_stop(minmax_perf *pc) { (void)pc; return -1; }
+int  minmax_perf_threads(const minmax_perf *pc) { (void)pc; return 0; }
+const minmax_perf_counts *minmax_perf_thread(const minmax_perf *pc, int t) { (void)pc; (void)t; return NULL; }
+unsigned minmax_perf_valid(const minmax_perf *pc) { (void)pc; return 0; }
+
+void minmax_perf_total(const minmax_perf *pc, minmax_perf_counts *sum)
+{
+    (void)pc;
+    for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++)
+        sum->count[e] = 0;
+}
+
+#endif /* MINMAX_PERF */
@@ -0,0 +1,164 @@
+/*
+ * Pipelined ingest: produce slab s+1 while the team scans slab s.
+ *
+ * The volume arrives as slabs of whole i-planes from a caller-supplied
+ * producer (a file reader, a socket, the generator). One OpenMP task graph
+ * overlaps the two stages over `depth` rotating buffers:
+ *
+ *   produce(s)  depend(out: buf[s % depth]) depend(inout: source)
+ *   scan(s)     depend(in:  buf[s % depth]) depend(inout: result)
+ *
+ * inout on `source` keeps the producer calls in slab order (a stream can
+ * only be read front to back); inout on `result` keeps the folds in slab
+ * order, which together with strict compares keeps the first occurrence.
+ * produce(s + depth) writes the buffer scan(s) reads, so it waits for that
+ * scan (write-after-read on buf[s % depth]) and no more than `depth` slabs
+ * are ever resident. A scan task splits its slab with a taskloop, so the
+ * threads that are not producing all work on it, and folds the per-block
+ * partials in block order.
+ *
+ * With the producer on one thread and the scan on the rest, the wall time
+ * approaches max(produce, scan) + one slab of each instead of their sum.
+ */
+#include "minmax_impl.h"
+#include <stdlib.h>
+
+/* Elements per taskloop block inside a slab */
+#define PIPELINE_BLOCK 65536L
+
+typedef struct {
+    int         *buf;
+    int          i0, planes;     /* slab currently in the buffer */
+    ValIdx      *part_min, *part_max;
+} PipeSlot;
+
+static void fold_first(ValIdx *best, const ValIdx *in, long base, int find_min)
+{
+    if (in->idx == LONG_MAX)
+        return;
+    if (find_min ? in->val < best->val : in->val > best->val) {
+        best->val = in->val;
+        best->idx = base + in->idx;
+    }
+}
+
+/* Scan one slab of n elements with every thread that is free */
+static void scan_slab(const ScanKernels *sk, PipeSlot *sl, long n, long base,
+                      ValIdx *gmin, ValIdx *gmax)
+{
+    long nblocks = (n + PIPELINE_BLOCK - 1) / PIPELINE_BLOCK;
+
+    #pragma omp taskloop grainsize(1)
+    for (long b = 0; b < nblocks; b++) {
+        long lo = b * PIPELINE_BLOCK;
+        long hi = n - lo > PIPELINE_BLOCK ? lo + PIPELINE_BLOCK : n;
+        ValIdx bmin = { INT_MAX, LONG_MAX }, bmax = { INT_MIN, LONG_MAX };
+        sk->minmax(sl->buf, lo, hi, &bmin, &bmax);
+        sl->part_min[b] = bmin;
+        sl->part_max[b] = bmax;
+    }
+
+    /* Blocks in index order after slabs in index order: strict compares
+     * keep the first occurrence */
+    for (long b = 0; b < nblocks; b++) {
+        fold_first(gmin, &sl->part_min[b], base, 1);
+        fold_first(gmax, &sl->part_max[b], base, 0);
+    }
+}
+
+int minmax_loc_pipeline(int M, int N, int P, int slab_planes, int depth,
+                        minmax_slab_fn produce, void *user,
+                        MinMaxLoc *min, MinMaxLoc *max, minmax_pipeline_timing *timing)
+{
+    if (!produce || !min || !max || M <= 0 || N <= 0 || P <= 0 || slab_planes < 0 || depth < 0)
+        return -1;
+
+    long plane = (long)N * P;
+    if (slab_planes == 0) {
+        long want = (long)(MINMAX_PIPELINE_DEFAULT_SLAB / sizeof(int)) / plane;
+        slab_planes = want < 1 ? 1 : (want > M ? M : (int)want);
+    }
+    if (slab_planes > M)
+        slab_planes = M;
+    if (depth == 0)
+        depth = 2;
+    int nslabs = (M + slab_planes - 1) / slab_planes;
+    if (depth > nslabs)
+        depth = nslabs;
+
+    long slab_elems = (long)slab_planes * plane;
+    long slab_blocks = (slab_elems + PIPELINE_BLOCK - 1) / PIPELINE_BLOCK;
+    PipeSlot *slots = calloc((size_t)depth, sizeof(PipeSlot));
+    if (!slots)
+        return -1;
+    int rc = 0;
+    for (int d = 0; d < depth && rc == 0; d++) {
+        slots[d].buf = malloc((size_t)slab_elems * sizeof(int));
+        slots[d].part_min = malloc((size_t)slab_blocks * sizeof(ValIdx));
+        slots[d].part_max = malloc((size_t)slab_blocks * sizeof(ValIdx));
+        if (!slots[d].buf || !slots[d].part_min || !slots[d].part_max)
+            rc = -1;
+    }
+
+    const ScanKernels *sk = scan_kernels();
+    ValIdx gmin = { INT_MAX, LONG_MAX }, gmax = { INT_MIN, LONG_MAX };
+    double t_produce = 0, t_scan = 0;
+    int failed = 0;
+    /* Dependence tokens, only their addresses matter: producer order, fold order */
+    char source __attribute__((unused)), result __attribute__((unused));
+    double t0 = omp_get_wtime();
+
+    if (rc == 0) {
+        #pragma omp parallel
+        #pragma omp single
+        for (int s = 0; s < nslabs; s++) {
+            PipeSlot *sl = &slots[s % depth];
+            int i0 = s * slab_planes;
+            int planes = M - i0 < slab_planes ? M - i0 : slab_planes;
+
+            #pragma omp task depend(out : sl[0]) depend(inout : source) \
+                    firstprivate(sl, i0, planes) shared(t_produce, failed)
+            {
+                double ts = omp_get_wtime();
+                sl->i0 = i0;
+                sl->planes = planes;
+                int stop;
+                #pragma omp atomic read
+                stop = failed;
+                if (!stop && produce(user, sl->buf, i0, planes, N, P) != 0) {
+                    #pragma omp atomic write
+                    failed = 1;
+                }
+                t_produce += omp_get_wtime() - ts;
+            }
+
+            #pragma omp task depend(in : sl[0]) depend(inout : result) \
+                    firstprivate(sl) shared(gmin, gmax, t_scan, failed)
+            {
+                double ts = omp_get_wtime();
+                int stop;
+                #pragma omp atomic read
+                stop = failed;
+                if (!stop)
+                    scan_slab(sk, sl, (long)sl->planes * plane, (long)sl->i0 * plane, &gmin, &gmax);
+                t_scan += omp_get_wtime() - ts;
+            }
+        }
+    }
+    double wall = omp_get_wtime() - t0;
+
+    for (int d = 0; d < depth; d++) {
+        free(slots[d].buf);
+        free(slots[d].part_min);
+        free(slots[d].part_max);
+    }
+    free(slots);
+    if (rc != 0 || failed)
+        return -1;
+
+    *min = loc_from_validx(&gmin, 0, N, P);
+    *max = loc_from_validx(&gmax, 0, N, P);
+    if (timing)
+        *timing = (minmax_pipeline_timing){ t_produce, t_scan, wall, nslabs, slab_planes };
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * Required versions (Q1-Q3) over the int*** layout, matching the assignment
+ * pseudocode: indices only, values re-read through a[i][j][k]. See the
+ * driver files (src/sequential.c, src/version{1,2,3}_*.c) for the data race
+ * analysis behind each construct.
+ */
+#include "minmax_impl.h"
+
+static MinMaxLoc ptr_loc(int *const *const *a, int i, int j, int k)
+{
+    MinMaxLoc r = { .val = a[i][j][k], .i = i, .j = j, .k = k };
+    return r;
+}
+
+/*
+ * Critical-section merge test: whether the thread's candidate (li, lj, lk)
+ * beats the global one (gi, gj, gk). Equal values keep the earlier
+ * position in row-major order, so the result does not depend on which
+ * thread takes the lock first.
+ */
+static int ptr_beats(int *const *const *a, int li, int lj, int lk,
+                     int gi, int gj, int gk, int find_min)
+{
+    int lv = a[li][lj][lk], gv = a[gi][gj][gk];
+    if (lv != gv)
+        return find_min ? lv < gv : lv > gv;
+    return li != gi ? li < gi : lj != gj ? lj < gj : lk < gk;
+}
+
+/* sequential.c — direct translation of the given pseudocode */
+void minmax_ptr_sequential(int *const *const *a, int M, int N, int P,
+                           MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    int min_i = 0, min_j = 0, min_k = 0;
+    int max_i = 0, max_j = 0, max_k = 0;
+
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < N; j++) {
+            for (int k = 0; k < P; k++) {
+                if (a[i][j][k] > a[max_i][max_j][max_k]) {
+                    max_i = i;
+                    max_j = j;
+                    max_k = k;
+                }
+                if (a[i][j][k] < a[min_i][min_j][min_k]) {
+                    min_i = i;
+                    min_j = j;
+                    min_k = k;
+                }
+            }
+        }
+    }
+
+    *vmin = ptr_loc(a, min_i, min_j, min_k);
+    *vmax = ptr_loc(a, max_i, max_j, max_k);
+}
+
+/* version1_parallel_for.c — thread-private indices, critical-section merge
+ * (or one packed CAS per thread with MINMAX_MERGE_LOCKFREE) */
+void minmax_ptr_parallel_for(int *const *const *a, int M, int N, int P,
+                             MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    /* Global (shared) result indices */
+    int g_min_i = 0, g_min_j = 0, g_min_k = 0;
+    int g_max_i = 0, g_max_j = 0, g_max_k = 0;
+    _Atomic uint64_t k_min = PACKED_EMPTY, k_max = PACKED_EMPTY;
+    int lockfree = minmax_merge_lockfree((long)M * N * P);
+
+    #pragma omp parallel shared(a, M, N, P, g_min_i, g_min_j, g_min_k, g_max_i, g_max_j, g_max_k, k_min, k_max)
+    {
+        /* Thread-private index tracking — avoids data races */
+        int l_min_i = 0, l_min_j = 0, l_min_k = 0;
+        int l_max_i = 0, l_max_j = 0, l_max_k = 0;
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < M; i++) {
+            for (int j = 0; j < N; j++) {
+                for (int k = 0; k < P; k++) {
+                    if (a[i][j][k] > a[l_max_i][l_max_j][l_max_k]) {
+                        l_max_i = i;
+                        l_max_j = j;
+                        l_max_k = k;
+                    }
+                    if (a[i][j][k] < a[l_min_i][l_min_j][l_min_k]) {
+                        l_min_i = i;
+                        l_min_j = j;
+                        l_min_k = k;
+                    }
+                }
+            }
+        }
+
+        /* Merge thread-local results into global results */
+        if (lockfree) {
+            packed_merge(&k_min, packed_min_key(a[l_min_i][l_min_j][l_min_k],
+                                                IDX(l_min_i, l_min_j, l_min_k, N, P)));
+            packed_merge(&k_max, packed_max_key(a[l_max_i][l_max_j][l_max_k],
+                                                IDX(l_max_i, l_max_j, l_max_k, N, P)));
+        } else {
+            #pragma omp critical
+            {
+                if (ptr_beats(a, l_max_i, l_max_j, l_max_k, g_max_i, g_max_j, g_max_k, 0)) {
+                    g_max_i = l_max_i;
+                    g_max_j = l_max_j;
+                    g_max_k = l_max_k;
+                }
+                if (ptr_beats(a, l_min_i, l_min_j, l_min_k, g_min_i, g_min_j, g_min_k, 1)) {
+                    g_min_i = l_min_i;
+                    g_min_j = l_min_j;
+                    g_min_k = l_min_k;
+                }
+            }
+        }
+    }
+
+    if (lockfree) {
+        ValIdx m = packed_min_unpack(k_min), x = packed_max_unpack(k_max);
+        *vmin = loc_from_flat(m.val, m.idx, N, P);
+        *vmax = loc_from_flat(x.val, x.idx, N, P);
+        return;
+    }
+    *vmin = ptr_loc(a, g_min_i, g_min_j, g_min_k);
+    *vmax = ptr_loc(a, g_max_i, g_max_j, g_max_k);
+}
+
+/* version2_sections.c — one section for min, one for max */
+void minmax_ptr_sections(int *const *const *a, int M, int N, int P,
+                         MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    int min_i = 0, min_j = 0, min_k = 0;
+    int max_i = 0, max_j = 0, max_k = 0;
+
+    #pragma omp parallel sections shared(a, M, N, P, min_i, min_j, min_k, max_i, max_j, max_k)
+    {
+        /* Section 1: find minimum */
+        #pragma omp section
+        {
+            for (int i = 0; i < M; i++) {
+                for (int j = 0; j < N; j++) {
+                    for (int k = 0; k < P; k++) {
+                        if (a[i][j][k] < a[min_i][min_j][min_k]) {
+                            min_i = i;
+                            min_j = j;
+                            min_k = k;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* Section 2: find maximum */
+        #pragma omp section
+        {
+            for (int i = 0; i < M; i++) {
+                for (int j = 0; j < N; j++) {
+                    for (int k = 0; k < P; k++) {
+                        if (a[i][j][k] > a[max_i][max_j][max_k]) {
+                            max_i = i;
+                            max_j = j;
+                            max_k = k;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    *vmin = ptr_loc(a, min_i, min_j, min_k);
+    *vmax = ptr_loc(a, max_i, max_j, max_k);
+}
+
+/* version3_combined.c — sections outside, parallel for + named criticals inside
+ * (or packed CAS merges with MINMAX_MERGE_LOCKFREE) */
+void minmax_ptr_combined(int *const *const *a, int M, int N, int P,
+                         MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    int g_min_i = 0, g_min_j = 0, g_min_k = 0;
+    int g_max_i = 0, g_max_j = 0, g_max_k = 0;
+    _Atomic uint64_t k_min = PACKED_EMPTY, k_max = PACKED_EMPTY;
+    int lockfree = minmax_merge_lockfree((long)M * N * P);
+
+    /* Enable nested parallelism for the duration of the call */
+    int saved_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+
+    int total_threads = omp_get_max_threads();
+    int inner_threads = (total_threads > 2) ? total_threads / 2 : 1;
+
+    #pragma omp parallel sections shared(a, M, N, P, g_min_i, g_min_j, g_min_k, g_max_i, g_max_j, g_max_k, k_min, k_max) num_threads(2)
+    {
+        /* Section 1: find minimum using parallel for */
+        #pragma omp section
+        {
+            #pragma omp parallel shared(a, M, N, P, g_min_i, g_min_j, g_min_k, k_min) num_threads(inner_threads)
+            {
+                int l_min_i = 0, l_min_j = 0, l_min_k = 0;
+
+                #pragma omp for schedule(static)
+                for (int i = 0; i < M; i++) {
+                    for (int j = 0; j < N; j++) {
+                        for (int k = 0; k < P; k++) {
+                            if (a[i][j][k] < a[l_min_i][l_min_j][l_min_k]) {
+                                l_min_i = i;
+                                l_min_j = j;
+                                l_min_k = k;
+                            }
+                        }
+                    }
+                }
+
+                if (lockfree) {
+                    packed_merge(&k_min, packed_min_key(a[l_min_i][l_min_j][l_min_k],
+                                                        IDX(l_min_i, l_min_j, l_min_k, N, P)));
+                } else {
+                    #pragma omp critical(min_merge)
+                    {
+                        if (ptr_beats(a, l_min_i, l_min_j, l_min_k, g_min_i, g_min_j, g_min_k, 1)) {
+                            g_min_i = l_min_i;
+                            g_min_j = l_min_j;
+                            g_min_k = l_min_k;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* Section 2: find maximum using parallel for */
+        #pragma omp section
+        {
+            #pragma omp parallel shared(a, M, N, P, g_max_i, g_max_j, g_max_k, k_max) num_threads(inner_threads)
+            {
+                int l_max_i = 0, l_max_j = 0, l_max_k = 0;
+
+                #pragma omp for schedule(static)
+                for (int i = 0; i < M; i++) {
+                    for (int j = 0; j < N; j++) {
+                        for (int k = 0; k < P; k++) {
+                            if (a[i][j][k] > a[l_max_i][l_max_j][l_max_k]) {
+                                l_max_i = i;
+                                l_max_j = j;
+                                l_max_k = k;
+                            }
+                        }
+                    }
+                }
+
+                if (lockfree) {
+                    packed_merge(&k_max, packed_max_key(a[l_max_i][l_max_j][l_max_k],
+                                                        IDX(l_max_i, l_max_j, l_max_k, N, P)));
+                } else {
+                    #pragma omp critical(max_merge)
+                    {
+                        if (ptr_beats(a, l_max_i, l_max_j, l_max_k, g_max_i, g_max_j, g_max_k, 0)) {
+                            g_max_i = l_max_i;
+                            g_max_j = l_max_j;
+                            g_max_k = l_max_k;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    omp_set_max_active_levels(saved_levels);
+
+    if (lockfree) {
+        ValIdx m = packed_min_unpack(k_min), x = packed_max_unpack(k_max);
+        *vmin = loc_from_flat(m.val, m.idx, N, P);
+        *vmax = loc_from_flat(x.val, x.idx, N, P);
+        return;
+    }
+    *vmin = ptr_loc(a, g_min_i, g_min_j, g_min_k);
+    *vmax = ptr_loc(a, g_max_i, g_max_j, g_max_k);
+}
@@ -0,0 +1,319 @@
+/*
+ * Query service: many client threads, one shared read-only volume.
+ *
+ * Clients put requests into a bounded MPMC ring (capacity `queue`). A
+ * full ring blocks the producer, so overload turns into back-pressure,
+ * not unbounded memory. A mutex with two condition variables guards the
+ * ring: a pass costs tens of microseconds at least, so an uncontended
+ * lock per request is noise, and idle workers sleep instead of spinning.
+ *
+ * Each of the `workers` pthreads sets its own OpenMP nthreads ICV to
+ * share = threads / workers before its first pass. Every parallel region
+ * a pass opens (the batch tiles, the zone map's shell scan) then forks at
+ * most `share` threads, and the passes in flight together stay within
+ * `threads` cores. With the kernels called directly, every client would
+ * fork a team of omp_get_max_threads() threads.
+ *
+ * A worker wakes, takes every queued request up to batch_max and releases
+ * the lock. MINMAX requests go to minmax_index_query() when the service
+ * holds a zone map: a full-volume query is a tree walk, and a box only
+ * scans its shell. The others are copied into one array and answered by
+ * a single minmax_query_batch() pass, whose cost follows the bounding box
+ * of the batch rather than the number of queries. Coalescing needs no
+ * timer: at low load a worker finds one request and runs it at once;
+ * under load requests accumulate while the workers are busy, and the
+ * batches grow with the queue.
+ *
+ * Completion is a flag per request plus one broadcast on a separate
+ * mutex, so clients waiting for answers never contend with the queue.
+ */
+#include "minmax_impl.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/* A worker and its batch_max-entry scratch arrays */
+typedef struct {
+    minmax_service  *s;
+    minmax_request **take, **pending;
+    minmax_query    *scratch;
+} ServiceWorker;
+
+struct minmax_service {
+    const int *a;
+    int M, N, P;
+    minmax_index *ix;
+    int threads, share, batch_max;
+
+    /* Ring of pending requests */
+    minmax_request **ring;
+    int cap, head, count;
+    int stop;
+    pthread_mutex_t mu;
+    pthread_cond_t  not_empty, not_full;
+
+    /* Completion */
+    pthread_mutex_t done_mu;
+    pthread_cond_t  done_cv;
+
+    pthread_t     *worker;
+    ServiceWorker *wk;
+    int            nworkers, nalloc;    /* started, with scratch */
+
+    _Atomic long submitted, completed, failed, passes, coalesced, index_hits;
+    double       max_total_us;          /* under done_mu */
+};
+
+/* Free everything but the threads and locks; nw workers' scratch */
+static void service_release(minmax_service *s, int nw)
+{
+    for (int w = 0; s->wk && w < nw; w++) {
+        free(s->wk[w].take);
+        free(s->wk[w].pending);
+        free(s->wk[w].scratch);
+    }
+    minmax_index_free(s->ix);
+    free(s->wk);
+    free(s->ring);
+    free(s->worker);
+    free(s);
+}
+
+static int request_valid(const minmax_service *s, const minmax_query *q)
+{
+    const minmax_box *b = &q->box;
+    return (unsigned)q->kind < MINMAX_QUERY_NUM_KINDS &&
+           b->i0 >= 0 && b->i0 < b->i1 && b->i1 <= s->M &&
+           b->j0 >= 0 && b->j0 < b->j1 && b->j1 <= s->N &&
+           b->k0 >= 0 && b->k0 < b->k1 && b->k1 <= s->P;
+}
+
+/* Answer r[0..n): index lookups one by one, everything else in one pass */
+static void run_pass(minmax_service *s, minmax_request **r, int n, minmax_query *scratch,
+                     minmax_request **pending)
+{
+    int m = 0;
+    for (int x = 0; x < n; x++) {
+        if (s->ix && r[x]->q.kind == MINMAX_QUERY_MINMAX) {
+            double t0 = omp_get_wtime();
+            r[x]->status = minmax_index_query(s->ix, &r[x]->q.box, &r[x]->q.min, &r[x]->q.max);
+            r[x]->run_us = (omp_get_wtime() - t0) * 1e6;
+            r[x]->batch = 1;
+            atomic_fetch_add_explicit(&s->index_hits, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&s->passes, 1, memory_order_relaxed);
+        } else {
+            scratch[m] = r[x]->q;
+            pending[m++] = r[x];
+        }
+    }
+    if (m == 0)
+        return;
+
+    double t0 = omp_get_wtime();
+    int rc = minmax_query_batch(s->a, s->M, s->N, s->P, scratch, m);
+    double run_us = (omp_get_wtime() - t0) * 1e6;
+    for (int x = 0; x < m; x++) {
+        if (rc == 0)
+            pending[x]->q = scratch[x];
+        pending[x]->status = rc;
+        pending[x]->run_us = run_us;
+        pending[x]->batch = m;
+    }
+    atomic_fetch_add_explicit(&s->passes, 1, memory_order_relaxed);
+    if (m > 1)
+        atomic_fetch_add_explicit(&s->coalesced, m, memory_order_relaxed);
+}
+
+static void *service_worker(void *arg)
+{
+    ServiceWorker *wk = (ServiceWorker *)arg;
+    minmax_service *s = wk->s;
+    minmax_request **got = wk->take;
+
+    /* This thread's passes fork at most share threads */
+    omp_set_num_threads(s->share);
+
+    for (;;) {
+        pthread_mutex_lock(&s->mu);
+        while (s->count == 0 && !s->stop)
+            pthread_cond_wait(&s->not_empty, &s->mu);
+        if (s->count == 0) {            /* stopping and drained */
+            pthread_mutex_unlock(&s->mu);
+            break;
+        }
+        int n = s->count < s->batch_max ? s->count : s->batch_max;
+        for (int x = 0; x < n; x++) {
+            got[x] = s->ring[s->head];
+            s->head = (s->head + 1) % s->cap;
+        }
+        s->count -= n;
+        pthread_cond_broadcast(&s->not_full);
+        pthread_mutex_unlock(&s->mu);
+
+        double t_start = omp_get_wtime();
+        for (int x = 0; x < n; x++)
+            got[x]->queue_us = (t_start - got[x]->submit_) * 1e6;
+
+        run_pass(s, got, n, wk->scratch, wk->pending);
+
+        double t_done = omp_get_wtime();
+        pthread_mutex_lock(&s->done_mu);
+        for (int x = 0; x < n; x++) {
+            got[x]->threads = s->share;
+            got[x]->total_us = (t_done - got[x]->submit_) * 1e6;
+            if (got[x]->total_us > s->max_total_us)
+                s->max_total_us = got[x]->total_us;
+            if (got[x]->status != 0)
+                atomic_fetch_add_explicit(&s->failed, 1, memory_order_relaxed);
+            got[x]->done_ = 1;
+        }
+        atomic_fetch_add_explicit(&s->completed, n, memory_order_relaxed);
+        pthread_cond_broadcast(&s->done_cv);
+        pthread_mutex_unlock(&s->done_mu);
+    }
+    return NULL;
+}
+
+minmax_service *minmax_service_create(const int *a, int M, int N, int P,
+                                      const minmax_service_config *cfg)
+{
+    if (!a || M <= 0 || N <= 0 || P <= 0)
+        return NULL;
+    minmax_service_config c = cfg ? *cfg : (minmax_service_config){ 0 };
+    if (c.threads <= 0)
+        c.threads = omp_get_num_procs();
+    if (c.workers <= 0)
+        c.workers = c.threads / 4 > 1 ? c.threads / 4 : 1;
+    if (c.workers > c.threads)
+        c.workers = c.threads;
+    if (c.queue <= 0)
+        c.queue = MINMAX_SERVICE_DEFAULT_QUEUE;
+    if (c.batch_max <= 0)
+        c.batch_max = MINMAX_SERVICE_DEFAULT_BATCH;
+
+    minmax_service *s = calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->a = a;
+    s->M = M; s->N = N; s->P = P;
+    s->threads = c.threads;
+    s->share = c.threads / c.workers;
+    s->batch_max = c.batch_max;
+    s->cap = c.queue;
+    s->ring = malloc((size_t)s->cap * sizeof(*s->ring));
+    s->worker = malloc((size_t)c.workers * sizeof(pthread_t));
+    s->wk = calloc((size_t)c.workers, sizeof(ServiceWorker));
+    int ok = s->ring && s->worker && s->wk;
+    for (int w = 0; ok && w < c.workers; w++) {
+        s->wk[w].s = s;
+        s->wk[w].take = malloc((size_t)c.batch_max * sizeof(minmax_request *));
+        s->wk[w].pending = malloc((size_t)c.batch_max * sizeof(minmax_request *));
+        s->wk[w].scratch = malloc((size_t)c.batch_max * sizeof(minmax_query));
+        ok = s->wk[w].take && s->wk[w].pending && s->wk[w].scratch;
+    }
+    if (ok && c.index)
+        ok = (s->ix = minmax_index_build(a, M, N, P)) != NULL;
+    if (!ok) {
+        service_release(s, c.workers);
+        return NULL;
+    }
+
+    pthread_mutex_init(&s->mu, NULL);
+    pthread_cond_init(&s->not_empty, NULL);
+    pthread_cond_init(&s->not_full, NULL);
+    pthread_mutex_init(&s->done_mu, NULL);
+    pthread_cond_init(&s->done_cv, NULL);
+
+    s->nalloc = c.workers;
+    for (int w = 0; w < c.workers; w++) {
+        if (pthread_create(&s->worker[w], NULL, service_worker, &s->wk[w]) != 0)
+            break;
+        s->nworkers++;
+    }
+    /* share was sized for every worker: with fewer, part of the thread
+     * budget would sit idle and the stats would be wrong */
+    if (s->nworkers < c.workers) {
+        minmax_service_free(s);
+        return NULL;
+    }
+    return s;
+}
+
+void minmax_service_free(minmax_service *s)
+{
+    if (!s)
+        return;
+    pthread_mutex_lock(&s->mu);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->not_empty);
+    pthread_cond_broadcast(&s->not_full);
+    pthread_mutex_unlock(&s->mu);
+    for (int w = 0; w < s->nworkers; w++)
+        pthread_join(s->worker[w], NULL);
+
+    pthread_mutex_destroy(&s->mu);
+    pthread_cond_destroy(&s->not_empty);
+    pthread_cond_destroy(&s->not_full);
+    pthread_mutex_destroy(&s->done_mu);
+    pthread_cond_destroy(&s->done_cv);
+    service_release(s, s->nalloc);
+}
+
+int minmax_service_submit(minmax_service *s, minmax_request *r)
+{
+    if (!s || !r || !request_valid(s, &r->q))
+        return -1;
+    r->done_ = 0;
+    r->status = 0;
+    r->batch = 0;
+    r->submit_ = omp_get_wtime();
+
+    pthread_mutex_lock(&s->mu);
+    while (s->count == s->cap && !s->stop)
+        pthread_cond_wait(&s->not_full, &s->mu);
+    if (s->stop) {
+        pthread_mutex_unlock(&s->mu);
+        return -1;
+    }
+    s->ring[(s->head + s->count) % s->cap] = r;
+    s->count++;
+    pthread_cond_signal(&s->not_empty);
+    pthread_mutex_unlock(&s->mu);
+    atomic_fetch_add_explicit(&s->submitted, 1, memory_order_relaxed);
+    return 0;
+}
+
+int minmax_service_wait(minmax_service *s, minmax_request *r)
+{
+    if (!s || !r)
+        return -1;
+    pthread_mutex_lock(&s->done_mu);
+    while (!r->done_)
+        pthread_cond_wait(&s->done_cv, &s->done_mu);
+    pthread_mutex_unlock(&s->done_mu);
+    return r->status;
+}
+
+int minmax_service_query(minmax_service *s, minmax_request *r)
+{
+    if (minmax_service_submit(s, r) != 0)
+        return -1;
+    return minmax_service_wait(s, r);
+}
+
+void minmax_service_get_stats(minmax_service *s, minmax_service_stats *st)
+{
+    if (!s || !st)
+        return;
+    st->submitted  = atomic_load(&s->submitted);
+    st->completed  = atomic_load(&s->completed);
+    st->failed     = atomic_load(&s->failed);
+    st->passes     = atomic_load(&s->passes);
+    st->coalesced  = atomic_load(&s->coalesced);
+    st->index_hits = atomic_load(&s->index_hits);
+    pthread_mutex_lock(&s->done_mu);
+    st->max_total_us = s->max_total_us;
+    pthread_mutex_unlock(&s->done_mu);
+    st->threads = s->threads;
+    st->workers = s->nworkers;
+    st->share   = s->share;
+}
@@ -0,0 +1,53 @@
+/*
+ * novel_simd_avx2.c — each thread runs the dispatched SIMD kernel
+ * (lib/scan_*.c) over one contiguous chunk, then a critical section merges
+ * the per-thread winners (or one packed CAS per thread with
+ * MINMAX_MERGE_LOCKFREE).
+ */
+#include "minmax_impl.h"
+
+void minmax_simd(const int *a, int M, int N, int P,
+                 MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    long total = (long)M * N * P;
+    const ScanKernels *sk = scan_kernels();
+
+    ValIdx gmin = { INT_MAX, 0 };
+    ValIdx gmax = { INT_MIN, 0 };
+    _Atomic uint64_t kmin = PACKED_EMPTY, kmax = PACKED_EMPTY;
+    int lockfree = minmax_merge_lockfree(total);
+
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+        int nt  = omp_get_num_threads();
+        long chunk = total / nt;
+        long lo = tid * chunk;
+        long hi = (tid == nt - 1) ? total : lo + chunk;
+
+        /* Each thread SIMDs through its chunk */
+        ValIdx lmin = { INT_MAX, lo };
+        ValIdx lmax = { INT_MIN, lo };
+        sk->minmax(a, lo, hi, &lmin, &lmax);
+
+        /* Ties go to the lower index so the result never depends on which
+         * thread reaches the critical section first */
+        if (lockfree) {
+            packed_merge(&kmin, packed_min_key(lmin.val, lmin.idx));
+            packed_merge(&kmax, packed_max_key(lmax.val, lmax.idx));
+        } else {
+            #pragma omp critical
+            {
+                if (lmin.val < gmin.val || (lmin.val == gmin.val && lmin.idx < gmin.idx)) gmin = lmin;
+                if (lmax.val > gmax.val || (lmax.val == gmax.val && lmax.idx < gmax.idx)) gmax = lmax;
+            }
+        }
+    }
+    if (lockfree) {
+        gmin = packed_min_unpack(kmin);
+        gmax = packed_max_unpack(kmax);
+    }
+
+    *vmin = loc_from_flat(gmin.val, gmin.idx, N, P);
+    *vmax = loc_from_flat(gmax.val, gmax.idx, N, P);
+}
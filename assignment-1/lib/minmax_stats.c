@@ -0,0 +1,195 @@
+/*
+ * Fused statistics: min/max with location, exact int64 sum, mean,
+ * variance and an optional histogram in one pass over memory.
+ *
+ * The scan is bandwidth-bound, so the extra arithmetic is close to free as
+ * long as it runs on data that is already in cache. Each thread walks its
+ * static share of the flat range in STATS_BLOCK-element blocks (16 KB, L1
+ * resident): the dispatched SIMD kernel takes the extremes as the block is
+ * loaded, then one vectorised loop over the cached block accumulates the
+ * shifted sums S1 = sum(x - K) and S2 = sum((x - K)^2) in double, and
+ * the histogram loop, if requested, bins the same cached block.
+ *
+ * K is the thread's running mean (the block's first element for the first
+ * block), so S2 - S1^2/n does not cancel badly; |x - K| < 2^32 and a block
+ * has 2^12 elements, so S1 is an exact integer in double and the int64 sum
+ * is recovered exactly as K*n + S1. Blocks and threads are combined with
+ * the Chan et al. pairwise update of (n, mean, M2), which is stable for any
+ * number of elements.
+ */
+#include "minmax_impl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STATS_BLOCK        4096
+#define STATS_PARALLEL_MIN (1L << 16)
+
+typedef struct {
+    ValIdx    min, max;
+    long      n;
+    long long sum;
+    double    mean, m2;
+} __attribute__((aligned(64))) StatsPart;
+
+/* Fold (n, mean, m2) of another partition into p (Chan et al.) */
+static void moments_merge(StatsPart *p, long n, double mean, double m2)
+{
+    if (n == 0)
+        return;
+    long   tot   = p->n + n;
+    double delta = mean - p->mean;
+    p->mean += delta * ((double)n / tot);
+    p->m2   += m2 + delta * delta * ((double)p->n * n / tot);
+    p->n     = tot;
+}
+
+/*
+ * Bin of offset off = v - lo is floor(off * nbins / range). The division
+ * is replaced by a multiply-shift: with m = floor(2^s * nbins / range) + 1,
+ * (off * m) >> s is exact for every off < range as long as range^2 <= 2^s,
+ * and off * m fits in 64 bits as long as nbins * 2^s + range < 2^64. Windows too
+ * wide for that (range above ~2^20 with many bins) fall back to dividing.
+ */
+typedef struct {
+    unsigned long lo;       /* h->lo as the offset origin (wraps like v - lo) */
+    unsigned long range;
+    unsigned long m;
+    int           shift;    /* 0: divide                                    */
+    int           nbins;
+} HistMap;
+
+static HistMap hist_map(const minmax_hist *h)
+{
+    HistMap hm = { (unsigned long)(long)h->lo, (unsigned long)((long)h->hi - h->lo + 1),
+                   0, 0, h->nbins };
+    unsigned __int128 r2 = (unsigned __int128)hm.range * hm.range;
+    int s = 1;
+    while (s < 63 && r2 > (unsigned __int128)1 << s)
+        s++;
+    if (r2 <= (unsigned __int128)1 << s &&
+        ((unsigned __int128)h->nbins << s) + hm.range <= ~0UL) {
+        hm.shift = s;
+        hm.m = (unsigned long)(((unsigned __int128)h->nbins << s) / hm.range) + 1;
+    }
+    return hm;
+}
+
+static void hist_block(const int *a, long lo, long hi, const HistMap *hm,
+                       long *bins, long *below, long *above)
+{
+    long nb = 0, na = 0;
+    for (long x = lo; x < hi; x++) {
+        /* one unsigned compare sorts v into below / inside / above */
+        unsigned long off = (unsigned long)(long)a[x] - hm->lo;
+        if (off < hm->range) {
+            unsigned long b = hm->shift ? (off * hm->m) >> hm->shift
+                                        : off * hm->nbins / hm->range;
+            bins[b]++;
+        } else if ((long)a[x] < (long)hm->lo) {
+            nb++;
+        } else {
+            na++;
+        }
+    }
+    *below += nb;
+    *above += na;
+}
+
+static void stats_range(const ScanKernels *sk, const int *a, long lo, long hi,
+                        const HistMap *h, long *bins, long *below, long *above,
+                        StatsPart *p)
+{
+    for (long b0 = lo; b0 < hi; b0 += STATS_BLOCK) {
+        long b1 = b0 + STATS_BLOCK < hi ? b0 + STATS_BLOCK : hi;
+        long len = b1 - b0;
+
+        sk->minmax(a, b0, b1, &p->min, &p->max);
+
+        double k  = p->n ? nearbyint(p->mean) : (double)a[b0];
+        double s1 = 0, s2 = 0;
+        #pragma omp simd reduction(+ : s1, s2)
+        for (long x = b0; x < b1; x++) {
+            double d = (double)a[x] - k;
+            s1 += d;
+            s2 += d * d;
+        }
+        p->sum += (long long)k * len + (long long)s1;
+        moments_merge(p, len, k + s1 / len, s2 - s1 * s1 / len);
+
+        if (h)
+            hist_block(a, b0, b1, h, bins, below, above);
+    }
+}
+
+int minmax_stats_3d(const int *a, int M, int N, int P, minmax_stats *st, minmax_hist *h)
+{
+    if (!a || !st || M <= 0 || N <= 0 || P <= 0)
+        return -1;
+    if (h && (h->nbins <= 0 || h->nbins > MINMAX_HIST_MAX_BINS || !h->bins || h->lo > h->hi))
+        return -1;
+
+    long n = (long)M * N * P;
+    const ScanKernels *sk = scan_kernels();
+    int T = n >= STATS_PARALLEL_MIN ? omp_get_max_threads() : 1;
+
+    /* Per-thread histograms, each starting on its own cache line */
+    long hstride = h ? ((long)h->nbins + 2 + 7) & ~7L : 0;
+    StatsPart *part = aligned_alloc(64, (size_t)T * sizeof(StatsPart));
+    long *hp = h ? aligned_alloc(64, (size_t)T * hstride * sizeof(long)) : NULL;
+    if (!part || (h && !hp)) {
+        free(part);
+        free(hp);
+        return -1;
+    }
+    if (hp)
+        memset(hp, 0, (size_t)T * hstride * sizeof(long));
+
+    #pragma omp parallel num_threads(T)
+    {
+        int t = omp_get_thread_num(), nt = omp_get_num_threads();
+        long lo = n / nt * t + n % nt * t / nt;
+        long hi = n / nt * (t + 1) + n % nt * (t + 1) / nt;
+        StatsPart p = { { INT_MAX, lo }, { INT_MIN, lo }, 0, 0, 0.0, 0.0 };
+        long *bins = hp ? hp + t * hstride : NULL;
+        HistMap hm = h ? hist_map(h) : (HistMap){ 0 };
+        if (lo < hi)
+            stats_range(sk, a, lo, hi, h ? &hm : NULL, bins, bins ? bins + h->nbins : NULL,
+                        bins ? bins + h->nbins + 1 : NULL, &p);
+        part[t] = p;
+        if (nt < T && t == 0)
+            for (int x = nt; x < T; x++)
+                part[x] = (StatsPart){ { INT_MAX, LONG_MAX }, { INT_MIN, LONG_MAX }, 0, 0, 0.0, 0.0 };
+    }
+
+    StatsPart r = part[0];
+    for (int t = 1; t < T; t++) {
+        valmin_combine(&r.min, &part[t].min);
+        valmax_combine(&r.max, &part[t].max);
+        r.sum += part[t].sum;
+        moments_merge(&r, part[t].n, part[t].mean, part[t].m2);
+    }
+
+    if (h) {
+        memset(h->bins, 0, (size_t)h->nbins * sizeof(long));
+        h->below = h->above = 0;
+        for (int t = 0; t < T; t++) {
+            const long *b = hp + t * hstride;
+            for (int x = 0; x < h->nbins; x++)
+                h->bins[x] += b[x];
+            h->below += b[h->nbins];
+            h->above += b[h->nbins + 1];
+        }
+    }
+
+    st->min      = loc_from_flat(r.min.val, r.min.idx, N, P);
+    st->max      = loc_from_flat(r.max.val, r.max.idx, N, P);
+    st->count    = r.n;
+    st->sum      = r.sum;
+    st->mean     = r.mean;
+    st->variance = r.m2 / r.n;
+
+    free(part);
+    free(hp);
+    return 0;
+}
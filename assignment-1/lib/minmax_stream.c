@@ -0,0 +1,100 @@
+/*
+ * novel_stream — a scan shaped for the DRAM bandwidth ceiling.
+ *
+ * At high thread counts a full scan should be limited only by memory, yet
+ * the ultimate strategy leaves bandwidth unused: its tiles cut rows into
+ * segments, it prefetches one row ahead at most, and each kernel call
+ * folds into a single dependency chain per lane (compare, then blend the
+ * value the next compare needs). Here every thread takes one contiguous
+ * range, rounded to 64 B so no cache line is shared by two threads, and
+ * runs the streaming kernel of scan.h over it in one call: four
+ * accumulator sets, software prefetch a configurable distance ahead and
+ * optional non-temporal loads. The per-thread winners are combined by the
+ * valmin/valmax reductions, which keep the lowest index on ties.
+ *
+ * MOVNTDQA is only a hint on ordinary write-back memory (most cores treat
+ * it as a normal load); the NTA prefetches that accompany it are what
+ * keeps the scanned data from evicting everything else from the cache.
+ * They also bypass L2 on many cores, so the L2 streamer no longer runs
+ * ahead of the loads; on a single thread they lose ~20%, which is why
+ * non-temporal mode is opt-in. It pays off when the scan shares the
+ * cache with work whose data should stay resident.
+ */
+#include "minmax_impl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Elements per cache line: thread ranges start on line boundaries */
+#define STREAM_LINE_ELEMS (64 / (long)sizeof(int))
+
+static minmax_stream_params stream_params = { MINMAX_STREAM_PREFETCH_DEFAULT, 0 };
+
+__attribute__((constructor))
+static void stream_select(void)
+{
+    const char *env = getenv("MINMAX_PREFETCH");
+    if (env && *env) {
+        char *end;
+        long d = strtol(env, &end, 10);
+        if (*end == '\0' && d >= 0)
+            stream_params.prefetch_bytes = d;
+        else
+            fprintf(stderr, "MINMAX_PREFETCH=%s is not a byte count, using %ld\n",
+                    env, stream_params.prefetch_bytes);
+    }
+    env = getenv("MINMAX_NT");
+    if (env && *env) {
+        if (strcmp(env, "0") == 0 || strcmp(env, "1") == 0)
+            stream_params.nontemporal = env[0] == '1';
+        else
+            fprintf(stderr, "MINMAX_NT=%s is not 0 or 1, using %d\n",
+                    env, stream_params.nontemporal);
+    }
+}
+
+int minmax_set_stream(const minmax_stream_params *p)
+{
+    if (!p || p->prefetch_bytes < 0)
+        return -1;
+    stream_params = (minmax_stream_params){ p->prefetch_bytes, p->nontemporal != 0 };
+    return 0;
+}
+
+void minmax_get_stream(minmax_stream_params *p)
+{
+    if (p)
+        *p = stream_params;
+}
+
+void minmax_stream(const int *a, int M, int N, int P,
+                   MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    long total = (long)M * N * P;
+    const ScanKernels *sk = scan_kernels();
+    long prefetch = stream_params.prefetch_bytes;
+    int nt = stream_params.nontemporal;
+
+    /* Elements between the line boundary before a[0] and a[0], so the cut
+     * points below are line-aligned in memory, not just in index space */
+    long skew = (long)(((uintptr_t)a & 63) / sizeof(int));
+
+    ValIdx gmin = { INT_MAX, LONG_MAX }, gmax = { INT_MIN, LONG_MAX };
+
+    #pragma omp parallel reduction(valmin : gmin) reduction(valmax : gmax)
+    {
+        int tid = omp_get_thread_num();
+        int nth = omp_get_num_threads();
+        long lines = (total + skew + STREAM_LINE_ELEMS - 1) / STREAM_LINE_ELEMS;
+        long lo = lines * tid / nth * STREAM_LINE_ELEMS - skew;
+        long hi = lines * (tid + 1) / nth * STREAM_LINE_ELEMS - skew;
+        if (lo < 0) lo = 0;
+        if (hi > total) hi = total;
+
+        if (lo < hi)
+            sk->stream(a, lo, hi, prefetch, nt, &gmin, &gmax);
+    }
+
+    *vmin = loc_from_validx(&gmin, 0, N, P);
+    *vmax = loc_from_validx(&gmax, 0, N, P);
+}
@@ -0,0 +1,94 @@
+/*
+ * novel_tasks.c — recursive task divide & conquer over the work-stealing
+ * scheduler, with final() stopping the recursion at the leaf cut-off.
+ *
+ * Min and max are found by one fused task tree: each leaf runs the
+ * dispatched SIMD kernel once and returns both winners, so the array is
+ * streamed a single time (two separate trees read all of it twice, and the
+ * scan is bandwidth-bound).
+ *
+ * Two cut-off policies:
+ *   MINMAX_TASKS          — fixed leaf size, the tuning table's task_leaf
+ *                           (65536 by default)
+ *   MINMAX_TASKS_ADAPTIVE — total / (threads * TASK_LEAVES_PER_THREAD), so
+ *                           every thread has a few leaves to steal whatever
+ *                           the array size, without drowning small inputs
+ *                           in task overhead
+ */
+#include "minmax_impl.h"
+
+/* Adaptive policy: leaves per thread (stealing slack) and the smallest leaf
+ * worth a task (below this the spawn cost is comparable to the scan) */
+#define TASK_LEAVES_PER_THREAD 16
+#define TASK_MIN_LEAF          8192
+
+typedef ValIdx FlatResult;
+
+typedef struct { FlatResult min, max; } FlatMinMax;
+
+static FlatMinMax task_find_minmax(const ScanKernels *sk, const int *a,
+                                   long lo, long hi, long cutoff)
+{
+    if (hi - lo <= cutoff) {
+        FlatMinMax r = { { INT_MAX, lo }, { INT_MIN, lo } };
+        sk->minmax(a, lo, hi, &r.min, &r.max);
+        return r;
+    }
+
+    long mid = lo + (hi - lo) / 2;
+    FlatMinMax left, right;
+
+    #pragma omp task shared(left) firstprivate(sk, a, lo, mid, cutoff) \
+                     final((mid - lo) <= cutoff)
+    left = task_find_minmax(sk, a, lo, mid, cutoff);
+
+    #pragma omp task shared(right) firstprivate(sk, a, mid, hi, cutoff) \
+                     final((hi - mid) <= cutoff)
+    right = task_find_minmax(sk, a, mid, hi, cutoff);
+
+    #pragma omp taskwait
+
+    /* Left half holds the lower indices, so it wins ties */
+    FlatMinMax r;
+    r.min = (right.min.val < left.min.val) ? right.min : left.min;
+    r.max = (right.max.val > left.max.val) ? right.max : left.max;
+    return r;
+}
+
+static void tasks_run(const int *a, int M, int N, int P, long cutoff,
+                      MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    long total = (long)M * N * P;
+    const ScanKernels *sk = scan_kernels();
+
+    FlatMinMax g;
+
+    #pragma omp parallel
+    {
+        #pragma omp single
+        g = task_find_minmax(sk, a, 0, total, cutoff);
+        /* Implicit barrier at end of single */
+    }
+
+    *vmin = loc_from_flat(g.min.val, g.min.idx, N, P);
+    *vmax = loc_from_flat(g.max.val, g.max.idx, N, P);
+}
+
+void minmax_tasks(const int *a, int M, int N, int P,
+                  MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    tasks_run(a, M, N, P, minmax_tuning_active(M, N, P)->task_leaf, vmin, vmax);
+}
+
+void minmax_tasks_adaptive(const int *a, int M, int N, int P,
+                           MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    long total  = (long)M * N * P;
+    long leaves = (long)omp_get_max_threads() * TASK_LEAVES_PER_THREAD;
+    long cutoff = (total + leaves - 1) / leaves;
+
+    if (cutoff < TASK_MIN_LEAF)
+        cutoff = TASK_MIN_LEAF;
+
+    tasks_run(a, M, N, P, cutoff, vmin, vmax);
+}
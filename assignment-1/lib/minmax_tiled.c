@@ -0,0 +1,238 @@
+/*
+ * novel_tiled.c and novel_ultimate.c — L2-sized tiles distributed with
+ * collapse, one-row-ahead software prefetch, and a single pass for min and
+ * max. The tile is TILE_I x TILE_J x P for the default shape and adapts to
+ * others (see minmax_tile_shape()). The ultimate variant hands each row to the
+ * dispatched SIMD kernel instead of the scalar loop.
+ *
+ * Tile working set, tiles per thread, the ultimate prefetch distance and
+ * the loop schedule come from the tuning table (minmax_tune.c).
+ */
+#include "minmax_impl.h"
+
+/* Tile sizes tuned for L2 cache (~256 KB = 64K ints)
+ * TILE_I * TILE_J * P = 8 * 8 * 500 = 32,000 ints = 125 KB => fits in L2 */
+#define TILE_I 8
+#define TILE_J 8
+
+/*
+ * Pick a TI x TJ x TK tile for this shape. For the default 500^3 and the
+ * default 32K-element target this is the tuned 8 x 8 x P. Rows shorter
+ * than the target allows widen the tile along j (contiguous in memory)
+ * and then i until it is back near t->tile_target; rows longer than the
+ * target are split along k so a single long row (1 x 1 x 2^30) still
+ * yields many tiles. Finally tiles are halved until every thread gets
+ * t->tiles_per_thread of them, so small or skewed shapes do not leave
+ * threads idle.
+ */
+void minmax_tile_shape(int M, int N, int P, const minmax_tuning *t, int *ti, int *tj, int *tk)
+{
+    long target = t->tile_target;
+    long rows = target / P;         /* whole P-rows that fit the target */
+    long ti_ = 1, tj_ = 1, tk_ = P;
+
+    if (rows == 0) {
+        tk_ = target;
+    } else if (rows < TILE_I * TILE_J) {
+        tj_ = rows;
+    } else {
+        tj_ = rows / TILE_I > TILE_J ? rows / TILE_I : TILE_J;
+        if (tj_ > N) tj_ = N;
+        ti_ = rows / tj_;
+    }
+    if (ti_ > M) ti_ = M;
+    if (tj_ > N) tj_ = N;
+
+    long want = (long)omp_get_max_threads() * t->tiles_per_thread;
+    for (;;) {
+        long ntiles = ((M + ti_ - 1) / ti_) * ((N + tj_ - 1) / tj_) * ((P + tk_ - 1) / tk_);
+        if (ntiles >= want) break;
+        if (ti_ > 1)        ti_ = (ti_ + 1) / 2;
+        else if (tj_ > 1)   tj_ = (tj_ + 1) / 2;
+        else if (tk_ > 256) tk_ = ((tk_ / 2) + 15) & ~15L;   /* keep SIMD-friendly */
+        else break;
+    }
+
+    *ti = (int)ti_;
+    *tj = (int)tj_;
+    *tk = (int)tk_;
+}
+
+void minmax_tiled(const int *a, int M, int N, int P,
+                  MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    MinMaxLoc vmin = { .val = INT_MAX, .i = 0, .j = 0, .k = 0 };
+    MinMaxLoc vmax = { .val = INT_MIN, .i = 0, .j = 0, .k = 0 };
+
+    const minmax_tuning *tn = minmax_tuning_active(M, N, P);
+    int tile_i, tile_j, tile_k;
+    minmax_tile_shape(M, N, P, tn, &tile_i, &tile_j, &tile_k);
+
+    int ni_tiles = (M + tile_i - 1) / tile_i;
+    int nj_tiles = (N + tile_j - 1) / tile_j;
+    int nk_tiles = (P + tile_k - 1) / tile_k;
+
+    minmax_sched_saved saved = minmax_schedule_apply(tn);
+    #pragma omp parallel for collapse(3) schedule(runtime) \
+            reduction(minloc : vmin) reduction(maxloc : vmax)
+    for (int ti = 0; ti < ni_tiles; ti++) {
+        for (int tj = 0; tj < nj_tiles; tj++) {
+            for (int tk = 0; tk < nk_tiles; tk++) {
+                int i_start = ti * tile_i;
+                int i_end   = (i_start + tile_i < M) ? i_start + tile_i : M;
+                int j_start = tj * tile_j;
+                int j_end   = (j_start + tile_j < N) ? j_start + tile_j : N;
+                int k_start = tk * tile_k;
+                int k_end   = (k_start + tile_k < P) ? k_start + tile_k : P;
+
+                /* Row-major within the tile is flat order, so strict
+                 * compares keep the first tie; tiles are not visited in
+                 * flat order, so they are merged with the combiners.
+                 * Seeded with the tile's first element. */
+                MinMaxLoc tmin = { a[IDX(i_start, j_start, k_start, N, P)], i_start, j_start, k_start };
+                MinMaxLoc tmax = tmin;
+
+                for (int i = i_start; i < i_end; i++) {
+                    for (int j = j_start; j < j_end; j++) {
+                        /* Prefetch next row's data while processing current row */
+                        if (j + 1 < j_end)
+                            __builtin_prefetch(&a[IDX(i, j + 1, k_start, N, P)], 0, 1);
+                        else if (i + 1 < i_end)
+                            __builtin_prefetch(&a[IDX(i + 1, j_start, k_start, N, P)], 0, 1);
+
+                        for (int k = k_start; k < k_end; k++) {
+                            int val = a[IDX(i, j, k, N, P)];
+                            if (val < tmin.val) {
+                                tmin.val = val;
+                                tmin.i = i;
+                                tmin.j = j;
+                                tmin.k = k;
+                            }
+                            if (val > tmax.val) {
+                                tmax.val = val;
+                                tmax.i = i;
+                                tmax.j = j;
+                                tmax.k = k;
+                            }
+                        }
+                    }
+                }
+                minloc_combine(&vmin, &tmin);
+                maxloc_combine(&vmax, &tmax);
+            }
+        }
+    }
+    minmax_schedule_restore(saved);
+
+    *out_min = vmin;
+    *out_max = vmax;
+}
+
+/*
+ * Tiled SIMD scan of the box [i0,i1) x [j0,j1) x [k0,k1) of a parent
+ * a[.][N][P]. Tiles are laid over the box, not the parent, and every run
+ * is addressed in parent coordinates, so a sub-volume is scanned in place
+ * and the winners come back as parent positions. A run is only merged
+ * across rows (or planes) when the box spans the full parent row (or
+ * plane); otherwise each row segment is its own run and the kernel's tail
+ * handles the ragged k edge. Boxes below ULTIMATE_PARALLEL_MIN elements
+ * are scanned by the calling thread: spinning up the team would cost more
+ * than the scan.
+ */
+#define ULTIMATE_PARALLEL_MIN (1L << 16)
+
+/* Longest partial-row segment prefetched line by line (longer ones stream
+ * well enough on their own); the look-ahead is t->prefetch_rows */
+#define SEG_PREFETCH_MAX  1024
+
+static inline void prefetch_segment(const int *p, int len)
+{
+    if (len > SEG_PREFETCH_MAX) len = 16;
+    for (int o = 0; o < len; o += 16)
+        __builtin_prefetch(p + o, 0, 1);
+}
+
+void minmax_ultimate_box(const int *a, int N, int P,
+                         int i0, int i1, int j0, int j1, int k0, int k1,
+                         MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    /* Seeded with the box's first element: an identity at (0, 0, 0) would
+     * be reported, outside the box, when every value equals INT_MAX
+     * (resp. INT_MIN) */
+    MinMaxLoc vmin = { a[IDX(i0, j0, k0, N, P)], i0, j0, k0 };
+    MinMaxLoc vmax = vmin;
+
+    const ScanKernels *sk = scan_kernels();
+
+    int bm = i1 - i0, bn = j1 - j0, bp = k1 - k0;
+    const minmax_tuning *tn = minmax_tuning_active(bm, bn, bp);
+    int ahead = tn->prefetch_rows;
+    int tile_i, tile_j, tile_k;
+    minmax_tile_shape(bm, bn, bp, tn, &tile_i, &tile_j, &tile_k);
+
+    int ni_tiles = (bm + tile_i - 1) / tile_i;
+    int nj_tiles = (bn + tile_j - 1) / tile_j;
+    int nk_tiles = (bp + tile_k - 1) / tile_k;
+    long elems = (long)bm * bn * bp;
+
+    minmax_sched_saved saved = minmax_schedule_apply(tn);
+    #pragma omp parallel for collapse(3) schedule(runtime) if (elems >= ULTIMATE_PARALLEL_MIN) \
+            reduction(minloc_seeded : vmin) reduction(maxloc_seeded : vmax)
+    for (int ti = 0; ti < ni_tiles; ti++) {
+        for (int tj = 0; tj < nj_tiles; tj++) {
+            for (int tk = 0; tk < nk_tiles; tk++) {
+                int i_start = i0 + ti * tile_i;
+                int i_end   = (i_start + tile_i < i1) ? i_start + tile_i : i1;
+                int j_start = j0 + tj * tile_j;
+                int j_end   = (j_start + tile_j < j1) ? j_start + tile_j : j1;
+                int k_start = k0 + tk * tile_k;
+                int k_end   = (k_start + tile_k < k1) ? k_start + tile_k : k1;
+
+                int full_rows   = (k_start == 0 && k_end == P);
+                int full_planes = full_rows && j_start == 0 && j_end == N;
+
+                if (full_planes) {
+                    /* Whole i-planes: the tile is one contiguous run */
+                    simd_scan_run(sk, a, IDX(i_start, 0, 0, N, P),
+                                  (long)(i_end - i_start) * N * P, &vmin, &vmax, N, P);
+                    continue;
+                }
+
+                for (int i = i_start; i < i_end; i++) {
+                    if (full_rows) {
+                        /* Rows j_start..j_end of plane i are contiguous */
+                        if (ahead && i + 1 < i_end)
+                            __builtin_prefetch(&a[IDX(i + 1, j_start, 0, N, P)], 0, 1);
+                        simd_scan_run(sk, a, IDX(i, j_start, 0, N, P),
+                                      (long)(j_end - j_start) * P, &vmin, &vmax, N, P);
+                        continue;
+                    }
+
+                    for (int j = j_start; j < j_end; j++) {
+                        /* Row segments are not contiguous, so the hardware
+                         * prefetcher cannot run ahead: fetch every line of
+                         * the segment `ahead` rows ahead */
+                        int pj = j + ahead, pi = i;
+                        while (pj >= j_end) { pj -= j_end - j_start; pi++; }
+                        if (ahead && pi < i_end)
+                            prefetch_segment(&a[IDX(pi, pj, k_start, N, P)], k_end - k_start);
+
+                        /* SIMD scan this row segment for both min and max */
+                        simd_scan_run(sk, a, IDX(i, j, k_start, N, P), k_end - k_start,
+                                      &vmin, &vmax, N, P);
+                    }
+                }
+            }
+        }
+    }
+    minmax_schedule_restore(saved);
+
+    *out_min = vmin;
+    *out_max = vmax;
+}
+
+void minmax_ultimate(const int *a, int M, int N, int P,
+                     MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    minmax_ultimate_box(a, N, P, 0, M, 0, N, 0, P, out_min, out_max);
+}
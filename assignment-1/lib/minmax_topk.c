@@ -0,0 +1,183 @@
+/*
+ * Top-K smallest and largest values with locations, in one pass.
+ *
+ * Each thread scans one contiguous chunk and keeps two bounded heaps of K
+ * entries whose roots are the current K-th smallest / K-th largest. Almost
+ * every element loses to both roots, so the chunk is read in TOPK_BLOCK
+ * runs through a branch-free "anything beats a root?" test that the
+ * compiler vectorises (omp simd reduction); only runs that contain a
+ * candidate are walked element by element into the heaps. On random data
+ * that is a handful of runs per thread once the heaps are warm, so the scan
+ * streams at the same bandwidth as the single-extreme kernels.
+ *
+ * The per-thread heaps are sorted and then merged pairwise in log2(T)
+ * rounds (thread t absorbs t + s), a tree like the minloc/maxloc declare
+ * reductions. Order is (value, then lower flat index), so ties resolve to
+ * the first positions exactly as in minmax_loc_3d().
+ */
+#include "minmax_impl.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TOPK_BLOCK 256
+
+typedef struct {
+    ValIdx *min, *max;      /* heaps, then sorted best-first */
+    int nmin, nmax;
+    ValIdx *tmp;            /* merge scratch */
+} TopKPart;
+
+/* x ranks ahead of y in the output (smaller / larger value, then lower index) */
+static inline int ranks_before(const ValIdx *x, const ValIdx *y, int find_min)
+{
+    if (x->val != y->val)
+        return find_min ? x->val < y->val : x->val > y->val;
+    return x->idx < y->idx;
+}
+
+/* Heap with the lowest-ranked entry at the root */
+static void sift_down(ValIdx *h, int n, int at, int find_min)
+{
+    for (;;) {
+        int c = 2 * at + 1;
+        if (c >= n) break;
+        if (c + 1 < n && ranks_before(&h[c], &h[c + 1], find_min)) c++;
+        if (!ranks_before(&h[at], &h[c], find_min)) break;
+        ValIdx t = h[at]; h[at] = h[c]; h[c] = t;
+        at = c;
+    }
+}
+
+static void heap_push(ValIdx *h, int *n, int k, ValIdx v, int find_min)
+{
+    if (*n < k) {
+        int at = (*n)++;
+        h[at] = v;
+        while (at > 0) {
+            int parent = (at - 1) / 2;
+            if (!ranks_before(&h[parent], &h[at], find_min)) break;
+            ValIdx t = h[at]; h[at] = h[parent]; h[parent] = t;
+            at = parent;
+        }
+    } else if (ranks_before(&v, &h[0], find_min)) {
+        h[0] = v;
+        sift_down(h, k, 0, find_min);
+    }
+}
+
+/* In-place heapsort: popping the root to the back leaves h[] best-first */
+static void heap_sort(ValIdx *h, int n, int find_min)
+{
+    for (int end = n - 1; end > 0; end--) {
+        ValIdx t = h[0]; h[0] = h[end]; h[end] = t;
+        sift_down(h, end, 0, find_min);
+    }
+}
+
+/* dst[0..*nd) = best k of the sorted runs dst[0..*nd) and src[0..ns) */
+static void merge_sorted(ValIdx *dst, int *nd, const ValIdx *src, int ns,
+                         ValIdx *tmp, int k, int find_min)
+{
+    int i = 0, j = 0, n = 0;
+    while (n < k && (i < *nd || j < ns)) {
+        if (j == ns || (i < *nd && ranks_before(&dst[i], &src[j], find_min)))
+            tmp[n++] = dst[i++];
+        else
+            tmp[n++] = src[j++];
+    }
+    memcpy(dst, tmp, (size_t)n * sizeof(ValIdx));
+    *nd = n;
+}
+
+static void scan_chunk_topk(const int *a, long lo, long hi, int k, TopKPart *t)
+{
+    long x = lo;
+
+    /* Fill both heaps with the first k elements */
+    for (; x < hi && t->nmin < k; x++) {
+        ValIdx v = { a[x], x };
+        heap_push(t->min, &t->nmin, k, v, 1);
+        heap_push(t->max, &t->nmax, k, v, 0);
+    }
+
+    /* Strict compares are exact here: an equal value seen later in the
+     * chunk has a higher index and never displaces a root */
+    for (; x < hi; x += TOPK_BLOCK) {
+        long end = (hi - x < TOPK_BLOCK) ? hi : x + TOPK_BLOCK;
+        int lo_thr = t->min[0].val, hi_thr = t->max[0].val;
+        int hit = 0;
+
+        #pragma omp simd reduction(|:hit)
+        for (long y = x; y < end; y++)
+            hit |= (a[y] < lo_thr) | (a[y] > hi_thr);
+
+        if (!hit)
+            continue;
+
+        for (long y = x; y < end; y++) {
+            ValIdx v = { a[y], y };
+            if (v.val < t->min[0].val) heap_push(t->min, &t->nmin, k, v, 1);
+            if (v.val > t->max[0].val) heap_push(t->max, &t->nmax, k, v, 0);
+        }
+    }
+}
+
+int minmax_topk_3d(const int *a, int M, int N, int P, int k,
+                   MinMaxLoc *smallest, MinMaxLoc *largest)
+{
+    long total = (long)M * N * P;
+    if (!a || (!smallest && !largest) || M <= 0 || N <= 0 || P <= 0)
+        return -1;
+    if (k <= 0 || k > total)
+        return -1;
+
+    int nt_max = omp_get_max_threads();
+    TopKPart *parts = calloc((size_t)nt_max, sizeof(*parts));
+    ValIdx *pool = malloc((size_t)nt_max * 3 * k * sizeof(ValIdx));
+    if (!parts || !pool) {
+        free(parts);
+        free(pool);
+        return -1;
+    }
+    for (int t = 0; t < nt_max; t++) {
+        parts[t].min = pool + (size_t)t * 3 * k;
+        parts[t].max = parts[t].min + k;
+        parts[t].tmp = parts[t].max + k;
+    }
+
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+        int nt  = omp_get_num_threads();
+        long chunk = total / nt;
+        long lo = tid * chunk;
+        long hi = (tid == nt - 1) ? total : lo + chunk;
+        TopKPart *me = &parts[tid];
+
+        scan_chunk_topk(a, lo, hi, k, me);
+        heap_sort(me->min, me->nmin, 1);
+        heap_sort(me->max, me->nmax, 0);
+
+        /* Tree merge: after the round with stride s, thread t (t % 2s == 0)
+         * holds the best k of threads t .. t + 2s - 1 */
+        for (int s = 1; s < nt; s *= 2) {
+            #pragma omp barrier
+            if (tid % (2 * s) == 0 && tid + s < nt) {
+                TopKPart *other = &parts[tid + s];
+                merge_sorted(me->min, &me->nmin, other->min, other->nmin, me->tmp, k, 1);
+                merge_sorted(me->max, &me->nmax, other->max, other->nmax, me->tmp, k, 0);
+            }
+        }
+    }
+
+    for (int r = 0; r < k; r++) {
+        if (smallest)
+            smallest[r] = loc_from_flat(parts[0].min[r].val, parts[0].min[r].idx, N, P);
+        if (largest)
+            largest[r] = loc_from_flat(parts[0].max[r].val, parts[0].max[r].idx, N, P);
+    }
+
+    free(pool);
+    free(parts);
+    return 0;
+}
@@ -0,0 +1,327 @@
+/*
+ * Per-host tuning table and its cache file.
+ *
+ * The table maps (M, N, P, threads) to a minmax_tuning; kernels ask for
+ * their shape with minmax_tuning_active(), which is a linear scan of a few
+ * dozen entries at most and falls back to the built-in defaults. The
+ * defaults are the values the kernels were tuned with on the development
+ * laptop: 32K-element tiles, 4 tiles per thread, 4 rows of segment
+ * look-ahead, static schedule, 64K-element task leaves.
+ *
+ * Cache file: one tab-separated line per entry,
+ *
+ *     <cpu model> \t <M>x<N>x<P> \t <threads> \t tile_target=.. tiles_per_thread=..
+ *                                                prefetch_rows=.. schedule=.. chunk=.. task_leaf=..
+ *
+ * so one file can be shared by the nodes of a cluster with different CPU
+ * generations; each host only picks up its own model's lines.
+ */
+#include "minmax_impl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define TUNE_MAX_ENTRIES 256
+#define TUNE_LINE_MAX    512
+
+static const minmax_tuning tuning_defaults = {
+    .tile_target      = 32768,
+    .tiles_per_thread = 4,
+    .prefetch_rows    = 4,
+    .schedule         = MINMAX_SCHED_STATIC,
+    .chunk            = 0,
+    .task_leaf        = 65536,
+};
+
+typedef struct {
+    int M, N, P, threads;
+    minmax_tuning t;
+} TuneEntry;
+
+static TuneEntry entries[TUNE_MAX_ENTRIES];
+static int nentries;
+static char cpu_model[128];
+
+static const char *const schedule_names[MINMAX_SCHED_NUM] = { "static", "dynamic", "guided" };
+
+const char *minmax_schedule_name(minmax_schedule s)
+{
+    return (unsigned)s < MINMAX_SCHED_NUM ? schedule_names[s] : NULL;
+}
+
+void minmax_tuning_default(minmax_tuning *t)
+{
+    *t = tuning_defaults;
+}
+
+const minmax_tuning *minmax_tuning_active(int M, int N, int P)
+{
+    if (nentries == 0)
+        return &tuning_defaults;
+    int threads = omp_get_max_threads();
+    for (int e = 0; e < nentries; e++)
+        if (entries[e].M == M && entries[e].N == N && entries[e].P == P &&
+            entries[e].threads == threads)
+            return &entries[e].t;
+    return &tuning_defaults;
+}
+
+void minmax_tuning_get(int M, int N, int P, int threads, minmax_tuning *t)
+{
+    *t = tuning_defaults;
+    for (int e = 0; e < nentries; e++)
+        if (entries[e].M == M && entries[e].N == N && entries[e].P == P &&
+            entries[e].threads == threads)
+            *t = entries[e].t;
+}
+
+static int tuning_valid(const minmax_tuning *t)
+{
+    return t->tile_target > 0 && t->tiles_per_thread > 0 && t->prefetch_rows >= 0 &&
+           (unsigned)t->schedule < MINMAX_SCHED_NUM && t->chunk >= 0 && t->task_leaf > 0;
+}
+
+int minmax_tuning_set(int M, int N, int P, int threads, const minmax_tuning *t)
+{
+    if (!t || M <= 0 || N <= 0 || P <= 0 || threads <= 0 || !tuning_valid(t))
+        return -1;
+    for (int e = 0; e < nentries; e++) {
+        if (entries[e].M == M && entries[e].N == N && entries[e].P == P &&
+            entries[e].threads == threads) {
+            entries[e].t = *t;
+            return 0;
+        }
+    }
+    if (nentries == TUNE_MAX_ENTRIES)
+        return -1;
+    entries[nentries++] = (TuneEntry){ M, N, P, threads, *t };
+    return 0;
+}
+
+minmax_sched_saved minmax_schedule_apply(const minmax_tuning *t)
+{
+    static const omp_sched_t kinds[MINMAX_SCHED_NUM] = {
+        omp_sched_static, omp_sched_dynamic, omp_sched_guided,
+    };
+    minmax_sched_saved saved;
+    omp_get_schedule(&saved.kind, &saved.chunk);
+    omp_set_schedule(kinds[t->schedule], t->chunk);
+    return saved;
+}
+
+void minmax_schedule_restore(minmax_sched_saved s)
+{
+    omp_set_schedule(s.kind, s.chunk);
+}
+
+/* ---------------- Host key ---------------- */
+
+static void trim(char *s)
+{
+    size_t n = strlen(s);
+    while (n > 0 && (s[n - 1] == '\n' || s[n - 1] == ' ' || s[n - 1] == '\t'))
+        s[--n] = '\0';
+}
+
+/* Value of the first "key : value" line in /proc/cpuinfo, or "" */
+static void cpuinfo_field(const char *key, char *out, size_t len)
+{
+    out[0] = '\0';
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (!f)
+        return;
+    char line[TUNE_LINE_MAX];
+    size_t klen = strlen(key);
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, key, klen) != 0 || (line[klen] != ' ' && line[klen] != '\t' && line[klen] != ':'))
+            continue;
+        const char *v = strchr(line, ':');
+        if (!v)
+            continue;
+        for (v++; *v == ' ' || *v == '\t'; v++)
+            ;
+        snprintf(out, len, "%s", v);
+        trim(out);
+        break;
+    }
+    fclose(f);
+}
+
+const char *minmax_cpu_model(void)
+{
+    if (cpu_model[0])
+        return cpu_model;
+
+    cpuinfo_field("model name", cpu_model, sizeof(cpu_model));
+    if (!cpu_model[0]) {
+        /* aarch64: no model name, identify by implementer and part */
+        char impl[32], part[32];
+        cpuinfo_field("CPU implementer", impl, sizeof(impl));
+        cpuinfo_field("CPU part", part, sizeof(part));
+        if (impl[0])
+            snprintf(cpu_model, sizeof(cpu_model), "arm %s/%s", impl, part);
+    }
+    if (!cpu_model[0])
+        snprintf(cpu_model, sizeof(cpu_model), "unknown");
+
+    /* The model is a tab-separated field in the cache file */
+    for (char *c = cpu_model; *c; c++)
+        if (*c == '\t')
+            *c = ' ';
+    return cpu_model;
+}
+
+/* ---------------- Cache file ---------------- */
+
+/* Default cache path, or NULL if disabled / no home directory */
+static const char *default_path(void)
+{
+    static char path[1024];
+    const char *env = getenv("MINMAX_TUNE_FILE");
+    if (env)
+        return *env ? env : NULL;
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    if (xdg && *xdg)
+        snprintf(path, sizeof(path), "%s/minmax/tuning.tsv", xdg);
+    else if (home && *home)
+        snprintf(path, sizeof(path), "%s/.cache/minmax/tuning.tsv", home);
+    else
+        return NULL;
+    return path;
+}
+
+/* Split a cache line; returns 0 if it is a well-formed entry */
+static int parse_line(char *line, char **model, TuneEntry *e)
+{
+    char *f[4];
+    char *p = line;
+    for (int x = 0; x < 4; x++) {
+        f[x] = p;
+        p = x < 3 ? strchr(p, '\t') : NULL;
+        if (x < 3) {
+            if (!p)
+                return -1;
+            *p++ = '\0';
+        }
+    }
+    char tail;
+    if (sscanf(f[1], "%dx%dx%d%c", &e->M, &e->N, &e->P, &tail) != 3 ||
+        sscanf(f[2], "%d%c", &e->threads, &tail) != 1)
+        return -1;
+
+    e->t = tuning_defaults;
+    char *save;
+    for (char *kv = strtok_r(f[3], " \t\n", &save); kv; kv = strtok_r(NULL, " \t\n", &save)) {
+        char *eq = strchr(kv, '=');
+        if (!eq)
+            return -1;
+        *eq++ = '\0';
+        if      (strcmp(kv, "tile_target") == 0)      e->t.tile_target = atoi(eq);
+        else if (strcmp(kv, "tiles_per_thread") == 0) e->t.tiles_per_thread = atoi(eq);
+        else if (strcmp(kv, "prefetch_rows") == 0)    e->t.prefetch_rows = atoi(eq);
+        else if (strcmp(kv, "chunk") == 0)            e->t.chunk = atoi(eq);
+        else if (strcmp(kv, "task_leaf") == 0)        e->t.task_leaf = atol(eq);
+        else if (strcmp(kv, "schedule") == 0) {
+            e->t.schedule = -1;
+            for (int s = 0; s < MINMAX_SCHED_NUM; s++)
+                if (strcmp(eq, schedule_names[s]) == 0)
+                    e->t.schedule = s;
+        }
+        /* unknown keys are from a newer library: ignore */
+    }
+    *model = f[0];
+    return tuning_valid(&e->t) && e->M > 0 && e->N > 0 && e->P > 0 && e->threads > 0 ? 0 : -1;
+}
+
+int minmax_tuning_load(const char *path)
+{
+    if (!path && !(path = default_path()))
+        return -1;
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return -1;
+
+    const char *me = minmax_cpu_model();
+    char line[TUNE_LINE_MAX];
+    int n = 0;
+    while (fgets(line, sizeof(line), f)) {
+        char *model;
+        TuneEntry e;
+        if (line[0] == '#' || parse_line(line, &model, &e) != 0 || strcmp(model, me) != 0)
+            continue;
+        if (minmax_tuning_set(e.M, e.N, e.P, e.threads, &e.t) == 0)
+            n++;
+    }
+    fclose(f);
+    return n;
+}
+
+/* mkdir -p of the directory part of path */
+static void make_parent_dirs(const char *path)
+{
+    char dir[1024];
+    snprintf(dir, sizeof(dir), "%s", path);
+    for (char *c = dir + 1; *c; c++) {
+        if (*c != '/')
+            continue;
+        *c = '\0';
+        mkdir(dir, 0755);
+        *c = '/';
+    }
+}
+
+int minmax_tuning_save(const char *path)
+{
+    if (!path && !(path = default_path()))
+        return -1;
+
+    /* Keep other hosts' lines, then write ours */
+    const char *me = minmax_cpu_model();
+    char *kept = NULL;
+    size_t kept_len = 0;
+    FILE *in = fopen(path, "r");
+    if (in) {
+        FILE *mem = open_memstream(&kept, &kept_len);
+        char line[TUNE_LINE_MAX], copy[TUNE_LINE_MAX];
+        while (mem && fgets(line, sizeof(line), in)) {
+            char *model;
+            TuneEntry e;
+            memcpy(copy, line, sizeof(line));
+            if (line[0] == '#' || (parse_line(copy, &model, &e) == 0 && strcmp(model, me) == 0))
+                continue;
+            fputs(line, mem);
+        }
+        if (mem)
+            fclose(mem);
+        fclose(in);
+    }
+
+    make_parent_dirs(path);
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        free(kept);
+        return -1;
+    }
+    fprintf(f, "# libminmax tuning cache: model\tMxNxP\tthreads\tsettings\n");
+    if (kept)
+        fputs(kept, f);
+    for (int e = 0; e < nentries; e++) {
+        const minmax_tuning *t = &entries[e].t;
+        fprintf(f, "%s\t%dx%dx%d\t%d\ttile_target=%d tiles_per_thread=%d prefetch_rows=%d "
+                   "schedule=%s chunk=%d task_leaf=%ld\n",
+                me, entries[e].M, entries[e].N, entries[e].P, entries[e].threads,
+                t->tile_target, t->tiles_per_thread, t->prefetch_rows,
+                schedule_names[t->schedule], t->chunk, t->task_leaf);
+    }
+    free(kept);
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/* Load this host's entries before main(); a missing file is not an error */
+__attribute__((constructor))
+static void tuning_init(void)
+{
+    minmax_tuning_load(NULL);
+}
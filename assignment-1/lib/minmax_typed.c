@@ -0,0 +1,56 @@
+/*
+ * minmax_loc_3d_<sfx>() for every MINMAX_TYPES element type: each thread
+ * scans one contiguous chunk with the dispatched typed kernel
+ * (scan_typed_*.c), then a critical section merges the per-thread
+ * winners, lower index first on ties — the same shape as minmax_simd.c.
+ */
+#include "minmax_impl.h"
+
+#define TYPED_ENTRY(sfx, T)                                                       \
+int minmax_loc_3d_##sfx(const T *a, int M, int N, int P,                          \
+                        MinMaxLoc_##sfx *min, MinMaxLoc_##sfx *max)               \
+{                                                                                 \
+    if (!a || !min || !max || M <= 0 || N <= 0 || P <= 0)                         \
+        return -1;                                                                \
+                                                                                  \
+    long total = (long)M * N * P;                                                 \
+    scan_##sfx##_fn scan = typed_scan_kernels()->sfx;                             \
+                                                                                  \
+    ValIdx_##sfx gmin = { 0, -1 };                                                \
+    ValIdx_##sfx gmax = { 0, -1 };                                                \
+                                                                                  \
+    _Pragma("omp parallel")                                                       \
+    {                                                                             \
+        int tid = omp_get_thread_num();                                           \
+        int nt  = omp_get_num_threads();                                          \
+        long chunk = total / nt;                                                  \
+        long lo = tid * chunk;                                                    \
+        long hi = (tid == nt - 1) ? total : lo + chunk;                           \
+                                                                                  \
+        ValIdx_##sfx lmin = { 0, -1 };                                            \
+        ValIdx_##sfx lmax = { 0, -1 };                                            \
+        scan(a, lo, hi, &lmin, &lmax);                                            \
+                                                                                  \
+        _Pragma("omp critical(typed_merge)")                                      \
+        {                                                                         \
+            if (lmin.idx >= 0 && (gmin.idx < 0 || lmin.val < gmin.val ||          \
+                                  (lmin.val == gmin.val && lmin.idx < gmin.idx))) \
+                gmin = lmin;                                                      \
+            if (lmax.idx >= 0 && (gmax.idx < 0 || lmax.val > gmax.val ||          \
+                                  (lmax.val == gmax.val && lmax.idx < gmax.idx))) \
+                gmax = lmax;                                                      \
+        }                                                                         \
+    }                                                                             \
+                                                                                  \
+    /* Nothing but NaNs: report the first element */                             \
+    if (gmin.idx < 0) { gmin.val = a[0]; gmin.idx = 0; }                          \
+    if (gmax.idx < 0) { gmax.val = a[0]; gmax.idx = 0; }                          \
+                                                                                  \
+    MinMaxLoc lmn = loc_from_flat(0, gmin.idx, N, P);                             \
+    MinMaxLoc lmx = loc_from_flat(0, gmax.idx, N, P);                             \
+    *min = (MinMaxLoc_##sfx){ gmin.val, lmn.i, lmn.j, lmn.k };                    \
+    *max = (MinMaxLoc_##sfx){ gmax.val, lmx.i, lmx.j, lmx.k };                    \
+    return 0;                                                                     \
+}
+
+MINMAX_TYPES(TYPED_ENTRY)
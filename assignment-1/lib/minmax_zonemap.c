@@ -0,0 +1,449 @@
+/*
+ * Zone map: a min/max summary tree over a volume, built once in parallel,
+ * that answers full-volume and ROI queries without rescanning and follows
+ * batched point updates without a rebuild.
+ *
+ *   level 0  tiles  ZONE_TI x ZONE_TJ x ZONE_TK elements (8 x 8 x 64 =
+ *                   16 KB), each with its min and max and their positions
+ *   level l  nodes  one per 2 x 2 x 2 nodes of level l - 1 (a tournament
+ *                   tree over the tile grid), up to a single root
+ *
+ * The tiles are novel_ultimate's 8 x 8 row blocks, cut at 64 along k as
+ * well so a box that does not span whole rows still covers most tiles
+ * completely. A query splits its box into the largest tile-aligned inner
+ * box, answered by descending the tree and taking every node that lies
+ * inside it, and a shell of at most six slabs, scanned in place by the
+ * ultimate ROI driver. The slabs keep rows long and contiguous, which is
+ * much cheaper than visiting the boundary tile by tile.
+ *
+ * An update batch is grouped by tile, and each tile is patched by one
+ * thread: a value that beats the tile's extreme replaces it, a worse value
+ * written over the extreme's own cell forces a rescan of that tile (4096
+ * elements), anything else leaves the summary as it is. Only ancestors of
+ * touched tiles are refolded afterwards, so the cost follows the batch,
+ * not the volume. Everything is merged with the position-aware combiners,
+ * so ties resolve to the first position exactly as a full scan would.
+ *
+ * The index points at the caller's buffer; the buffer must outlive the
+ * index and change only through minmax_index_update().
+ */
+#include "minmax_impl.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ZONE_TI 8
+#define ZONE_TJ 8
+#define ZONE_TK 64
+
+/* Enough levels for 2^31 tiles along one dimension */
+#define ZONE_MAX_LEVELS 33
+
+struct minmax_index {
+    const int *a;
+    int M, N, P;
+    int nlevels;
+    int ni[ZONE_MAX_LEVELS], nj[ZONE_MAX_LEVELS], nk[ZONE_MAX_LEVELS];  /* nodes per dimension */
+    MinMaxLoc *min[ZONE_MAX_LEVELS], *max[ZONE_MAX_LEVELS];
+};
+
+#define NODE_AT(ix, l, x, y, z) (((long)(x) * (ix)->nj[l] + (y)) * (ix)->nk[l] + (z))
+
+static inline int min_int(int x, int y) { return x < y ? x : y; }
+
+/* Node coordinates of flat node id at level l */
+static inline void node_coords(const minmax_index *ix, int l, long id, int *x, int *y, int *z)
+{
+    *z = (int)(id % ix->nk[l]);
+    *y = (int)((id / ix->nk[l]) % ix->nj[l]);
+    *x = (int)(id / ((long)ix->nk[l] * ix->nj[l]));
+}
+
+/* Rescan tile (ti, tj, tk), seeded with its first element */
+static void scan_tile(const minmax_index *ix, const ScanKernels *sk, int ti, int tj, int tk,
+                      MinMaxLoc *tmin, MinMaxLoc *tmax)
+{
+    const int *a = ix->a;
+    int N = ix->N, P = ix->P;
+    int i0 = ti * ZONE_TI, i1 = min_int(i0 + ZONE_TI, ix->M);
+    int j0 = tj * ZONE_TJ, j1 = min_int(j0 + ZONE_TJ, N);
+    int k0 = tk * ZONE_TK, k1 = min_int(k0 + ZONE_TK, P);
+
+    long first = IDX(i0, j0, k0, N, P);
+    *tmin = *tmax = loc_from_flat(a[first], first, N, P);
+    for (int i = i0; i < i1; i++)
+        for (int j = j0; j < j1; j++)
+            simd_scan_run(sk, a, IDX(i, j, k0, N, P), k1 - k0, tmin, tmax, N, P);
+}
+
+/* Refold node (x, y, z) of level l >= 1 from its (up to 8) children */
+static void refold_node(minmax_index *ix, int l, int x, int y, int z)
+{
+    int c = l - 1;
+    MinMaxLoc nmin = ix->min[c][NODE_AT(ix, c, 2 * x, 2 * y, 2 * z)];
+    MinMaxLoc nmax = ix->max[c][NODE_AT(ix, c, 2 * x, 2 * y, 2 * z)];
+
+    for (int cx = 2 * x; cx < min_int(2 * x + 2, ix->ni[c]); cx++)
+        for (int cy = 2 * y; cy < min_int(2 * y + 2, ix->nj[c]); cy++)
+            for (int cz = 2 * z; cz < min_int(2 * z + 2, ix->nk[c]); cz++) {
+                minloc_combine(&nmin, &ix->min[c][NODE_AT(ix, c, cx, cy, cz)]);
+                maxloc_combine(&nmax, &ix->max[c][NODE_AT(ix, c, cx, cy, cz)]);
+            }
+    ix->min[l][NODE_AT(ix, l, x, y, z)] = nmin;
+    ix->max[l][NODE_AT(ix, l, x, y, z)] = nmax;
+}
+
+/* Fold the part of node (x, y, z) of level l that lies in the tile range
+ * t[0..1) x t[2..3) x t[4..5): a node inside contributes its own summary,
+ * a node straddling the range edge recurses into its children */
+static void fold_tree(const minmax_index *ix, int l, int x, int y, int z, const int t[6],
+                      MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    int i0 = x << l, i1 = min_int((x + 1) << l, ix->ni[0]);
+    int j0 = y << l, j1 = min_int((y + 1) << l, ix->nj[0]);
+    int k0 = z << l, k1 = min_int((z + 1) << l, ix->nk[0]);
+
+    if (i1 <= t[0] || i0 >= t[1] || j1 <= t[2] || j0 >= t[3] || k1 <= t[4] || k0 >= t[5])
+        return;
+
+    if (i0 >= t[0] && i1 <= t[1] && j0 >= t[2] && j1 <= t[3] && k0 >= t[4] && k1 <= t[5]) {
+        minloc_combine(vmin, &ix->min[l][NODE_AT(ix, l, x, y, z)]);
+        maxloc_combine(vmax, &ix->max[l][NODE_AT(ix, l, x, y, z)]);
+        return;
+    }
+
+    int c = l - 1;
+    for (int cx = 2 * x; cx < min_int(2 * x + 2, ix->ni[c]); cx++)
+        for (int cy = 2 * y; cy < min_int(2 * y + 2, ix->nj[c]); cy++)
+            for (int cz = 2 * z; cz < min_int(2 * z + 2, ix->nk[c]); cz++)
+                fold_tree(ix, c, cx, cy, cz, t, vmin, vmax);
+}
+
+/* Scan the slab [i0,i1) x [j0,j1) x [k0,k1) in place, if not empty */
+static void scan_slab(const minmax_index *ix, int i0, int i1, int j0, int j1, int k0, int k1,
+                      MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    if (i0 >= i1 || j0 >= j1 || k0 >= k1)
+        return;
+
+    MinMaxLoc smin, smax;
+    minmax_ultimate_box(ix->a, ix->N, ix->P, i0, i1, j0, j1, k0, k1, &smin, &smax);
+    minloc_combine(vmin, &smin);
+    maxloc_combine(vmax, &smax);
+}
+
+minmax_index *minmax_index_build(const int *a, int M, int N, int P)
+{
+    if (!a || M <= 0 || N <= 0 || P <= 0)
+        return NULL;
+
+    minmax_index *ix = calloc(1, sizeof(*ix));
+    if (!ix)
+        return NULL;
+    ix->a = a;
+    ix->M = M; ix->N = N; ix->P = P;
+
+    ix->ni[0] = (M + ZONE_TI - 1) / ZONE_TI;
+    ix->nj[0] = (N + ZONE_TJ - 1) / ZONE_TJ;
+    ix->nk[0] = (P + ZONE_TK - 1) / ZONE_TK;
+    ix->nlevels = 1;
+    for (int l = 0; ix->ni[l] > 1 || ix->nj[l] > 1 || ix->nk[l] > 1; l++) {
+        ix->ni[l + 1] = (ix->ni[l] + 1) / 2;
+        ix->nj[l + 1] = (ix->nj[l] + 1) / 2;
+        ix->nk[l + 1] = (ix->nk[l] + 1) / 2;
+        ix->nlevels++;
+    }
+
+    for (int l = 0; l < ix->nlevels; l++) {
+        long nodes = (long)ix->ni[l] * ix->nj[l] * ix->nk[l];
+        ix->min[l] = malloc((size_t)nodes * sizeof(MinMaxLoc));
+        ix->max[l] = malloc((size_t)nodes * sizeof(MinMaxLoc));
+        if (!ix->min[l] || !ix->max[l]) {
+            minmax_index_free(ix);
+            return NULL;
+        }
+    }
+
+    const ScanKernels *sk = scan_kernels();
+    int ntk = ix->nk[0];
+
+    /* Level 0: one pass over the volume. Each task owns an 8 x 8 block of
+     * rows and walks every row once, front to back, dropping each 64-wide
+     * segment into its tile, so the hardware prefetcher sees plain
+     * sequential rows rather than a jump per tile. */
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int ti = 0; ti < ix->ni[0]; ti++) {
+        for (int tj = 0; tj < ix->nj[0]; tj++) {
+            int i0 = ti * ZONE_TI, i1 = min_int(i0 + ZONE_TI, M);
+            int j0 = tj * ZONE_TJ, j1 = min_int(j0 + ZONE_TJ, N);
+            MinMaxLoc *tmin = &ix->min[0][NODE_AT(ix, 0, ti, tj, 0)];
+            MinMaxLoc *tmax = &ix->max[0][NODE_AT(ix, 0, ti, tj, 0)];
+
+            /* Seed with each tile's first element so an all-INT_MAX tile
+             * still records a position inside the tile */
+            for (int tk = 0; tk < ntk; tk++) {
+                long first = IDX(i0, j0, tk * ZONE_TK, N, P);
+                tmin[tk] = tmax[tk] = loc_from_flat(a[first], first, N, P);
+            }
+
+            for (int i = i0; i < i1; i++) {
+                for (int j = j0; j < j1; j++) {
+                    if (j + 1 < j1)
+                        __builtin_prefetch(&a[IDX(i, j + 1, 0, N, P)], 0, 1);
+                    for (int tk = 0; tk < ntk; tk++) {
+                        int k0 = tk * ZONE_TK;
+                        simd_scan_run(sk, a, IDX(i, j, k0, N, P), min_int(ZONE_TK, P - k0),
+                                      &tmin[tk], &tmax[tk], N, P);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Upper levels, bottom up */
+    for (int l = 1; l < ix->nlevels; l++) {
+        #pragma omp parallel for collapse(3) schedule(static)
+        for (int x = 0; x < ix->ni[l]; x++)
+            for (int y = 0; y < ix->nj[l]; y++)
+                for (int z = 0; z < ix->nk[l]; z++)
+                    refold_node(ix, l, x, y, z);
+    }
+
+    return ix;
+}
+
+void minmax_index_free(minmax_index *ix)
+{
+    if (!ix)
+        return;
+    for (int l = 0; l < ix->nlevels; l++) {
+        free(ix->min[l]);
+        free(ix->max[l]);
+    }
+    free(ix);
+}
+
+int minmax_index_query(const minmax_index *ix, const minmax_box *box,
+                       MinMaxLoc *out_min, MinMaxLoc *out_max)
+{
+    if (!ix || !out_min || !out_max)
+        return -1;
+
+    minmax_box b = { 0, ix->M, 0, ix->N, 0, ix->P };
+    if (box) {
+        b = *box;
+        if (b.i0 < 0 || b.i0 >= b.i1 || b.i1 > ix->M ||
+            b.j0 < 0 || b.j0 >= b.j1 || b.j1 > ix->N ||
+            b.k0 < 0 || b.k0 >= b.k1 || b.k1 > ix->P)
+            return -1;
+    }
+
+    /* Seed with the box's first element so the result lies inside the box */
+    long first = IDX(b.i0, b.j0, b.k0, ix->N, ix->P);
+    MinMaxLoc vmin = loc_from_flat(ix->a[first], first, ix->N, ix->P);
+    MinMaxLoc vmax = vmin;
+
+    /* Tiles entirely inside the box; the clipped last tile along a
+     * dimension counts when the box reaches the volume edge */
+    int t[6] = {
+        (b.i0 + ZONE_TI - 1) / ZONE_TI, b.i1 == ix->M ? ix->ni[0] : b.i1 / ZONE_TI,
+        (b.j0 + ZONE_TJ - 1) / ZONE_TJ, b.j1 == ix->N ? ix->nj[0] : b.j1 / ZONE_TJ,
+        (b.k0 + ZONE_TK - 1) / ZONE_TK, b.k1 == ix->P ? ix->nk[0] : b.k1 / ZONE_TK,
+    };
+
+    if (t[0] >= t[1] || t[2] >= t[3] || t[4] >= t[5]) {
+        /* No whole tile inside: the summaries cannot help */
+        scan_slab(ix, b.i0, b.i1, b.j0, b.j1, b.k0, b.k1, &vmin, &vmax);
+        *out_min = vmin;
+        *out_max = vmax;
+        return 0;
+    }
+
+    /* Inner box from the tree */
+    fold_tree(ix, ix->nlevels - 1, 0, 0, 0, t, &vmin, &vmax);
+
+    /* Shell: the box minus the inner box, as up to six slabs */
+    int I0 = t[0] * ZONE_TI, I1 = min_int(t[1] * ZONE_TI, ix->M);
+    int J0 = t[2] * ZONE_TJ, J1 = min_int(t[3] * ZONE_TJ, ix->N);
+    int K0 = t[4] * ZONE_TK, K1 = min_int(t[5] * ZONE_TK, ix->P);
+
+    scan_slab(ix, b.i0, I0, b.j0, b.j1, b.k0, b.k1, &vmin, &vmax);
+    scan_slab(ix, I1, b.i1, b.j0, b.j1, b.k0, b.k1, &vmin, &vmax);
+    scan_slab(ix, I0, I1, b.j0, J0, b.k0, b.k1, &vmin, &vmax);
+    scan_slab(ix, I0, I1, J1, b.j1, b.k0, b.k1, &vmin, &vmax);
+    scan_slab(ix, I0, I1, J0, J1, b.k0, K0, &vmin, &vmax);
+    scan_slab(ix, I0, I1, J0, J1, K1, b.k1, &vmin, &vmax);
+
+    *out_min = vmin;
+    *out_max = vmax;
+    return 0;
+}
+
+/* ---------------- Updates ---------------- */
+
+/* Update seq of the batch and the tile it lands in */
+typedef struct {
+    long tile;
+    long seq;
+} TileRef;
+
+/* By tile, then batch order, so repeated writes to a cell keep the last */
+static int cmp_tileref(const void *x, const void *y)
+{
+    const TileRef *a = x, *b = y;
+    if (a->tile != b->tile)
+        return a->tile < b->tile ? -1 : 1;
+    return (a->seq > b->seq) - (a->seq < b->seq);
+}
+
+static int cmp_long(const void *x, const void *y)
+{
+    long a = *(const long *)x, b = *(const long *)y;
+    return (a > b) - (a < b);
+}
+
+/*
+ * Counting sort of refs[] by tile, for batches dense enough that one pass
+ * over a per-tile counter array beats qsort's n log n compares. Stable, so
+ * batch order within a tile is kept. Returns -1 to leave it to qsort.
+ */
+static int sort_by_tile(const minmax_index *ix, TileRef *refs, long n)
+{
+    long ntiles = (long)ix->ni[0] * ix->nj[0] * ix->nk[0];
+    if (n < ntiles / 8)
+        return -1;
+
+    long *count = calloc((size_t)ntiles + 1, sizeof(long));
+    TileRef *out = malloc((size_t)n * sizeof(TileRef));
+    if (!count || !out) {
+        free(count);
+        free(out);
+        return -1;
+    }
+
+    for (long q = 0; q < n; q++)
+        count[refs[q].tile + 1]++;
+    for (long t = 0; t < ntiles; t++)
+        count[t + 1] += count[t];
+    for (long q = 0; q < n; q++)
+        out[count[refs[q].tile]++] = refs[q];
+    memcpy(refs, out, (size_t)n * sizeof(TileRef));
+
+    free(count);
+    free(out);
+    return 0;
+}
+
+static inline int same_cell(const MinMaxLoc *m, const minmax_update *u)
+{
+    return m->i == u->i && m->j == u->j && m->k == u->k;
+}
+
+/* Write the n updates of one tile, in batch order, and patch its summary */
+static void apply_tile(minmax_index *ix, const ScanKernels *sk, int *a,
+                       const minmax_update *u, const TileRef *refs, long n)
+{
+    long t = refs[0].tile;
+    MinMaxLoc *tmin = &ix->min[0][t];
+    MinMaxLoc *tmax = &ix->max[0][t];
+    int rescan = 0;
+
+    for (long r = 0; r < n; r++) {
+        const minmax_update *up = &u[refs[r].seq];
+        a[IDX(up->i, up->j, up->k, ix->N, ix->P)] = up->val;
+        if (rescan)
+            continue;
+
+        /* The extreme's own cell got worse: it may have moved anywhere in
+         * the tile, so settle the tile once all its writes are in */
+        MinMaxLoc cell = { up->val, up->i, up->j, up->k };
+        if (same_cell(tmin, up)) {
+            if (up->val > tmin->val) rescan = 1; else tmin->val = up->val;
+        } else {
+            minloc_combine(tmin, &cell);
+        }
+        if (same_cell(tmax, up)) {
+            if (up->val < tmax->val) rescan = 1; else tmax->val = up->val;
+        } else {
+            maxloc_combine(tmax, &cell);
+        }
+    }
+
+    if (rescan) {
+        int ti, tj, tk;
+        node_coords(ix, 0, t, &ti, &tj, &tk);
+        scan_tile(ix, sk, ti, tj, tk, tmin, tmax);
+    }
+}
+
+int minmax_index_update(minmax_index *ix, int *a, const minmax_update *u, long n)
+{
+    if (!ix || a != ix->a || n < 0 || (n > 0 && !u))
+        return -1;
+    for (long q = 0; q < n; q++)
+        if (u[q].i < 0 || u[q].i >= ix->M || u[q].j < 0 || u[q].j >= ix->N ||
+            u[q].k < 0 || u[q].k >= ix->P)
+            return -1;
+    if (n == 0)
+        return 0;
+
+    TileRef *refs = malloc((size_t)n * sizeof(TileRef));
+    long *starts  = malloc((size_t)(n + 1) * sizeof(long));
+    long *nodes   = malloc((size_t)n * sizeof(long));
+    if (!refs || !starts || !nodes) {
+        free(refs);
+        free(starts);
+        free(nodes);
+        return -1;
+    }
+
+    /* Sort by tile so every tile, and the cells it covers, has one owner */
+    for (long q = 0; q < n; q++) {
+        refs[q].tile = NODE_AT(ix, 0, u[q].i / ZONE_TI, u[q].j / ZONE_TJ, u[q].k / ZONE_TK);
+        refs[q].seq  = q;
+    }
+    if (sort_by_tile(ix, refs, n) != 0)
+        qsort(refs, (size_t)n, sizeof(TileRef), cmp_tileref);
+
+    long ntiles = 0;
+    for (long q = 0; q < n; q++)
+        if (q == 0 || refs[q].tile != refs[q - 1].tile)
+            starts[ntiles++] = q;
+    starts[ntiles] = n;
+
+    const ScanKernels *sk = scan_kernels();
+
+    #pragma omp parallel for schedule(dynamic, 16) if (ntiles >= 64)
+    for (long s = 0; s < ntiles; s++)
+        apply_tile(ix, sk, a, u, refs + starts[s], starts[s + 1] - starts[s]);
+
+    /* Refold the ancestors of the touched tiles, one level at a time */
+    long nn = ntiles;
+    for (long s = 0; s < ntiles; s++)
+        nodes[s] = refs[starts[s]].tile;
+
+    for (int l = 1; l < ix->nlevels; l++) {
+        for (long s = 0; s < nn; s++) {
+            int x, y, z;
+            node_coords(ix, l - 1, nodes[s], &x, &y, &z);
+            nodes[s] = NODE_AT(ix, l, x / 2, y / 2, z / 2);
+        }
+        qsort(nodes, (size_t)nn, sizeof(long), cmp_long);
+        long m = 0;
+        for (long s = 0; s < nn; s++)
+            if (m == 0 || nodes[s] != nodes[m - 1])
+                nodes[m++] = nodes[s];
+        nn = m;
+
+        #pragma omp parallel for schedule(static) if (nn >= 256)
+        for (long s = 0; s < nn; s++) {
+            int x, y, z;
+            node_coords(ix, l, nodes[s], &x, &y, &z);
+            refold_node(ix, l, x, y, z);
+        }
+    }
+
+    free(refs);
+    free(starts);
+    free(nodes);
+    return 0;
+}
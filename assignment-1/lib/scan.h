@@ -0,0 +1,200 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+/*
+ * Shared min/max-with-location row/chunk kernels.
+ *
+ * One implementation per instruction set (scalar, SSE4.1, AVX2, AVX-512F,
+ * NEON), each in its own translation unit compiled with only the flags it
+ * needs. scan_kernels() returns the best variant the host CPU supports; the
+ * choice is made once at program start (cpuid on x86, HWCAP on AArch64) and
+ * can be forced with MINMAX_ISA=scalar|sse4.1|avx2|avx512|neon.
+ *
+ * All variants produce bit-identical results: the winner is the smallest
+ * (resp. largest) value, and among equal values the one with the lowest
+ * index.
+ */
+
+#include "minmax.h"
+
+typedef struct { int val; long idx; } ValIdx;
+
+/*
+ * Fold a[lo..hi) into *vmin / *vmax. An element replaces the incoming best
+ * only if it is strictly smaller (resp. larger), so when callers scan ranges
+ * in increasing index order the first occurrence wins. Reported indices are
+ * absolute positions in a[].
+ */
+typedef void (*scan_minmax_fn)(const int *a, long lo, long hi,
+                               ValIdx *vmin, ValIdx *vmax);
+
+/*
+ * Streaming variant of scan_minmax_fn for long runs that are read once
+ * (MINMAX_STREAM). Same contract, plus: lines `prefetch` bytes ahead are
+ * prefetched (0 = leave it to the hardware prefetcher), and with nt != 0
+ * the prefetches are non-temporal and the loads MOVNTDQA, so the scan
+ * does not evict the rest of the cache for data it will not revisit. The
+ * x86 variants keep SCAN_STREAM_ACC independent accumulator sets, each
+ * taking every SCAN_STREAM_ACC-th vector, so consecutive compares do not
+ * wait on the previous blend; scalar and NEON prefetch ahead of their
+ * minmax kernel.
+ */
+typedef void (*scan_stream_fn)(const int *a, long lo, long hi, long prefetch, int nt,
+                               ValIdx *vmin, ValIdx *vmax);
+
+#define SCAN_STREAM_ACC 4
+
+/*
+ * First i in [lo, hi) with a[i] == val, or hi if there is none. Used to
+ * recover the position of a value already known to be the extreme of a
+ * short block (MINMAX_OMP_SIMD phase 2).
+ */
+typedef long (*scan_find_fn)(const int *a, long lo, long hi, int val);
+
+typedef struct {
+    const char     *name;
+    scan_minmax_fn  minmax;
+    scan_stream_fn  stream;
+    scan_find_fn    find;
+} ScanKernels;
+
+/* Per-ISA tables; only the ones built for the target architecture exist */
+extern const ScanKernels scan_kernels_scalar;
+extern const ScanKernels scan_kernels_sse41;
+extern const ScanKernels scan_kernels_avx2;
+extern const ScanKernels scan_kernels_avx512;
+extern const ScanKernels scan_kernels_neon;
+
+/* Best kernels for this host (resolved once at startup) */
+const ScanKernels *scan_kernels(void);
+
+/*
+ * SIMD lanes track 32-bit offsets, so vector loops process at most this many
+ * elements before folding into the 64-bit ValIdx and starting a new block.
+ */
+#define SCAN_BLOCK (1L << 30)
+
+/*
+ * Fold per-lane candidates into *best: lane values vals[] with lane element
+ * offsets offs[] relative to base. Among lanes holding the extreme value the
+ * smallest offset wins, which restores first-occurrence order across lanes.
+ */
+static inline void scan_fold_lanes(const int *vals, const int *offs, int lanes,
+                                   long base, ValIdx *best, int find_min)
+{
+    int bv = vals[0], bo = offs[0];
+    for (int l = 1; l < lanes; l++) {
+        int better = find_min ? (vals[l] < bv) : (vals[l] > bv);
+        if (better || (vals[l] == bv && offs[l] < bo)) {
+            bv = vals[l];
+            bo = offs[l];
+        }
+    }
+    if (find_min ? (bv < best->val) : (bv > best->val)) {
+        best->val = bv;
+        best->idx = base + bo;
+    }
+}
+
+/* Scalar fold of a[lo..hi), shared by every variant for its tail */
+static inline void scan_tail(const int *a, long lo, long hi,
+                             ValIdx *vmin, ValIdx *vmax)
+{
+    for (long i = lo; i < hi; i++) {
+        int val = a[i];
+        if (val < vmin->val) { vmin->val = val; vmin->idx = i; }
+        if (val > vmax->val) { vmax->val = val; vmax->idx = i; }
+    }
+}
+
+/* Scalar search of a[lo..hi), shared by every variant for its tail */
+static inline long scan_find_tail(const int *a, long lo, long hi, int val)
+{
+    for (long i = lo; i < hi; i++)
+        if (a[i] == val)
+            return i;
+    return hi;
+}
+
+/* Prefetch the cache lines of [p, p + bytes), non-temporal if nt */
+static inline void scan_prefetch(const char *p, long bytes, int nt)
+{
+    for (long o = 0; o < bytes; o += 64) {
+        if (nt)
+            __builtin_prefetch(p + o, 0, 0);
+        else
+            __builtin_prefetch(p + o, 0, 3);
+    }
+}
+
+/*
+ * scan_stream_fn for kernels without a dedicated streaming loop: fold
+ * a[lo..hi) in 4 KB blocks with fn, prefetching each block's lines
+ * `prefetch` bytes ahead first. nt only changes the prefetch hint.
+ */
+#define SCAN_STREAM_BLOCK 1024L
+
+static inline void scan_stream_blocks(scan_minmax_fn fn, const int *a, long lo, long hi,
+                                      long prefetch, int nt, ValIdx *vmin, ValIdx *vmax)
+{
+    for (long i = lo; i < hi; i += SCAN_STREAM_BLOCK) {
+        long end = hi - i > SCAN_STREAM_BLOCK ? i + SCAN_STREAM_BLOCK : hi;
+        if (prefetch > 0)
+            scan_prefetch((const char *)(a + i) + prefetch, (end - i) * (long)sizeof(int), nt);
+        fn(a, i, end, vmin, vmax);
+    }
+}
+
+/* ---- Typed kernels (MINMAX_TYPES element types) ----
+ *
+ * Same contract as scan_minmax_fn, except that idx < 0 marks an empty
+ * candidate: the first non-NaN element always replaces it. NaNs are never
+ * reported. There are two variants: scalar and AVX2 (which AVX-512 hosts
+ * use as well); typed_scan_kernels() follows the scan_kernels() choice.
+ */
+#define SCAN_DECLARE_TYPED(sfx, T) \
+    typedef struct { T val; long idx; } ValIdx_##sfx; \
+    typedef void (*scan_##sfx##_fn)(const T *a, long lo, long hi, \
+                                    ValIdx_##sfx *vmin, ValIdx_##sfx *vmax);
+MINMAX_TYPES(SCAN_DECLARE_TYPED)
+
+#define SCAN_TYPED_FIELD(sfx, T) scan_##sfx##_fn sfx;
+typedef struct {
+    const char *name;
+    MINMAX_TYPES(SCAN_TYPED_FIELD)
+} TypedScanKernels;
+#undef SCAN_TYPED_FIELD
+
+extern const TypedScanKernels typed_scan_kernels_scalar;
+extern const TypedScanKernels typed_scan_kernels_avx2;
+
+const TypedScanKernels *typed_scan_kernels(void);
+
+/* Elements per typed SIMD block (value pass, then index recovery): 16 KB */
+#define SCAN_TYPED_BLOCK_BYTES 16384
+
+/*
+ * scan_tail_<sfx>(): scalar fold of a[lo..hi), the whole scalar variant
+ * and the tail of the vector one. x != x is the NaN test; it folds away
+ * for integer types.
+ */
+#define SCAN_DEFINE_TYPED_TAIL(sfx, T) \
+static inline void scan_tail_##sfx(const T *a, long lo, long hi, \
+                                   ValIdx_##sfx *vmin, ValIdx_##sfx *vmax) \
+{ \
+    long i = lo; \
+    if (vmin->idx < 0 || vmax->idx < 0) { \
+        while (i < hi && a[i] != a[i]) i++; \
+        if (i == hi) return; \
+        if (vmin->idx < 0) { vmin->val = a[i]; vmin->idx = i; } \
+        if (vmax->idx < 0) { vmax->val = a[i]; vmax->idx = i; } \
+    } \
+    for (; i < hi; i++) { \
+        T val = a[i]; \
+        if (val < vmin->val) { vmin->val = val; vmin->idx = i; } \
+        if (val > vmax->val) { vmax->val = val; vmax->idx = i; } \
+    } \
+}
+MINMAX_TYPES(SCAN_DEFINE_TYPED_TAIL)
+
+#endif /* SCAN_H */
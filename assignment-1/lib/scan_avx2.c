@@ -0,0 +1,183 @@
+/*
+ * AVX2 min/max-with-location kernel: 8 ints per instruction using
+ * _mm256_cmpgt_epi32 + _mm256_blendv_epi8. This is the kernel that used to
+ * live inside novel_ultimate.c / novel_simd_avx2.c.
+ *
+ * The last 1-7 elements go through one _mm256_maskload_epi32 instead of a
+ * scalar loop. Short, ragged rows are common (ROI queries scan k0..k1 of
+ * each parent row), so the tail would otherwise dominate those rows.
+ *
+ * scan_stream_avx2() is the MINMAX_STREAM loop: four accumulator sets,
+ * aligned (optionally non-temporal) loads and a software prefetch distance.
+ *
+ * Compile with: -mavx2
+ */
+#include "scan.h"
+#include <immintrin.h>
+#include <limits.h>
+#include <stdint.h>
+
+static void scan_minmax_avx2(const int *a, long lo, long hi,
+                             ValIdx *vmin, ValIdx *vmax)
+{
+    long i = lo;
+
+    while (hi - i >= 8) {
+        long len = (hi - i) & ~7L;
+        if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+        const int *p = a + i;
+
+        __m256i vmin_val = _mm256_set1_epi32(vmin->val);
+        __m256i vmax_val = _mm256_set1_epi32(vmax->val);
+        __m256i vmin_off = _mm256_setzero_si256();
+        __m256i vmax_off = _mm256_setzero_si256();
+        __m256i vcur_off = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i vinc     = _mm256_set1_epi32(8);
+
+        for (long k = 0; k < len; k += 8) {
+            __m256i vdata = _mm256_loadu_si256((const __m256i *)(p + k));
+
+            /* Min update */
+            __m256i min_mask = _mm256_cmpgt_epi32(vmin_val, vdata);
+            vmin_val = _mm256_blendv_epi8(vmin_val, vdata, min_mask);
+            vmin_off = _mm256_blendv_epi8(vmin_off, vcur_off, min_mask);
+
+            /* Max update */
+            __m256i max_mask = _mm256_cmpgt_epi32(vdata, vmax_val);
+            vmax_val = _mm256_blendv_epi8(vmax_val, vdata, max_mask);
+            vmax_off = _mm256_blendv_epi8(vmax_off, vcur_off, max_mask);
+
+            vcur_off = _mm256_add_epi32(vcur_off, vinc);
+        }
+
+        /* Horizontal reduction across 8 lanes */
+        int vals[8], offs[8];
+        _mm256_storeu_si256((__m256i *)vals, vmin_val);
+        _mm256_storeu_si256((__m256i *)offs, vmin_off);
+        scan_fold_lanes(vals, offs, 8, i, vmin, 1);
+        _mm256_storeu_si256((__m256i *)vals, vmax_val);
+        _mm256_storeu_si256((__m256i *)offs, vmax_off);
+        scan_fold_lanes(vals, offs, 8, i, vmax, 0);
+
+        i += len;
+    }
+
+    /* Masked tail: inactive lanes read as the identity and cannot win */
+    if (i < hi) {
+        int r = (int)(hi - i);
+        __m256i lane  = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i live  = _mm256_cmpgt_epi32(_mm256_set1_epi32(r), lane);
+        __m256i vdata = _mm256_maskload_epi32(a + i, live);
+
+        int vals[8], offs[8];
+        _mm256_storeu_si256((__m256i *)offs, lane);
+        _mm256_storeu_si256((__m256i *)vals,
+                            _mm256_blendv_epi8(_mm256_set1_epi32(INT_MAX), vdata, live));
+        scan_fold_lanes(vals, offs, 8, i, vmin, 1);
+        _mm256_storeu_si256((__m256i *)vals,
+                            _mm256_blendv_epi8(_mm256_set1_epi32(INT_MIN), vdata, live));
+        scan_fold_lanes(vals, offs, 8, i, vmax, 0);
+    }
+}
+
+/*
+ * Streaming loop: SCAN_STREAM_ACC accumulator sets, set s taking vector s
+ * of every 32-element step, so the four compare/min/blend chains run in
+ * parallel instead of each waiting on the last. Values use min/max (one
+ * uop) and only the offsets are blended; the offset registers hold the
+ * step number, lane l of set s at step n being element n*32 + s*8 + l.
+ * Loads are aligned (MOVNTDQA requires it); i must be 32 B aligned.
+ */
+#define STREAM_STEP (8 * SCAN_STREAM_ACC)
+
+static inline __attribute__((always_inline))
+long stream_loop_avx2(const int *a, long i, long hi, long prefetch, int nt,
+                      ValIdx *vmin, ValIdx *vmax)
+{
+    while (hi - i >= STREAM_STEP) {
+        long len = (hi - i) / STREAM_STEP * STREAM_STEP;
+        if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+        const int *p = a + i;
+
+        __m256i mn[SCAN_STREAM_ACC], mx[SCAN_STREAM_ACC];
+        __m256i mn_at[SCAN_STREAM_ACC], mx_at[SCAN_STREAM_ACC];
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            mn[s] = _mm256_set1_epi32(vmin->val);
+            mx[s] = _mm256_set1_epi32(vmax->val);
+            mn_at[s] = mx_at[s] = _mm256_setzero_si256();
+        }
+        __m256i step = _mm256_setzero_si256();
+        __m256i one  = _mm256_set1_epi32(1);
+
+        for (long k = 0; k < len; k += STREAM_STEP) {
+            if (prefetch > 0)
+                scan_prefetch((const char *)(p + k) + prefetch, STREAM_STEP * sizeof(int), nt);
+            #pragma GCC unroll 4
+            for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+                __m256i *src = (__m256i *)(p + k + 8 * s);
+                __m256i vdata = nt ? _mm256_stream_load_si256(src) : _mm256_load_si256(src);
+
+                __m256i lt = _mm256_cmpgt_epi32(mn[s], vdata);
+                mn[s] = _mm256_min_epi32(mn[s], vdata);
+                mn_at[s] = _mm256_blendv_epi8(mn_at[s], step, lt);
+
+                __m256i gt = _mm256_cmpgt_epi32(vdata, mx[s]);
+                mx[s] = _mm256_max_epi32(mx[s], vdata);
+                mx_at[s] = _mm256_blendv_epi8(mx_at[s], step, gt);
+            }
+            step = _mm256_add_epi32(step, one);
+        }
+
+        int vals[STREAM_STEP], offs[STREAM_STEP];
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            _mm256_storeu_si256((__m256i *)(vals + 8 * s), mn[s]);
+            _mm256_storeu_si256((__m256i *)(offs + 8 * s), mn_at[s]);
+        }
+        for (int l = 0; l < STREAM_STEP; l++)
+            offs[l] = offs[l] * STREAM_STEP + l;
+        scan_fold_lanes(vals, offs, STREAM_STEP, i, vmin, 1);
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            _mm256_storeu_si256((__m256i *)(vals + 8 * s), mx[s]);
+            _mm256_storeu_si256((__m256i *)(offs + 8 * s), mx_at[s]);
+        }
+        for (int l = 0; l < STREAM_STEP; l++)
+            offs[l] = offs[l] * STREAM_STEP + l;
+        scan_fold_lanes(vals, offs, STREAM_STEP, i, vmax, 0);
+
+        i += len;
+    }
+    return i;
+}
+
+static void scan_stream_avx2(const int *a, long lo, long hi, long prefetch, int nt,
+                             ValIdx *vmin, ValIdx *vmax)
+{
+    /* Unaligned head (and an int array that is not even 4 B aligned) */
+    long head = (long)((-(uintptr_t)(a + lo) & 31) / sizeof(int));
+    if (((uintptr_t)a & 3) || head >= hi - lo) {
+        scan_minmax_avx2(a, lo, hi, vmin, vmax);
+        return;
+    }
+    scan_minmax_avx2(a, lo, lo + head, vmin, vmax);
+
+    long i = nt ? stream_loop_avx2(a, lo + head, hi, prefetch, 1, vmin, vmax)
+                : stream_loop_avx2(a, lo + head, hi, prefetch, 0, vmin, vmax);
+    scan_minmax_avx2(a, i, hi, vmin, vmax);
+}
+
+/* cmpeq + movemask over 8 lanes, ctz on the first non-zero mask */
+static long scan_find_avx2(const int *a, long lo, long hi, int val)
+{
+    __m256i vval = _mm256_set1_epi32(val);
+    long i = lo;
+    for (; i + 8 <= hi; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a + i)), vval);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask)
+            return i + __builtin_ctz((unsigned)mask);
+    }
+    return scan_find_tail(a, i, hi, val);
+}
+
+const ScanKernels scan_kernels_avx2 = { "avx2", scan_minmax_avx2, scan_stream_avx2,
+                                        scan_find_avx2 };
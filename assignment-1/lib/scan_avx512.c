@@ -0,0 +1,180 @@
+/*
+ * AVX-512F min/max-with-location kernel: 16 ints per instruction.
+ *
+ * Compares produce __mmask16 values directly and the selects are
+ * _mm512_mask_blend_epi32 on mask registers, so there is no blendv and no
+ * vector-register mask to materialise. The tail (< 16 elements) is handled
+ * by the same loop with a masked load and masked compares instead of a
+ * scalar epilogue. Lanes are folded with the reduce intrinsics rather than
+ * scan_fold_lanes(), which matters for short runs (ROI row segments).
+ * scan_stream_avx512() is the MINMAX_STREAM loop (see scan_avx2.c).
+ *
+ * Compile with: -mavx512f
+ */
+#include "scan.h"
+#include <immintrin.h>
+#include <stdint.h>
+
+static void scan_minmax_avx512(const int *a, long lo, long hi,
+                               ValIdx *vmin, ValIdx *vmax)
+{
+    long i = lo;
+
+    while (i < hi) {
+        long len = hi - i;
+        if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+        const int *p = a + i;
+
+        __m512i vmin_val = _mm512_set1_epi32(vmin->val);
+        __m512i vmax_val = _mm512_set1_epi32(vmax->val);
+        __m512i vmin_off = _mm512_setzero_si512();
+        __m512i vmax_off = _mm512_setzero_si512();
+        __m512i vcur_off = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                             8, 9, 10, 11, 12, 13, 14, 15);
+        __m512i vinc     = _mm512_set1_epi32(16);
+
+        long simd_end = len & ~15L;
+        long k;
+        for (k = 0; k < simd_end; k += 16) {
+            __m512i vdata = _mm512_loadu_si512((const void *)(p + k));
+
+            __mmask16 min_mask = _mm512_cmplt_epi32_mask(vdata, vmin_val);
+            vmin_val = _mm512_mask_blend_epi32(min_mask, vmin_val, vdata);
+            vmin_off = _mm512_mask_blend_epi32(min_mask, vmin_off, vcur_off);
+
+            __mmask16 max_mask = _mm512_cmpgt_epi32_mask(vdata, vmax_val);
+            vmax_val = _mm512_mask_blend_epi32(max_mask, vmax_val, vdata);
+            vmax_off = _mm512_mask_blend_epi32(max_mask, vmax_off, vcur_off);
+
+            vcur_off = _mm512_add_epi32(vcur_off, vinc);
+        }
+
+        if (k < len) {
+            __mmask16 tail = (__mmask16)((1u << (len - k)) - 1);
+            __m512i vdata = _mm512_maskz_loadu_epi32(tail, (const void *)(p + k));
+
+            __mmask16 min_mask = _mm512_mask_cmplt_epi32_mask(tail, vdata, vmin_val);
+            vmin_val = _mm512_mask_blend_epi32(min_mask, vmin_val, vdata);
+            vmin_off = _mm512_mask_blend_epi32(min_mask, vmin_off, vcur_off);
+
+            __mmask16 max_mask = _mm512_mask_cmpgt_epi32_mask(tail, vdata, vmax_val);
+            vmax_val = _mm512_mask_blend_epi32(max_mask, vmax_val, vdata);
+            vmax_off = _mm512_mask_blend_epi32(max_mask, vmax_off, vcur_off);
+        }
+
+        /* Lane fold in registers: extreme value, then the smallest offset
+         * among the lanes holding it (no store/reload, no branches) */
+        int bmin = _mm512_reduce_min_epi32(vmin_val);
+        __mmask16 at_min = _mm512_cmpeq_epi32_mask(vmin_val, _mm512_set1_epi32(bmin));
+        if (bmin < vmin->val) {
+            vmin->val = bmin;
+            vmin->idx = i + _mm512_mask_reduce_min_epi32(at_min, vmin_off);
+        }
+        int bmax = _mm512_reduce_max_epi32(vmax_val);
+        __mmask16 at_max = _mm512_cmpeq_epi32_mask(vmax_val, _mm512_set1_epi32(bmax));
+        if (bmax > vmax->val) {
+            vmax->val = bmax;
+            vmax->idx = i + _mm512_mask_reduce_min_epi32(at_max, vmax_off);
+        }
+
+        i += len;
+    }
+}
+
+/*
+ * Streaming loop, as in scan_avx2.c: SCAN_STREAM_ACC accumulator sets over
+ * 64-element steps (four cache lines), offsets as step numbers, aligned
+ * or MOVNTDQA loads; i must be 64 B aligned.
+ */
+#define STREAM_STEP (16 * SCAN_STREAM_ACC)
+
+static inline __attribute__((always_inline))
+long stream_loop_avx512(const int *a, long i, long hi, long prefetch, int nt,
+                        ValIdx *vmin, ValIdx *vmax)
+{
+    while (hi - i >= STREAM_STEP) {
+        long len = (hi - i) / STREAM_STEP * STREAM_STEP;
+        if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+        const int *p = a + i;
+
+        __m512i mn[SCAN_STREAM_ACC], mx[SCAN_STREAM_ACC];
+        __m512i mn_at[SCAN_STREAM_ACC], mx_at[SCAN_STREAM_ACC];
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            mn[s] = _mm512_set1_epi32(vmin->val);
+            mx[s] = _mm512_set1_epi32(vmax->val);
+            mn_at[s] = mx_at[s] = _mm512_setzero_si512();
+        }
+        __m512i step = _mm512_setzero_si512();
+        __m512i one  = _mm512_set1_epi32(1);
+
+        for (long k = 0; k < len; k += STREAM_STEP) {
+            if (prefetch > 0)
+                scan_prefetch((const char *)(p + k) + prefetch, STREAM_STEP * sizeof(int), nt);
+            #pragma GCC unroll 4
+            for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+                void *src = (void *)(p + k + 16 * s);
+                __m512i vdata = nt ? _mm512_stream_load_si512(src) : _mm512_load_si512(src);
+
+                __mmask16 lt = _mm512_cmplt_epi32_mask(vdata, mn[s]);
+                mn[s] = _mm512_min_epi32(mn[s], vdata);
+                mn_at[s] = _mm512_mask_mov_epi32(mn_at[s], lt, step);
+
+                __mmask16 gt = _mm512_cmpgt_epi32_mask(vdata, mx[s]);
+                mx[s] = _mm512_max_epi32(mx[s], vdata);
+                mx_at[s] = _mm512_mask_mov_epi32(mx_at[s], gt, step);
+            }
+            step = _mm512_add_epi32(step, one);
+        }
+
+        int vals[STREAM_STEP], offs[STREAM_STEP];
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            _mm512_storeu_si512((void *)(vals + 16 * s), mn[s]);
+            _mm512_storeu_si512((void *)(offs + 16 * s), mn_at[s]);
+        }
+        for (int l = 0; l < STREAM_STEP; l++)
+            offs[l] = offs[l] * STREAM_STEP + l;
+        scan_fold_lanes(vals, offs, STREAM_STEP, i, vmin, 1);
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            _mm512_storeu_si512((void *)(vals + 16 * s), mx[s]);
+            _mm512_storeu_si512((void *)(offs + 16 * s), mx_at[s]);
+        }
+        for (int l = 0; l < STREAM_STEP; l++)
+            offs[l] = offs[l] * STREAM_STEP + l;
+        scan_fold_lanes(vals, offs, STREAM_STEP, i, vmax, 0);
+
+        i += len;
+    }
+    return i;
+}
+
+static void scan_stream_avx512(const int *a, long lo, long hi, long prefetch, int nt,
+                               ValIdx *vmin, ValIdx *vmax)
+{
+    long head = (long)((-(uintptr_t)(a + lo) & 63) / sizeof(int));
+    if (((uintptr_t)a & 3) || head >= hi - lo) {
+        scan_minmax_avx512(a, lo, hi, vmin, vmax);
+        return;
+    }
+    scan_minmax_avx512(a, lo, lo + head, vmin, vmax);
+
+    long i = nt ? stream_loop_avx512(a, lo + head, hi, prefetch, 1, vmin, vmax)
+                : stream_loop_avx512(a, lo + head, hi, prefetch, 0, vmin, vmax);
+    scan_minmax_avx512(a, i, hi, vmin, vmax);
+}
+
+/* Compares straight into a mask register; the tail is one masked load */
+static long scan_find_avx512(const int *a, long lo, long hi, int val)
+{
+    __m512i vval = _mm512_set1_epi32(val);
+    for (long i = lo; i < hi; i += 16) {
+        __mmask16 live = hi - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (hi - i)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(live, a + i);
+        __mmask16 eq = _mm512_mask_cmpeq_epi32_mask(live, v, vval);
+        if (eq)
+            return i + __builtin_ctz((unsigned)eq);
+    }
+    return hi;
+}
+
+const ScanKernels scan_kernels_avx512 = { "avx512", scan_minmax_avx512, scan_stream_avx512,
+                                          scan_find_avx512 };
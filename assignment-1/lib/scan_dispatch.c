@@ -0,0 +1,98 @@
+/*
+ * Runtime selection of the min/max scan kernels.
+ *
+ * The table is resolved once, before main() runs, so kernels can be fetched
+ * from inside parallel regions without any synchronisation:
+ *   x86-64  — cpuid via __builtin_cpu_supports(): AVX-512F > AVX2 > SSE4.1
+ *   AArch64 — getauxval(AT_HWCAP) & HWCAP_ASIMD: NEON
+ *   other   — scalar
+ *
+ * MINMAX_ISA=<name> forces a specific variant (e.g. to compare them on one
+ * machine); an unknown or unsupported name falls back to auto-detection.
+ *
+ * The typed kernels (scan_typed_*.c) follow the same choice: avx2 on hosts
+ * that picked avx2 or avx512, scalar everywhere else.
+ */
+#include "scan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+static const ScanKernels *selected = &scan_kernels_scalar;
+static const TypedScanKernels *typed_selected = &typed_scan_kernels_scalar;
+
+static int isa_supported(const ScanKernels *k)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (k == &scan_kernels_avx512) return __builtin_cpu_supports("avx512f");
+    if (k == &scan_kernels_avx2)   return __builtin_cpu_supports("avx2");
+    if (k == &scan_kernels_sse41)  return __builtin_cpu_supports("sse4.1");
+#elif defined(__aarch64__)
+    if (k == &scan_kernels_neon)   return (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+#endif
+    return k == &scan_kernels_scalar;
+}
+
+/* Candidates in order of preference for this architecture */
+static const ScanKernels *const candidates[] = {
+#if defined(__x86_64__) || defined(__i386__)
+    &scan_kernels_avx512,
+    &scan_kernels_avx2,
+    &scan_kernels_sse41,
+#elif defined(__aarch64__)
+    &scan_kernels_neon,
+#endif
+    &scan_kernels_scalar,
+};
+
+static void use_kernels(const ScanKernels *k)
+{
+    selected = k;
+#if defined(__x86_64__) || defined(__i386__)
+    if (k == &scan_kernels_avx512 || k == &scan_kernels_avx2)
+        typed_selected = &typed_scan_kernels_avx2;
+#endif
+}
+
+__attribute__((constructor))
+static void scan_select(void)
+{
+    int n = (int)(sizeof(candidates) / sizeof(candidates[0]));
+
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+#endif
+
+    const char *force = getenv("MINMAX_ISA");
+    if (force && *force) {
+        for (int c = 0; c < n; c++) {
+            if (strcmp(force, candidates[c]->name) == 0 && isa_supported(candidates[c])) {
+                use_kernels(candidates[c]);
+                return;
+            }
+        }
+        fprintf(stderr, "MINMAX_ISA=%s not available on this host, auto-detecting\n", force);
+    }
+
+    for (int c = 0; c < n; c++) {
+        if (isa_supported(candidates[c])) {
+            use_kernels(candidates[c]);
+            return;
+        }
+    }
+}
+
+const ScanKernels *scan_kernels(void)
+{
+    return selected;
+}
+
+const TypedScanKernels *typed_scan_kernels(void)
+{
+    return typed_selected;
+}
@@ -0,0 +1,74 @@
+/*
+ * NEON (AArch64 Advanced SIMD) min/max-with-location kernel: 4 ints per
+ * instruction using vcltq_s32/vcgtq_s32 + vbslq_s32.
+ *
+ * NEON is mandatory on AArch64, so no extra compiler flags are needed.
+ */
+#include "scan.h"
+#include <arm_neon.h>
+
+static void scan_minmax_neon(const int *a, long lo, long hi,
+                             ValIdx *vmin, ValIdx *vmax)
+{
+    static const int lane_off[4] = { 0, 1, 2, 3 };
+    long i = lo;
+
+    while (hi - i >= 4) {
+        long len = (hi - i) & ~3L;
+        if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+        const int *p = a + i;
+
+        int32x4_t vmin_val = vdupq_n_s32(vmin->val);
+        int32x4_t vmax_val = vdupq_n_s32(vmax->val);
+        int32x4_t vmin_off = vdupq_n_s32(0);
+        int32x4_t vmax_off = vdupq_n_s32(0);
+        int32x4_t vcur_off = vld1q_s32(lane_off);
+        int32x4_t vinc     = vdupq_n_s32(4);
+
+        for (long k = 0; k < len; k += 4) {
+            int32x4_t vdata = vld1q_s32(p + k);
+
+            uint32x4_t min_mask = vcltq_s32(vdata, vmin_val);
+            vmin_val = vbslq_s32(min_mask, vdata, vmin_val);
+            vmin_off = vbslq_s32(min_mask, vcur_off, vmin_off);
+
+            uint32x4_t max_mask = vcgtq_s32(vdata, vmax_val);
+            vmax_val = vbslq_s32(max_mask, vdata, vmax_val);
+            vmax_off = vbslq_s32(max_mask, vcur_off, vmax_off);
+
+            vcur_off = vaddq_s32(vcur_off, vinc);
+        }
+
+        int vals[4], offs[4];
+        vst1q_s32(vals, vmin_val);
+        vst1q_s32(offs, vmin_off);
+        scan_fold_lanes(vals, offs, 4, i, vmin, 1);
+        vst1q_s32(vals, vmax_val);
+        vst1q_s32(offs, vmax_off);
+        scan_fold_lanes(vals, offs, 4, i, vmax, 0);
+
+        i += len;
+    }
+
+    scan_tail(a, i, hi, vmin, vmax);
+}
+
+/* NEON has no non-temporal load; nt selects PLDL1STRM prefetches */
+static void scan_stream_neon(const int *a, long lo, long hi, long prefetch, int nt,
+                             ValIdx *vmin, ValIdx *vmax)
+{
+    scan_stream_blocks(scan_minmax_neon, a, lo, hi, prefetch, nt, vmin, vmax);
+}
+
+static long scan_find_neon(const int *a, long lo, long hi, int val)
+{
+    int32x4_t vval = vdupq_n_s32(val);
+    long i = lo;
+    for (; i + 4 <= hi; i += 4)
+        if (vmaxvq_u32(vceqq_s32(vld1q_s32(a + i), vval)))
+            break;
+    return scan_find_tail(a, i, hi, val);
+}
+
+const ScanKernels scan_kernels_neon = { "neon", scan_minmax_neon, scan_stream_neon,
+                                        scan_find_neon };
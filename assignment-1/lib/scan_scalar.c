@@ -0,0 +1,21 @@
+/*
+ * Portable scalar min/max-with-location kernel. Used on hosts without any
+ * supported SIMD extension and as the reference the vector variants must
+ * match.
+ */
+#include "scan.h"
+
+static void scan_minmax_scalar(const int *a, long lo, long hi,
+                               ValIdx *vmin, ValIdx *vmax)
+{
+    scan_tail(a, lo, hi, vmin, vmax);
+}
+
+static void scan_stream_scalar(const int *a, long lo, long hi, long prefetch, int nt,
+                               ValIdx *vmin, ValIdx *vmax)
+{
+    scan_stream_blocks(scan_minmax_scalar, a, lo, hi, prefetch, nt, vmin, vmax);
+}
+
+const ScanKernels scan_kernels_scalar = { "scalar", scan_minmax_scalar, scan_stream_scalar,
+                                          scan_find_tail };
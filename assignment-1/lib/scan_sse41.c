@@ -0,0 +1,152 @@
+/*
+ * SSE4.1 min/max-with-location kernel: 4 ints per instruction using
+ * _mm_cmpgt_epi32 + _mm_blendv_epi8 (the blend is the SSE4.1 part).
+ * scan_stream_sse41() is the MINMAX_STREAM loop (see scan_avx2.c).
+ *
+ * Compile with: -msse4.1
+ */
+#include "scan.h"
+#include <smmintrin.h>
+#include <stdint.h>
+
+static void scan_minmax_sse41(const int *a, long lo, long hi,
+                              ValIdx *vmin, ValIdx *vmax)
+{
+    long i = lo;
+
+    while (hi - i >= 4) {
+        long len = (hi - i) & ~3L;
+        if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+        const int *p = a + i;
+
+        __m128i vmin_val = _mm_set1_epi32(vmin->val);
+        __m128i vmax_val = _mm_set1_epi32(vmax->val);
+        __m128i vmin_off = _mm_setzero_si128();
+        __m128i vmax_off = _mm_setzero_si128();
+        __m128i vcur_off = _mm_setr_epi32(0, 1, 2, 3);
+        __m128i vinc     = _mm_set1_epi32(4);
+
+        for (long k = 0; k < len; k += 4) {
+            __m128i vdata = _mm_loadu_si128((const __m128i *)(p + k));
+
+            __m128i min_mask = _mm_cmpgt_epi32(vmin_val, vdata);
+            vmin_val = _mm_blendv_epi8(vmin_val, vdata, min_mask);
+            vmin_off = _mm_blendv_epi8(vmin_off, vcur_off, min_mask);
+
+            __m128i max_mask = _mm_cmpgt_epi32(vdata, vmax_val);
+            vmax_val = _mm_blendv_epi8(vmax_val, vdata, max_mask);
+            vmax_off = _mm_blendv_epi8(vmax_off, vcur_off, max_mask);
+
+            vcur_off = _mm_add_epi32(vcur_off, vinc);
+        }
+
+        int vals[4], offs[4];
+        _mm_storeu_si128((__m128i *)vals, vmin_val);
+        _mm_storeu_si128((__m128i *)offs, vmin_off);
+        scan_fold_lanes(vals, offs, 4, i, vmin, 1);
+        _mm_storeu_si128((__m128i *)vals, vmax_val);
+        _mm_storeu_si128((__m128i *)offs, vmax_off);
+        scan_fold_lanes(vals, offs, 4, i, vmax, 0);
+
+        i += len;
+    }
+
+    scan_tail(a, i, hi, vmin, vmax);
+}
+
+/*
+ * Streaming loop, as in scan_avx2.c: SCAN_STREAM_ACC accumulator sets over
+ * 16-element steps (one cache line), offsets as step numbers, aligned or
+ * MOVNTDQA loads (_mm_stream_load_si128 is SSE4.1); i must be 16 B aligned.
+ */
+#define STREAM_STEP (4 * SCAN_STREAM_ACC)
+
+static inline __attribute__((always_inline))
+long stream_loop_sse41(const int *a, long i, long hi, long prefetch, int nt,
+                       ValIdx *vmin, ValIdx *vmax)
+{
+    while (hi - i >= STREAM_STEP) {
+        long len = (hi - i) / STREAM_STEP * STREAM_STEP;
+        if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+        const int *p = a + i;
+
+        __m128i mn[SCAN_STREAM_ACC], mx[SCAN_STREAM_ACC];
+        __m128i mn_at[SCAN_STREAM_ACC], mx_at[SCAN_STREAM_ACC];
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            mn[s] = _mm_set1_epi32(vmin->val);
+            mx[s] = _mm_set1_epi32(vmax->val);
+            mn_at[s] = mx_at[s] = _mm_setzero_si128();
+        }
+        __m128i step = _mm_setzero_si128();
+        __m128i one  = _mm_set1_epi32(1);
+
+        for (long k = 0; k < len; k += STREAM_STEP) {
+            if (prefetch > 0)
+                scan_prefetch((const char *)(p + k) + prefetch, STREAM_STEP * sizeof(int), nt);
+            #pragma GCC unroll 4
+            for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+                __m128i *src = (__m128i *)(p + k + 4 * s);
+                __m128i vdata = nt ? _mm_stream_load_si128(src) : _mm_load_si128(src);
+
+                __m128i lt = _mm_cmpgt_epi32(mn[s], vdata);
+                mn[s] = _mm_min_epi32(mn[s], vdata);
+                mn_at[s] = _mm_blendv_epi8(mn_at[s], step, lt);
+
+                __m128i gt = _mm_cmpgt_epi32(vdata, mx[s]);
+                mx[s] = _mm_max_epi32(mx[s], vdata);
+                mx_at[s] = _mm_blendv_epi8(mx_at[s], step, gt);
+            }
+            step = _mm_add_epi32(step, one);
+        }
+
+        int vals[STREAM_STEP], offs[STREAM_STEP];
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            _mm_storeu_si128((__m128i *)(vals + 4 * s), mn[s]);
+            _mm_storeu_si128((__m128i *)(offs + 4 * s), mn_at[s]);
+        }
+        for (int l = 0; l < STREAM_STEP; l++)
+            offs[l] = offs[l] * STREAM_STEP + l;
+        scan_fold_lanes(vals, offs, STREAM_STEP, i, vmin, 1);
+        for (int s = 0; s < SCAN_STREAM_ACC; s++) {
+            _mm_storeu_si128((__m128i *)(vals + 4 * s), mx[s]);
+            _mm_storeu_si128((__m128i *)(offs + 4 * s), mx_at[s]);
+        }
+        for (int l = 0; l < STREAM_STEP; l++)
+            offs[l] = offs[l] * STREAM_STEP + l;
+        scan_fold_lanes(vals, offs, STREAM_STEP, i, vmax, 0);
+
+        i += len;
+    }
+    return i;
+}
+
+static void scan_stream_sse41(const int *a, long lo, long hi, long prefetch, int nt,
+                              ValIdx *vmin, ValIdx *vmax)
+{
+    long head = (long)((-(uintptr_t)(a + lo) & 15) / sizeof(int));
+    if (((uintptr_t)a & 3) || head >= hi - lo) {
+        scan_minmax_sse41(a, lo, hi, vmin, vmax);
+        return;
+    }
+    scan_minmax_sse41(a, lo, lo + head, vmin, vmax);
+
+    long i = nt ? stream_loop_sse41(a, lo + head, hi, prefetch, 1, vmin, vmax)
+                : stream_loop_sse41(a, lo + head, hi, prefetch, 0, vmin, vmax);
+    scan_minmax_sse41(a, i, hi, vmin, vmax);
+}
+
+static long scan_find_sse41(const int *a, long lo, long hi, int val)
+{
+    __m128i vval = _mm_set1_epi32(val);
+    long i = lo;
+    for (; i + 4 <= hi; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a + i)), vval);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask)
+            return i + __builtin_ctz((unsigned)mask);
+    }
+    return scan_find_tail(a, i, hi, val);
+}
+
+const ScanKernels scan_kernels_sse41 = { "sse4.1", scan_minmax_sse41, scan_stream_sse41,
+                                         scan_find_sse41 };
@@ -0,0 +1,150 @@
+/*
+ * AVX2 kernels for the MINMAX_TYPES element types.
+ *
+ * Narrow types cannot carry a per-lane index the way scan_avx2.c does (a
+ * uint8 lane has no room for one), so every type uses two passes per 16 KB
+ * block instead:
+ *   1. values only: one vertical min and one max per 32-byte load
+ *      (_mm256_min_epu16, _mm256_min_ps, ...; 32 lanes for 8-bit types,
+ *      16 for 16-bit), folded across lanes at the end of the block;
+ *   2. only if the block beats the running best (rare on random data),
+ *      re-scan it from L1 with cmpeq + movemask to find the first
+ *      position holding that value.
+ * Because the block value pass does no index bookkeeping, narrow types run
+ * at close to memory bandwidth: a uint16 volume is half the bytes of int32.
+ *
+ * AVX2 has no 64-bit min/max, so i64/u64 use cmpgt_epi64 + blendv (u64
+ * through a sign-bit bias). Floats use min_ps/max_ps with the accumulator
+ * as the second operand: a NaN element then yields the accumulator, i.e.
+ * NaNs are skipped, and equality with _CMP_EQ_OQ never matches one.
+ *
+ * Compile with: -mavx2
+ */
+#include "scan.h"
+#include <immintrin.h>
+#include <math.h>
+
+/* ---- Per-type vertical min / max / equality on __m256i ---- */
+
+#define INT_OPS(sfx, w, sign)                                                          \
+static inline __m256i sfx##_vmin(__m256i v, __m256i acc) { return _mm256_min_##sign##w(v, acc); } \
+static inline __m256i sfx##_vmax(__m256i v, __m256i acc) { return _mm256_max_##sign##w(v, acc); } \
+static inline __m256i sfx##_veq(__m256i v, __m256i b)    { return _mm256_cmpeq_epi##w(v, b); }
+
+INT_OPS(i8,  8,  epi)
+INT_OPS(u8,  8,  epu)
+INT_OPS(i16, 16, epi)
+INT_OPS(u16, 16, epu)
+INT_OPS(i32, 32, epi)
+INT_OPS(u32, 32, epu)
+
+static inline __m256i i64_vmin(__m256i v, __m256i acc) { return _mm256_blendv_epi8(acc, v, _mm256_cmpgt_epi64(acc, v)); }
+static inline __m256i i64_vmax(__m256i v, __m256i acc) { return _mm256_blendv_epi8(acc, v, _mm256_cmpgt_epi64(v, acc)); }
+static inline __m256i i64_veq(__m256i v, __m256i b)    { return _mm256_cmpeq_epi64(v, b); }
+
+static inline __m256i u64_bias(__m256i v) { return _mm256_xor_si256(v, _mm256_set1_epi64x(INT64_MIN)); }
+static inline __m256i u64_vmin(__m256i v, __m256i acc) { return _mm256_blendv_epi8(acc, v, _mm256_cmpgt_epi64(u64_bias(acc), u64_bias(v))); }
+static inline __m256i u64_vmax(__m256i v, __m256i acc) { return _mm256_blendv_epi8(acc, v, _mm256_cmpgt_epi64(u64_bias(v), u64_bias(acc))); }
+static inline __m256i u64_veq(__m256i v, __m256i b)    { return _mm256_cmpeq_epi64(v, b); }
+
+#define FLOAT_OPS(sfx, x)                                                              \
+static inline __m256i sfx##_vmin(__m256i v, __m256i acc) {                             \
+    return _mm256_cast##x##_si256(_mm256_min_##x(_mm256_castsi256_##x(v), _mm256_castsi256_##x(acc))); } \
+static inline __m256i sfx##_vmax(__m256i v, __m256i acc) {                             \
+    return _mm256_cast##x##_si256(_mm256_max_##x(_mm256_castsi256_##x(v), _mm256_castsi256_##x(acc))); } \
+static inline __m256i sfx##_veq(__m256i v, __m256i b) {                                \
+    return _mm256_cast##x##_si256(_mm256_cmp_##x(_mm256_castsi256_##x(v), _mm256_castsi256_##x(b), _CMP_EQ_OQ)); }
+
+FLOAT_OPS(f32, ps)
+FLOAT_OPS(f64, pd)
+
+/* ---- Kernel template ---- */
+
+/*
+ * Broadcast one T into all lanes. Going through memory keeps this generic
+ * over the element width; it runs a few times per block, not per element.
+ */
+#define SPLAT(T, x, out) do {                                         \
+    T splat_[32 / sizeof(T)];                                         \
+    for (int l_ = 0; l_ < (int)(32 / sizeof(T)); l_++) splat_[l_] = (x); \
+    (out) = _mm256_loadu_si256((const __m256i *)splat_);              \
+} while (0)
+
+#define TYPED_AVX2(sfx, T, TMIN, TMAX)                                            \
+/* First index in a[lo..lo+len) equal to b, or -1 */                              \
+static long locate_##sfx(const T *a, long lo, long len, T b)                      \
+{                                                                                 \
+    enum { LANES = 32 / sizeof(T) };                                              \
+    __m256i vb;                                                                   \
+    SPLAT(T, b, vb);                                                              \
+    for (long k = 0; k < len; k += LANES) {                                       \
+        __m256i v = _mm256_loadu_si256((const __m256i *)(a + lo + k));            \
+        unsigned m = (unsigned)_mm256_movemask_epi8(sfx##_veq(v, vb));            \
+        if (m)                                                                    \
+            return lo + k + __builtin_ctz(m) / (int)sizeof(T);                    \
+    }                                                                             \
+    return -1;                                                                    \
+}                                                                                 \
+                                                                                  \
+static void scan_##sfx##_avx2(const T *a, long lo, long hi,                       \
+                              ValIdx_##sfx *vmin, ValIdx_##sfx *vmax)             \
+{                                                                                 \
+    enum { LANES = 32 / sizeof(T), BLOCK = SCAN_TYPED_BLOCK_BYTES / sizeof(T) };  \
+    __m256i vinit_min, vinit_max;                                                 \
+    SPLAT(T, TMAX, vinit_min);                                                    \
+    SPLAT(T, TMIN, vinit_max);                                                    \
+    long i = lo;                                                                  \
+                                                                                  \
+    while (hi - i >= LANES) {                                                     \
+        long len = hi - i < BLOCK ? (hi - i) & ~(long)(LANES - 1) : BLOCK;        \
+        const T *p = a + i;                                                       \
+                                                                                  \
+        /* Pass 1: block extremes, values only */                                 \
+        __m256i mn = vinit_min, mx = vinit_max;                                   \
+        for (long k = 0; k < len; k += LANES) {                                   \
+            __m256i v = _mm256_loadu_si256((const __m256i *)(p + k));             \
+            mn = sfx##_vmin(v, mn);                                               \
+            mx = sfx##_vmax(v, mx);                                               \
+        }                                                                         \
+        T lmin[LANES], lmax[LANES];                                               \
+        _mm256_storeu_si256((__m256i *)lmin, mn);                                 \
+        _mm256_storeu_si256((__m256i *)lmax, mx);                                 \
+        T bmin = lmin[0], bmax = lmax[0];                                         \
+        for (int l = 1; l < LANES; l++) {                                         \
+            if (lmin[l] < bmin) bmin = lmin[l];                                   \
+            if (lmax[l] > bmax) bmax = lmax[l];                                   \
+        }                                                                         \
+                                                                                  \
+        /* Pass 2: locate only blocks that improve on the running best. An */     \
+        /* all-NaN block finds nothing and leaves an empty candidate empty. */    \
+        if (vmin->idx < 0 || bmin < vmin->val) {                                  \
+            long at = locate_##sfx(a, i, len, bmin);                              \
+            if (at >= 0) { vmin->val = a[at]; vmin->idx = at; }                   \
+        }                                                                         \
+        if (vmax->idx < 0 || bmax > vmax->val) {                                  \
+            long at = locate_##sfx(a, i, len, bmax);                              \
+            if (at >= 0) { vmax->val = a[at]; vmax->idx = at; }                   \
+        }                                                                         \
+        i += len;                                                                 \
+    }                                                                             \
+                                                                                  \
+    scan_tail_##sfx(a, i, hi, vmin, vmax);                                        \
+}
+
+TYPED_AVX2(i8,  int8_t,   INT8_MIN,  INT8_MAX)
+TYPED_AVX2(u8,  uint8_t,  0,         UINT8_MAX)
+TYPED_AVX2(i16, int16_t,  INT16_MIN, INT16_MAX)
+TYPED_AVX2(u16, uint16_t, 0,         UINT16_MAX)
+TYPED_AVX2(i32, int32_t,  INT32_MIN, INT32_MAX)
+TYPED_AVX2(u32, uint32_t, 0,         UINT32_MAX)
+TYPED_AVX2(i64, int64_t,  INT64_MIN, INT64_MAX)
+TYPED_AVX2(u64, uint64_t, 0,         UINT64_MAX)
+TYPED_AVX2(f32, float,    -INFINITY, INFINITY)
+TYPED_AVX2(f64, double,   -INFINITY, INFINITY)
+
+const TypedScanKernels typed_scan_kernels_avx2 = {
+    .name = "avx2",
+#define AVX2_ENTRY(sfx, T) .sfx = scan_##sfx##_avx2,
+    MINMAX_TYPES(AVX2_ENTRY)
+#undef AVX2_ENTRY
+};
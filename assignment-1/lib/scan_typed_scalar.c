@@ -0,0 +1,12 @@
+/*
+ * Portable scalar kernels for the MINMAX_TYPES element types; the
+ * reference the AVX2 variants in scan_typed_avx2.c must match.
+ */
+#include "scan.h"
+
+const TypedScanKernels typed_scan_kernels_scalar = {
+    .name = "scalar",
+#define SCALAR_ENTRY(sfx, T) .sfx = scan_tail_##sfx,
+    MINMAX_TYPES(SCALAR_ENTRY)
+#undef SCALAR_ENTRY
+};
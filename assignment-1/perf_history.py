@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+"""
+Track bench results across commits and machines, flag regressions, draw rooflines.
+
+Usage: python perf_history.py record [--from FILE] [-- BENCH_ARGS...]
+       python perf_history.py baseline [--rev REV]
+       python perf_history.py compare [--rev REV] [--alpha A] [--threshold F]
+       python perf_history.py roofline [--rev REV] [--threads T]
+       python perf_history.py list
+
+record    runs ./bin/bench --json (or reads --from FILE, a bench --json
+          output) and appends it to perf_history.jsonl, keyed by git
+          revision (suffixed "+dirty" with uncommitted changes), host
+          fingerprint (CPU model, logical CPUs, memory, architecture),
+          problem shape and ISA. A later record with the same key replaces
+          the earlier one in every lookup.
+baseline  makes REV's records (default: the current revision) the baseline
+          for their host, shape and ISA, in perf_baselines.json.
+compare   tests every (version, threads) of REV against the baseline for the
+          same host, shape and ISA: a two-sided Mann-Whitney U test on the
+          timing samples, then REGRESSION if p < alpha (default 0.01) and the
+          median is more than threshold (default 0.05) slower. Exits 1 if a
+          regression or a wrong result is found.
+roofline  charts/roofline_<host>_<shape>_<isa>_<T>t.png (<host> is the
+          fingerprint) for REV at T threads (default: the largest count in
+          the record): achieved GOPS and GB/s against arithmetic intensity,
+          under the measured read and in-cache compute ceilings (requires
+          matplotlib).
+list      every stored record, baselines marked.
+"""
+
+import hashlib
+import json
+import math
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+HISTORY = "perf_history.jsonl"
+BASELINES = "perf_baselines.json"
+BENCH = os.path.join("bin", "bench")
+
+
+# ── Keys ──────────────────────────────────────────────────────────────────────
+
+def git_revision():
+    try:
+        rev = subprocess.check_output(["git", "rev-parse", "--short=12", "HEAD"],
+                                      stderr=subprocess.DEVNULL, text=True).strip()
+        dirty = subprocess.check_output(["git", "status", "--porcelain", "--untracked-files=no"],
+                                        stderr=subprocess.DEVNULL, text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+    return rev + ("+dirty" if dirty else "")
+
+
+def mem_total_kb():
+    try:
+        with open("/proc/meminfo") as f:
+            for line in f:
+                if line.startswith("MemTotal:"):
+                    return int(line.split()[1])
+    except OSError:
+        pass
+    return 0
+
+
+def host_info(bench_host):
+    """Host description and a short fingerprint that identifies the machine type."""
+    host = {
+        "cpu": bench_host.get("cpu", "unknown"),
+        "procs": bench_host.get("procs", 0),
+        "mem_gb": round(mem_total_kb() / 1048576),
+        "arch": platform.machine(),
+    }
+    text = "|".join(str(host[k]) for k in ("cpu", "procs", "mem_gb", "arch"))
+    host["fingerprint"] = hashlib.sha1(text.encode()).hexdigest()[:12]
+    return host
+
+
+def config_key(rec):
+    return "%s/%s/%s" % (rec["host"]["fingerprint"], rec["shape"], rec["isa"])
+
+
+# ── Storage ───────────────────────────────────────────────────────────────────
+
+def load_history():
+    if not os.path.exists(HISTORY):
+        return []
+    with open(HISTORY) as f:
+        return [json.loads(line) for line in f if line.strip()]
+
+
+def load_baselines():
+    if not os.path.exists(BASELINES):
+        return {}
+    with open(BASELINES) as f:
+        return json.load(f)
+
+
+def latest(history, rev):
+    """The last record of rev for every (host, shape, ISA)"""
+    out = {}
+    for rec in history:
+        if rec["rev"] == rev:
+            out[config_key(rec)] = rec
+    return out
+
+
+# ── Statistics ────────────────────────────────────────────────────────────────
+
+def mann_whitney(x, y):
+    """Two-sided Mann-Whitney U test, normal approximation with tie and
+    continuity corrections (fine from ~8 samples per side). Returns p."""
+    n1, n2 = len(x), len(y)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    pooled = sorted([(v, 0) for v in x] + [(v, 1) for v in y])
+    n = n1 + n2
+    ranks = [0.0] * n
+    ties = 0.0
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        mid = (i + j) / 2.0 + 1
+        for k in range(i, j + 1):
+            ranks[k] = mid
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+    r1 = sum(r for r, (_, g) in zip(ranks, pooled) if g == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+    mu = n1 * n2 / 2.0
+    var = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if var <= 0:
+        return 1.0
+    z = (abs(u1 - mu) - 0.5) / math.sqrt(var)
+    return min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2)))
+
+
+def fmt_p(p):
+    return "%.1e" % p if p < 0.001 else "%.3f" % p
+
+
+# ── Commands ──────────────────────────────────────────────────────────────────
+
+def cmd_record(args):
+    src = None
+    bench_args = []
+    if "--" in args:
+        bench_args = args[args.index("--") + 1:]
+        args = args[:args.index("--")]
+    if args[:1] == ["--from"] and len(args) > 1:
+        src = args[1]
+
+    tmp = src is None
+    if tmp:
+        fd, src = tempfile.mkstemp(suffix=".json")
+        os.close(fd)
+        cmd = [BENCH, "--json", src] + bench_args
+        print("Running", " ".join(cmd))
+        rc = subprocess.call(cmd)
+        if rc not in (0, 1):     # 1: a result disagreed, still worth recording
+            sys.exit("bench failed (exit %d)" % rc)
+    with open(src) as f:
+        run = json.load(f)
+    if tmp:
+        os.remove(src)
+
+    rec = {
+        "rev": git_revision(),
+        "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "host": host_info(run.get("host", {})),
+        "shape": run["shape"],
+        "isa": run["isa"],
+        "run": run,
+    }
+    with open(HISTORY, "a") as f:
+        f.write(json.dumps(rec, separators=(",", ":")) + "\n")
+    print("Recorded %s on %s (%s) for %s, %s: %d rows" %
+          (rec["rev"], rec["host"]["fingerprint"], rec["host"]["cpu"], rec["shape"],
+           rec["isa"], len(run["results"])))
+
+
+def cmd_baseline(args):
+    rev = args[1] if args[:1] == ["--rev"] and len(args) > 1 else git_revision()
+    recs = latest(load_history(), rev)
+    if not recs:
+        sys.exit("no records for revision %s" % rev)
+    base = load_baselines()
+    for key in recs:
+        base[key] = rev
+        print("Baseline for %s: %s" % (key, rev))
+    with open(BASELINES, "w") as f:
+        json.dump(base, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+
+def cmd_compare(args):
+    rev, alpha, threshold = git_revision(), 0.01, 0.05
+    i = 0
+    while i < len(args):
+        if args[i] == "--rev" and i + 1 < len(args):
+            rev = args[i + 1]
+        elif args[i] == "--alpha" and i + 1 < len(args):
+            alpha = float(args[i + 1])
+        elif args[i] == "--threshold" and i + 1 < len(args):
+            threshold = float(args[i + 1])
+        else:
+            sys.exit(__doc__)
+        i += 2
+
+    history = load_history()
+    base = load_baselines()
+    recs = latest(history, rev)
+    if not recs:
+        sys.exit("no records for revision %s" % rev)
+
+    failed = compared = 0
+    for key, rec in sorted(recs.items()):
+        if key not in base:
+            print("%s: no baseline (python perf_history.py baseline --rev REV)" % key)
+            continue
+        old = latest(history, base[key]).get(key)
+        if old is None:
+            print("%s: baseline %s has no record" % (key, base[key]))
+            continue
+        print("%s: %s vs baseline %s (alpha %.3g, threshold %+.0f%%)" %
+              (key, rev, base[key], alpha, 100 * threshold))
+        print("  %-22s %3s %11s %11s %8s %9s  %s" %
+              ("version", "T", "baseline", "current", "change", "p", "verdict"))
+        before = {(r["version"], r["threads"]): r for r in old["run"]["results"]}
+        for r in rec["run"]["results"]:
+            b = before.get((r["version"], r["threads"]))
+            if b is None:
+                continue
+            compared += 1
+            change = r["median"] / b["median"] - 1
+            p = mann_whitney(b.get("samples", []), r.get("samples", []))
+            verdict = ""
+            if not r.get("correct", True):
+                verdict = "WRONG RESULT"
+                failed += 1
+            elif p < alpha and change > threshold:
+                verdict = "REGRESSION"
+                failed += 1
+            elif p < alpha and change < -threshold:
+                verdict = "faster"
+            print("  %-22s %3d %11.6f %11.6f %+7.1f%% %9s  %s" %
+                  (r["version"], r["threads"], b["median"], r["median"], 100 * change,
+                   fmt_p(p), verdict))
+    print("%d rows compared, %d flagged" % (compared, failed))
+    sys.exit(1 if failed else 0)
+
+
+def cmd_list(args):
+    base = load_baselines()
+    for rec in load_history():
+        key = config_key(rec)
+        print("%-20s %s  %s  %-18s %-8s %3d rows%s" %
+              (rec["rev"], rec["date"], rec["host"]["fingerprint"], rec["shape"], rec["isa"],
+               len(rec["run"]["results"]), "  [baseline]" if base.get(key) == rec["rev"] else ""))
+
+
+def cmd_roofline(args):
+    rev, threads = git_revision(), None
+    i = 0
+    while i < len(args):
+        if args[i] == "--rev" and i + 1 < len(args):
+            rev = args[i + 1]
+        elif args[i] == "--threads" and i + 1 < len(args):
+            threads = int(args[i + 1])
+        else:
+            sys.exit(__doc__)
+        i += 2
+
+    import matplotlib
+    matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    recs = latest(load_history(), rev)
+    if not recs:
+        sys.exit("no records for revision %s" % rev)
+    os.makedirs("charts", exist_ok=True)
+
+    for key, rec in sorted(recs.items()):
+        run = rec["run"]
+        ops_elem = run.get("ops_per_element", 2)
+        bytes_elem = run.get("bytes_per_element", 4)
+        T = threads or max(r["threads"] for r in run["results"])
+        # The sequential baselines only run on one thread: keep them as reference points
+        rows = [r for r in run["results"] if r["threads"] == T or
+                (r["version"].startswith("sequential") and r["threads"] == 1)]
+        par = [r for r in rows if r["threads"] == T] or rows
+        if not rows or "peak_gops" not in rows[0]:
+            print("%s: record has no roofline fields (rebuild bench and record again)" % key)
+            continue
+        bw = max(r["peak_gbs"] for r in par)
+        comp = max(r["peak_gops"] for r in par)
+
+        fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(12, 4.8))
+        lo, hi = 0.05, 10.0
+        xs = [lo * (hi / lo) ** (k / 99.0) for k in range(100)]
+        ax1.plot(xs, [min(comp, bw * x) for x in xs], color="#555555", lw=1.4)
+        ax1.text(hi, comp * 1.05, "in-cache compute %.1f GOPS" % comp, ha="right", fontsize=8)
+        ax1.text(lo * 1.1, bw * lo * 1.25, "read %.1f GB/s" % bw, fontsize=8)
+        ax2.axhline(bw, color="#555555", lw=1.4)
+        ax2.text(hi, bw * 1.03, "read ceiling %.1f GB/s" % bw, ha="right", fontsize=8)
+
+        cmap = plt.get_cmap("tab20")
+        for n, r in enumerate(rows):
+            ai = ops_elem / (bytes_elem * r.get("passes", 1))
+            colour = cmap(n % 20)
+            marker = "s" if r["baseline"] == "ptr" else ("^" if r["baseline"] == "flat" else "o")
+            label = "%s (%dt)" % (r["version"], r["threads"])
+            ax1.loglog(ai, r["gops"], marker, color=colour, label=label)
+            ax2.semilogx(ai, r["gbs"], marker, color=colour)
+
+        ax1.set_xlim(lo, hi)
+        ax1.set_xlabel("Arithmetic intensity (compares / byte)")
+        ax1.set_ylabel("Achieved GOPS")
+        ax1.set_title("Roofline, %s, %d threads" % (rec["shape"], T))
+        ax2.set_xlim(lo, hi)
+        ax2.set_ylim(0, bw * 1.2)
+        ax2.set_xlabel("Arithmetic intensity (compares / byte)")
+        ax2.set_ylabel("Achieved GB/s (modelled traffic)")
+        ax2.set_title("Bandwidth, %s on %s" % (rec["isa"], rec["host"]["cpu"]))
+        ax1.legend(fontsize=6.5, ncol=2, loc="lower right")
+        for ax in (ax1, ax2):
+            ax.grid(True, which="both", ls=":", color="#cccccc")
+        fig.tight_layout()
+        # One chart per host, shape and ISA, like the records themselves
+        tag = re.sub(r"[^A-Za-z0-9.-]+", "_", config_key(rec))
+        out = os.path.join("charts", "roofline_%s_%dt.png" % (tag, T))
+        fig.savefig(out, dpi=200, bbox_inches="tight")
+        plt.close(fig)
+        print("Wrote %s" % out)
+
+
+COMMANDS = {
+    "record": cmd_record,
+    "baseline": cmd_baseline,
+    "compare": cmd_compare,
+    "roofline": cmd_roofline,
+    "list": cmd_list,
+}
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2 or sys.argv[1] not in COMMANDS:
+        sys.exit(__doc__)
+    COMMANDS[sys.argv[1]](sys.argv[2:])
@@ -2,7 +2,9 @@
 """
 Generate polished speedup and efficiency charts from benchmark_results.csv.
 
-Usage: python plot_benchmarks.py
+Usage: python plot_benchmarks.py [SHAPE]
+        SHAPE selects one problem shape from a run_benchmarks.sh sweep
+        (default 500x500x500; rows without a shape column count as that).
 Reads:  benchmark_results.csv
 Writes: charts/speedup_original.png
         charts/speedup_optimized.png
@@ -12,6 +14,7 @@ Writes: charts/speedup_original.png
 
 import csv
 import os
+import sys
 import matplotlib
 import matplotlib.pyplot as plt
 import matplotlib.ticker as ticker
@@ -68,6 +71,10 @@ PALETTE = {
     "novel_tasks":           "#4e342e",
     "novel_branchless":      "#546e7a",
     "novel_ultimate":        "#b71c1c",
+    "novel_tasks_adaptive":  "#8d6e63",
+    "novel_numa":            "#283593",
+    "novel_stream":          "#00838f",
+    "novel_fixed":           "#6a1b9a",
 }
 
 LABELS = {
@@ -83,6 +90,10 @@ LABELS = {
     "novel_tasks":           "Task-based D&C",
     "novel_branchless":      "Branchless XOR",
     "novel_ultimate":        "Ultimate (SIMD + tiling)",
+    "novel_tasks_adaptive":  "Tasks, adaptive cut-off",
+    "novel_numa":            "NUMA slabs (pinned)",
+    "novel_stream":          "Streaming (4 acc, NT loads)",
+    "novel_fixed":           "Fixed-shape kernels",
 }
 
 MARKERS = {
@@ -98,24 +109,34 @@ MARKERS = {
     "novel_tasks":           "X",
     "novel_branchless":      "h",
     "novel_ultimate":        "*",
+    "novel_tasks_adaptive":  "x",
+    "novel_numa":            "d",
+    "novel_stream":          "P",
+    "novel_fixed":           "X",
 }
 
 MARKER_SIZES = {k: 9 for k in MARKERS}
 MARKER_SIZES["novel_ultimate"] = 13   # star needs to be bigger
 
 # ── Read CSV ───────────────────────────────────────────────────────────────────
+SHAPE = sys.argv[1] if len(sys.argv) > 1 else "500x500x500"
+
 data = {}       # {(version, baseline): [(threads, time), ...]}
 baselines = {}  # {baseline_key: sequential_time}
 
 with open("benchmark_results.csv") as f:
     reader = csv.DictReader(f)
     for row in reader:
+        if (row.get("shape") or "500x500x500") != SHAPE:
+            continue
         version  = row["version"]
         threads  = int(row["threads"])
         time     = float(row["time_seconds"])
         baseline = row["baseline"]
 
-        if threads == 1:
+        # bench also times parallel versions on one thread; only the
+        # sequential baselines define the speedup reference
+        if version in ("sequential", "sequential_flat"):
             baselines[baseline] = time
         else:
             key = (version, baseline)
@@ -212,7 +233,11 @@ plot_group(
      ("novel_tiled",       "novel"),
      ("novel_tasks",       "novel"),
      ("novel_branchless",  "novel"),
-     ("novel_ultimate",    "novel")],
+     ("novel_ultimate",    "novel"),
+     ("novel_tasks_adaptive", "novel"),
+     ("novel_numa",        "novel"),
+     ("novel_stream",      "novel"),
+     ("novel_fixed",       "novel")],
     "Novel Approaches  ·  baseline: sequential_flat contiguous  (T = 0.678 s)",
     "charts/speedup_novel.png",
     "flat",
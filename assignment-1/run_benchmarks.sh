@@ -5,18 +5,31 @@
 # Two baselines are used for fair comparison:
 #   - sequential (int***) for the original parallel versions
 #   - sequential_flat (contiguous) for the optimized parallel versions
+#
+# Every version is run for each problem shape in SHAPES (MxNxP). The planted
+# min/max positions, and therefore the expected output, follow the shape:
+# min -1 at (M-1, N-1, P-1), max 100000 at (M/2, N/2, P/2). Example sweep
+# from L2-resident sizes to skewed shapes:
+#   SHAPES="64x64x64 256x256x256 500x500x500 1x1x268435456 4194304x8x8" bash run_benchmarks.sh
 
 set -e
 
 BINDIR="bin"
-THREADS="2 4 8 16"
-RUNS=3
+THREADS="${THREADS:-2 4 8 16}"
+RUNS="${RUNS:-3}"
+SHAPES="${SHAPES:-500x500x500}"
 RESULTS_FILE="benchmark_results.csv"
 
 EXPECTED_MIN="-1"
-EXPECTED_MIN_POS="(499, 499, 499)"
 EXPECTED_MAX="100000"
-EXPECTED_MAX_POS="(250, 250, 250)"
+
+# Derive the expected positions for shape $1 = MxNxP
+set_expected() {
+    local m n p
+    IFS=x read -r m n p <<< "$1"
+    EXPECTED_MIN_POS="($((m - 1)), $((n - 1)), $((p - 1)))"
+    EXPECTED_MAX_POS="($((m / 2)), $((n / 2)), $((p / 2)))"
+}
 
 echo "=== Building all versions ==="
 make -j all
@@ -51,126 +64,133 @@ run_best_of() {
     done
 }
 
-echo "version,threads,time_seconds,baseline" > "$RESULTS_FILE"
+echo "version,threads,time_seconds,baseline,shape" > "$RESULTS_FILE"
 
-# --- Baseline 1: sequential (pointer-of-pointer) ---
-echo "=== Sequential baseline — int*** layout (best of $RUNS) ==="
-run_best_of "\"$BINDIR/sequential\""
-SEQ_PTR_TIME="$BEST_TIME"
-echo "  Min/Max: $(echo "$LAST_OUTPUT" | head -2 | tr '\n' ', ')"
-echo "  Time: $SEQ_PTR_TIME s"
-check_correctness "sequential" "$LAST_OUTPUT"
-echo "sequential,1,$SEQ_PTR_TIME,ptr" >> "$RESULTS_FILE"
-echo ""
+ALL_PASS=true
+for SHAPE in $SHAPES; do
+    set_expected "$SHAPE"
+
+    # --- Baseline 1: sequential (pointer-of-pointer) ---
+    echo "=== [$SHAPE] Sequential baseline — int*** layout (best of $RUNS) ==="
+    run_best_of "\"$BINDIR/sequential\" --shape $SHAPE"
+    SEQ_PTR_TIME="$BEST_TIME"
+    echo "  Min/Max: $(echo "$LAST_OUTPUT" | head -2 | tr '\n' ', ')"
+    echo "  Time: $SEQ_PTR_TIME s"
+    check_correctness "sequential" "$LAST_OUTPUT"
+    echo "sequential,1,$SEQ_PTR_TIME,ptr,$SHAPE" >> "$RESULTS_FILE"
+    echo ""
 
-# --- Baseline 2: sequential_flat (contiguous) ---
-echo "=== Sequential baseline — flat layout (best of $RUNS) ==="
-run_best_of "\"$BINDIR/sequential_flat\""
-SEQ_FLAT_TIME="$BEST_TIME"
-echo "  Min/Max: $(echo "$LAST_OUTPUT" | head -2 | tr '\n' ', ')"
-echo "  Time: $SEQ_FLAT_TIME s"
-check_correctness "sequential_flat" "$LAST_OUTPUT"
-echo "sequential_flat,1,$SEQ_FLAT_TIME,flat" >> "$RESULTS_FILE"
-echo ""
+    # --- Baseline 2: sequential_flat (contiguous) ---
+    echo "=== [$SHAPE] Sequential baseline — flat layout (best of $RUNS) ==="
+    run_best_of "\"$BINDIR/sequential_flat\" --shape $SHAPE"
+    SEQ_FLAT_TIME="$BEST_TIME"
+    echo "  Min/Max: $(echo "$LAST_OUTPUT" | head -2 | tr '\n' ', ')"
+    echo "  Time: $SEQ_FLAT_TIME s"
+    check_correctness "sequential_flat" "$LAST_OUTPUT"
+    echo "sequential_flat,1,$SEQ_FLAT_TIME,flat,$SHAPE" >> "$RESULTS_FILE"
+    echo ""
 
-# --- Original parallel versions (compared against sequential ptr) ---
-ALL_PASS=true
-for VERSION in version1_parallel_for version2_sections version3_combined; do
-    echo "=== $VERSION (best of $RUNS) ==="
-    for T in $THREADS; do
-        run_best_of "OMP_NUM_THREADS=$T \"$BINDIR/$VERSION\""
-        SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_PTR_TIME / $BEST_TIME }")
-        EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_PTR_TIME / $BEST_TIME) / $T }")
-        if check_correctness "$VERSION T=$T" "$LAST_OUTPUT"; then
-            printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [PASS]\n" "$T" "$BEST_TIME" "$SP" "$EF"
-        else
-            printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [FAIL]\n" "$T" "$BEST_TIME" "$SP" "$EF"
-            ALL_PASS=false
-        fi
-        echo "$VERSION,$T,$BEST_TIME,ptr" >> "$RESULTS_FILE"
+    # --- Original parallel versions (compared against sequential ptr) ---
+    for VERSION in version1_parallel_for version2_sections version3_combined; do
+        echo "=== [$SHAPE] $VERSION (best of $RUNS) ==="
+        for T in $THREADS; do
+            run_best_of "OMP_NUM_THREADS=$T \"$BINDIR/$VERSION\" --shape $SHAPE"
+            SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_PTR_TIME / $BEST_TIME }")
+            EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_PTR_TIME / $BEST_TIME) / $T }")
+            if check_correctness "$VERSION T=$T" "$LAST_OUTPUT"; then
+                printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [PASS]\n" "$T" "$BEST_TIME" "$SP" "$EF"
+            else
+                printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [FAIL]\n" "$T" "$BEST_TIME" "$SP" "$EF"
+                ALL_PASS=false
+            fi
+            echo "$VERSION,$T,$BEST_TIME,ptr,$SHAPE" >> "$RESULTS_FILE"
+        done
+        echo ""
     done
-    echo ""
-done
 
-# --- Optimized parallel versions (compared against sequential_flat) ---
-for VERSION in version1_optimized version2_optimized version3_optimized; do
-    echo "=== $VERSION (best of $RUNS) ==="
-    for T in $THREADS; do
-        run_best_of "OMP_NUM_THREADS=$T \"$BINDIR/$VERSION\""
-        SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $BEST_TIME }")
-        EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $BEST_TIME) / $T }")
-        if check_correctness "$VERSION T=$T" "$LAST_OUTPUT"; then
-            printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [PASS]\n" "$T" "$BEST_TIME" "$SP" "$EF"
-        else
-            printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [FAIL]\n" "$T" "$BEST_TIME" "$SP" "$EF"
-            ALL_PASS=false
-        fi
-        echo "$VERSION,$T,$BEST_TIME,flat" >> "$RESULTS_FILE"
+    # --- Optimized parallel versions (compared against sequential_flat) ---
+    for VERSION in version1_optimized version2_optimized version3_optimized; do
+        echo "=== [$SHAPE] $VERSION (best of $RUNS) ==="
+        for T in $THREADS; do
+            run_best_of "OMP_NUM_THREADS=$T \"$BINDIR/$VERSION\" --shape $SHAPE"
+            SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $BEST_TIME }")
+            EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $BEST_TIME) / $T }")
+            if check_correctness "$VERSION T=$T" "$LAST_OUTPUT"; then
+                printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [PASS]\n" "$T" "$BEST_TIME" "$SP" "$EF"
+            else
+                printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [FAIL]\n" "$T" "$BEST_TIME" "$SP" "$EF"
+                ALL_PASS=false
+            fi
+            echo "$VERSION,$T,$BEST_TIME,flat,$SHAPE" >> "$RESULTS_FILE"
+        done
+        echo ""
     done
-    echo ""
-done
 
-# --- Novel approaches (compared against sequential_flat) ---
-for VERSION in novel_simd_avx2 novel_omp_simd novel_tiled novel_tasks novel_branchless novel_ultimate; do
-    echo "=== $VERSION (best of $RUNS) ==="
-    for T in $THREADS; do
-        run_best_of "OMP_NUM_THREADS=$T \"$BINDIR/$VERSION\""
-        SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $BEST_TIME }")
-        EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $BEST_TIME) / $T }")
-        if check_correctness "$VERSION T=$T" "$LAST_OUTPUT"; then
-            printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [PASS]\n" "$T" "$BEST_TIME" "$SP" "$EF"
-        else
-            printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [FAIL]\n" "$T" "$BEST_TIME" "$SP" "$EF"
-            ALL_PASS=false
-        fi
-        echo "$VERSION,$T,$BEST_TIME,novel" >> "$RESULTS_FILE"
+    # --- Novel approaches (compared against sequential_flat) ---
+    for VERSION in novel_simd_avx2 novel_omp_simd novel_tiled novel_tasks novel_branchless novel_ultimate novel_tasks_adaptive novel_numa novel_stream novel_fixed; do
+        echo "=== [$SHAPE] $VERSION (best of $RUNS) ==="
+        for T in $THREADS; do
+            run_best_of "OMP_NUM_THREADS=$T \"$BINDIR/$VERSION\" --shape $SHAPE"
+            SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $BEST_TIME }")
+            EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $BEST_TIME) / $T }")
+            if check_correctness "$VERSION T=$T" "$LAST_OUTPUT"; then
+                printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [PASS]\n" "$T" "$BEST_TIME" "$SP" "$EF"
+            else
+                printf "  T=%2d  Time=%-10s  Speedup=%-6s  Eff=%-6s  [FAIL]\n" "$T" "$BEST_TIME" "$SP" "$EF"
+                ALL_PASS=false
+            fi
+            echo "$VERSION,$T,$BEST_TIME,novel,$SHAPE" >> "$RESULTS_FILE"
+        done
+        echo ""
     done
-    echo ""
-done
 
-# --- Summary tables ---
-echo "============================================================"
-echo "  ORIGINAL VERSIONS (baseline: sequential int***)"
-echo "============================================================"
-printf "%-28s %7s %10s %8s %10s\n" "Version" "Threads" "Time (s)" "Speedup" "Efficiency"
-echo "------------------------------------------------------------------------"
-printf "%-28s %7s %10s %8s %10s\n" "sequential" "1" "$SEQ_PTR_TIME" "1.00" "1.00"
-while IFS=, read -r version threads time baseline; do
-    [ "$version" = "version" ] || [ "$baseline" != "ptr" ] || [ "$version" = "sequential" ] && continue
-    SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_PTR_TIME / $time }")
-    EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_PTR_TIME / $time) / $threads }")
-    printf "%-28s %7s %10s %8s %10s\n" "$version" "$threads" "$time" "$SP" "$EF"
-done < "$RESULTS_FILE"
+    # --- Summary tables ---
+    echo "============================================================"
+    echo "  [$SHAPE] ORIGINAL VERSIONS (baseline: sequential int***)"
+    echo "============================================================"
+    printf "%-28s %7s %10s %8s %10s\n" "Version" "Threads" "Time (s)" "Speedup" "Efficiency"
+    echo "------------------------------------------------------------------------"
+    printf "%-28s %7s %10s %8s %10s\n" "sequential" "1" "$SEQ_PTR_TIME" "1.00" "1.00"
+    while IFS=, read -r version threads time baseline shape; do
+        [ "$shape" = "$SHAPE" ] || continue
+        [ "$version" = "version" ] || [ "$baseline" != "ptr" ] || [ "$version" = "sequential" ] && continue
+        SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_PTR_TIME / $time }")
+        EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_PTR_TIME / $time) / $threads }")
+        printf "%-28s %7s %10s %8s %10s\n" "$version" "$threads" "$time" "$SP" "$EF"
+    done < "$RESULTS_FILE"
 
-echo ""
-echo "============================================================"
-echo "  OPTIMIZED VERSIONS (baseline: sequential_flat contiguous)"
-echo "============================================================"
-printf "%-28s %7s %10s %8s %10s\n" "Version" "Threads" "Time (s)" "Speedup" "Efficiency"
-echo "------------------------------------------------------------------------"
-printf "%-28s %7s %10s %8s %10s\n" "sequential_flat" "1" "$SEQ_FLAT_TIME" "1.00" "1.00"
-while IFS=, read -r version threads time baseline; do
-    [ "$version" = "version" ] || [ "$baseline" != "flat" ] || [ "$version" = "sequential_flat" ] && continue
-    SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $time }")
-    EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $time) / $threads }")
-    printf "%-28s %7s %10s %8s %10s\n" "$version" "$threads" "$time" "$SP" "$EF"
-done < "$RESULTS_FILE"
+    echo ""
+    echo "============================================================"
+    echo "  [$SHAPE] OPTIMIZED VERSIONS (baseline: sequential_flat contiguous)"
+    echo "============================================================"
+    printf "%-28s %7s %10s %8s %10s\n" "Version" "Threads" "Time (s)" "Speedup" "Efficiency"
+    echo "------------------------------------------------------------------------"
+    printf "%-28s %7s %10s %8s %10s\n" "sequential_flat" "1" "$SEQ_FLAT_TIME" "1.00" "1.00"
+    while IFS=, read -r version threads time baseline shape; do
+        [ "$shape" = "$SHAPE" ] || continue
+        [ "$version" = "version" ] || [ "$baseline" != "flat" ] || [ "$version" = "sequential_flat" ] && continue
+        SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $time }")
+        EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $time) / $threads }")
+        printf "%-28s %7s %10s %8s %10s\n" "$version" "$threads" "$time" "$SP" "$EF"
+    done < "$RESULTS_FILE"
 
-echo ""
-echo "============================================================"
-echo "  NOVEL APPROACHES (baseline: sequential_flat contiguous)"
-echo "============================================================"
-printf "%-28s %7s %10s %8s %10s\n" "Version" "Threads" "Time (s)" "Speedup" "Efficiency"
-echo "------------------------------------------------------------------------"
-printf "%-28s %7s %10s %8s %10s\n" "sequential_flat" "1" "$SEQ_FLAT_TIME" "1.00" "1.00"
-while IFS=, read -r version threads time baseline; do
-    [ "$version" = "version" ] || [ "$baseline" != "novel" ] && continue
-    SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $time }")
-    EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $time) / $threads }")
-    printf "%-28s %7s %10s %8s %10s\n" "$version" "$threads" "$time" "$SP" "$EF"
-done < "$RESULTS_FILE"
+    echo ""
+    echo "============================================================"
+    echo "  [$SHAPE] NOVEL APPROACHES (baseline: sequential_flat contiguous)"
+    echo "============================================================"
+    printf "%-28s %7s %10s %8s %10s\n" "Version" "Threads" "Time (s)" "Speedup" "Efficiency"
+    echo "------------------------------------------------------------------------"
+    printf "%-28s %7s %10s %8s %10s\n" "sequential_flat" "1" "$SEQ_FLAT_TIME" "1.00" "1.00"
+    while IFS=, read -r version threads time baseline shape; do
+        [ "$shape" = "$SHAPE" ] || continue
+        [ "$version" = "version" ] || [ "$baseline" != "novel" ] && continue
+        SP=$(awk "BEGIN { printf \"%.2f\", $SEQ_FLAT_TIME / $time }")
+        EF=$(awk "BEGIN { printf \"%.2f\", ($SEQ_FLAT_TIME / $time) / $threads }")
+        printf "%-28s %7s %10s %8s %10s\n" "$version" "$threads" "$time" "$SP" "$EF"
+    done < "$RESULTS_FILE"
+    echo ""
+done
 
-echo ""
 if $ALL_PASS; then
     echo "All correctness checks PASSED."
 else
@@ -0,0 +1,77 @@
+#!/bin/bash
+# run_mpi_scaling.sh — Strong and weak scaling of bin/mpi_scan across MPI ranks,
+# with correctness checks against the planted min/max.
+#
+# Strong scaling keeps SHAPE fixed and adds ranks; weak scaling gives every
+# rank SHAPE's worth of planes (M is multiplied by the rank count). Each rank
+# runs THREADS OpenMP threads. Against the first entry of RANKS (R0),
+# efficiency is T(R0)*R0 / (T(R)*R) for strong and T(R0) / T(R) for weak
+# scaling; 1.00 is ideal in both.
+#
+#   RANKS="1 2 4 8" THREADS=16 SHAPE=1024x1024x1024 bash run_mpi_scaling.sh
+#   MPIRUN="srun" MPIRUN_ARGS="--cpu-bind=cores" bash run_mpi_scaling.sh
+#
+# MPIRUN_ARGS is passed before -np / the binary, e.g. a hostfile or
+# "--map-by ppr:1:node --bind-to none" for one rank per node.
+
+set -e
+
+BINDIR="bin"
+RANKS="${RANKS:-1 2 4}"
+THREADS="${THREADS:-4}"
+SHAPE="${SHAPE:-500x500x500}"
+REPS="${REPS:-5}"
+MPIRUN="${MPIRUN:-mpirun}"
+MPIRUN_ARGS="${MPIRUN_ARGS:-}"
+RESULTS_FILE="mpi_scaling_results.csv"
+
+echo "=== Building mpi_scan ==="
+make mpi
+echo ""
+
+IFS=x read -r M N P <<< "$SHAPE"
+
+# Run R ranks on shape $2; sets RUN_TIME, fails if the result is wrong
+run_scan() {
+    local r="$1" shape="$2" m n p out
+    IFS=x read -r m n p <<< "$shape"
+    out=$(OMP_NUM_THREADS=$THREADS $MPIRUN $MPIRUN_ARGS -np "$r" \
+          "$BINDIR/mpi_scan" --shape "$shape" --reps "$REPS")
+    if [ "$(echo "$out" | grep '^Min')" != "Min = -1 at ($((m - 1)), $((n - 1)), $((p - 1)))" ] || \
+       [ "$(echo "$out" | grep '^Max')" != "Max = 100000 at ($((m / 2)), $((n / 2)), $((p / 2)))" ]; then
+        echo "  FAIL [R=$r $shape]:" $(echo "$out" | head -2)
+        return 1
+    fi
+    RUN_TIME=$(echo "$out" | grep "Time:" | awk '{print $2}')
+}
+
+echo "mode,ranks,threads,shape,time_seconds,efficiency" > "$RESULTS_FILE"
+
+ALL_PASS=true
+for MODE in strong weak; do
+    echo "=== $MODE scaling, $THREADS threads per rank (median of $REPS) ==="
+    BASE=""
+    for R in $RANKS; do
+        if [ "$MODE" = strong ]; then S="$SHAPE"; else S="$((M * R))x${N}x${P}"; fi
+        if ! run_scan "$R" "$S"; then
+            ALL_PASS=false
+            continue
+        fi
+        if [ -z "$BASE" ]; then BASE="$RUN_TIME"; BASE_R="$R"; fi
+        if [ "$MODE" = strong ]; then
+            EF=$(awk "BEGIN { printf \"%.2f\", ($BASE * $BASE_R) / ($RUN_TIME * $R) }")
+        else
+            EF=$(awk "BEGIN { printf \"%.2f\", $BASE / $RUN_TIME }")
+        fi
+        printf "  R=%3d  %-20s Time=%-10s  Eff=%-6s  [PASS]\n" "$R" "$S" "$RUN_TIME" "$EF"
+        echo "$MODE,$R,$THREADS,$S,$RUN_TIME,$EF" >> "$RESULTS_FILE"
+    done
+    echo ""
+done
+
+if $ALL_PASS; then
+    echo "All correctness checks PASSED."
+else
+    echo "WARNING: Some correctness checks FAILED!"
+fi
+echo "Raw results saved to $RESULTS_FILE"
@@ -0,0 +1,133 @@
+/*
+ * Tool: page size and row alignment vs scan time.
+ *
+ *     alloc_scan [--reps K] [--shape MxNxP]
+ *
+ * For each allocation (malloc, then arenas with 4 KB pages, transparent
+ * huge pages and hugetlbfs pages) fills the generated input twice, once
+ * contiguous and once with rows padded to minmax_row_stride(P), and times
+ * K calls (default 5, median) of minmax_loc_3d(MINMAX_ULTIMATE) on the first
+ * and minmax_loc_3d_padded() on the second. Prints the page kind actually
+ * obtained (hugetlb falls back to THP without a reserved pool) and checks
+ * that every result matches the malloc contiguous one.
+ */
+#include "common.h"
+
+static int cmp_double(const void *x, const void *y)
+{
+    double a = *(const double *)x, b = *(const double *)y;
+    return (a > b) - (a < b);
+}
+
+/* Fill a[M][N][stride] with the generated input (padding left as is) */
+static void fill(int *a, int M, int N, int P, long stride)
+{
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int i = 0; i < M; i++)
+        for (int j = 0; j < N; j++)
+            for (int k = 0; k < P; k++)
+                a[((long)i * N + j) * stride + k] = gen_value(SEED, IDX((unsigned long long)i, j, k, N, P));
+    a[((long)(M - 1) * N + N - 1) * stride + P - 1] = -1;      /* unique min */
+    a[((long)(M / 2) * N + N / 2) * stride + P / 2] = 100000;  /* unique max */
+}
+
+static double median_time(const int *a, int M, int N, int P, long stride, int reps,
+                          MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    double *t = (double *)xmalloc((size_t)reps * sizeof(double));
+    for (int r = 0; r < reps; r++) {
+        double t0 = omp_get_wtime();
+        if (stride == P)
+            minmax_loc_3d(a, M, N, P, MINMAX_ULTIMATE, vmin, vmax);
+        else
+            minmax_loc_3d_padded(a, M, N, P, stride, vmin, vmax);
+        t[r] = omp_get_wtime() - t0;
+    }
+    qsort(t, (size_t)reps, sizeof(double), cmp_double);
+    double m = t[reps / 2];
+    free(t);
+    return m;
+}
+
+static int same(const MinMaxLoc *a, const MinMaxLoc *b)
+{
+    return a->val == b->val && a->i == b->i && a->j == b->j && a->k == b->k;
+}
+
+int main(int argc, char **argv)
+{
+    /* Pull out --reps; everything else goes to the shared parser */
+    int reps = 5;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+            reps = atoi(argv[++i]);
+        else
+            argv[nargs++] = argv[i];
+    }
+    parse_args(nargs, argv);
+    if (reps <= 0) {
+        fprintf(stderr, "usage: %s [--reps K>0] [--shape MxNxP]\n", argv[0]);
+        return 2;
+    }
+
+    int M = input_m, N = input_n, P = input_p;
+    long stride = minmax_row_stride(P);
+    size_t dense = (size_t)M * N * P * sizeof(int), padded = (size_t)M * N * stride * sizeof(int);
+    double gb = dense / 1e9;
+
+    printf("Shape %dx%dx%d, rows padded %d -> %ld (+%.1f%%), median of %d, %d threads\n",
+           M, N, P, P, stride, 100.0 * (padded - dense) / dense, reps, omp_get_max_threads());
+    printf("%-10s %-9s %12s %8s %12s %8s\n", "alloc", "pages", "dense (s)", "GB/s", "padded (s)", "GB/s");
+
+    MinMaxLoc rmin, rmax;
+    int bad = 0;
+    for (int kind = INPUT_ALLOC_MALLOC; kind < MINMAX_PAGES_NUM_KINDS; kind++) {
+        minmax_arena ad = { 0 }, ap = { 0 };
+        int *a, *b;
+        const char *got;
+        if (kind == INPUT_ALLOC_MALLOC) {
+            a = (int *)xmalloc(dense);
+            b = (int *)xmalloc(padded);
+            got = "4k";
+        } else {
+            if (minmax_arena_init(&ad, dense, (minmax_pages)kind) != 0 ||
+                minmax_arena_init(&ap, padded, (minmax_pages)kind) != 0) {
+                fprintf(stderr, "cannot map a %s arena\n", minmax_pages_name((minmax_pages)kind));
+                return 1;
+            }
+            a = (int *)minmax_arena_alloc(&ad, dense, 0);
+            b = (int *)minmax_arena_alloc(&ap, padded, 0);
+            got = minmax_pages_name(ad.pages);
+        }
+        fill(a, M, N, P, P);
+        fill(b, M, N, P, stride);
+
+        MinMaxLoc dmin, dmax, pmin, pmax;
+        double td = median_time(a, M, N, P, P, reps, &dmin, &dmax);
+        double tp = median_time(b, M, N, P, stride, reps, &pmin, &pmax);
+        if (kind == INPUT_ALLOC_MALLOC) {
+            rmin = dmin;
+            rmax = dmax;
+        }
+        bad |= !same(&dmin, &rmin) || !same(&dmax, &rmax) || !same(&pmin, &rmin) || !same(&pmax, &rmax);
+
+        printf("%-10s %-9s %12.6f %8.2f %12.6f %8.2f\n",
+               kind == INPUT_ALLOC_MALLOC ? "malloc" : minmax_pages_name((minmax_pages)kind),
+               got, td, gb / td, tp, gb / tp);
+
+        if (kind == INPUT_ALLOC_MALLOC) {
+            free(a);
+            free(b);
+        } else {
+            minmax_arena_release(&ad);
+            minmax_arena_release(&ap);
+        }
+    }
+
+    printf("Min = %d at (%d, %d, %d)\n", rmin.val, rmin.i, rmin.j, rmin.k);
+    printf("Max = %d at (%d, %d, %d)\n", rmax.val, rmax.i, rmax.j, rmax.k);
+    if (bad)
+        fprintf(stderr, "warning: results differ between allocations or layouts\n");
+    return bad != 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Tool: many queries in one pass vs one scan per query.
+ *
+ *     batch_scan [--queries Q] [--shape MxNxP] [--input FILE]
+ *
+ * Builds Q queries (default 16) over the usual volume: the whole-volume
+ * min/max, then alternating min/max and count-above-threshold queries on
+ * half-extent boxes at pseudo-random offsets. Answers them once with
+ * minmax_query_batch() and once query by query (minmax_loc_3d_roi() for
+ * min/max, a one-query batch for counts), prints both times and checks
+ * that the answers agree.
+ */
+#include "common.h"
+
+static int same_loc(const MinMaxLoc *a, const MinMaxLoc *b)
+{
+    return a->val == b->val && a->i == b->i && a->j == b->j && a->k == b->k;
+}
+
+/* [lo, lo + len/2 + 1) at a pseudo-random offset inside [0, len) */
+static void half_range(int len, int draw, int *lo, int *hi)
+{
+    int ext = len / 2 + 1 < len ? len / 2 + 1 : len;
+    *lo = draw % (len - ext + 1);
+    *hi = *lo + ext;
+}
+
+int main(int argc, char **argv)
+{
+    /* Pull out --queries; everything else goes to the shared parser */
+    int nq = 16;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc)
+            nq = atoi(argv[++i]);
+        else
+            argv[nargs++] = argv[i];
+    }
+    parse_args(nargs, argv);
+
+    if (nq <= 0) {
+        fprintf(stderr, "usage: %s [--queries Q>0] [--shape MxNxP] [--input FILE]\n", argv[0]);
+        return 2;
+    }
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+
+    minmax_query *q = (minmax_query *)xmalloc((size_t)nq * sizeof(minmax_query));
+    minmax_query *one = (minmax_query *)xmalloc((size_t)nq * sizeof(minmax_query));
+    q[0] = (minmax_query){ .kind = MINMAX_QUERY_MINMAX, .box = { 0, M, 0, N, 0, P } };
+    for (int x = 1; x < nq; x++) {
+        minmax_box b;
+        half_range(M, gen_value(SEED + x, 0), &b.i0, &b.i1);
+        half_range(N, gen_value(SEED + x, 1), &b.j0, &b.j1);
+        half_range(P, gen_value(SEED + x, 2), &b.k0, &b.k1);
+        q[x] = (minmax_query){
+            .kind = x % 2 ? MINMAX_QUERY_MINMAX : MINMAX_QUERY_COUNT_ABOVE,
+            .box = b,
+            .threshold = gen_value(SEED + x, 3),
+        };
+    }
+
+    double t_start = omp_get_wtime();
+    if (minmax_query_batch(a, M, N, P, q, nq) != 0) {
+        fprintf(stderr, "minmax_query_batch() failed\n");
+        return 1;
+    }
+    double t_batch = omp_get_wtime() - t_start;
+
+    int bad = 0;
+    MinMaxLoc vmin, vmax;
+    t_start = omp_get_wtime();
+    for (int x = 0; x < nq; x++) {
+        one[x] = q[x];
+        if (q[x].kind == MINMAX_QUERY_MINMAX)
+            minmax_loc_3d_roi(a, M, N, P, &q[x].box, &one[x].min, &one[x].max);
+        else
+            minmax_query_batch(a, M, N, P, &one[x], 1);
+    }
+    double t_each = omp_get_wtime() - t_start;
+
+    for (int x = 0; x < nq; x++) {
+        if (q[x].kind == MINMAX_QUERY_MINMAX)
+            bad += !same_loc(&q[x].min, &one[x].min) || !same_loc(&q[x].max, &one[x].max);
+        else
+            bad += q[x].count != one[x].count;
+    }
+
+    vmin = q[0].min;
+    vmax = q[0].max;
+    print_result(&vmin, &vmax, t_batch);
+    printf("%d queries: batch %.6f s, one by one %.6f s (%.1fx)\n",
+           nq, t_batch, t_each, t_each / t_batch);
+    if (bad)
+        fprintf(stderr, "warning: %d of %d queries disagree with separate scans\n", bad, nq);
+
+    free(one);
+    free(q);
+    free_input_flat(a);
+    return bad != 0;
+}
@@ -0,0 +1,602 @@
+/*
+ * Benchmark harness: every strategy, in one process, with statistics.
+ *
+ *     bench [--reps N] [--warmup W] [--threads T1,T2,...] [--only NAME,...]
+ *           [--csv FILE] [--json FILE] [--perf] [--tune [--tune-file FILE]]
+ *           [--dram-gbs G] [--shape MxNxP] [--input FILE]
+ *
+ * Unlike run_benchmarks.sh, which times one cold call per process, the
+ * input is allocated and first-touched once (both layouts), every
+ * (strategy, threads) pair gets W untimed warm-up calls (default 3) and
+ * then N timed ones (default 20), and the report gives min / median /
+ * p95 / p99 with a 95% confidence interval for the median. Each thread
+ * count is also given a STREAM-style read bandwidth ceiling (a parallel
+ * sum over the same buffer, best of 5), so the effective GB/s of a kernel
+ * can be read as a fraction of what the memory system delivers.
+ * --dram-gbs gives the nominal peak (channels x MT/s x 8 bytes, which the
+ * program cannot discover on its own) for a second column against that.
+ *
+ * --threads defaults to 2, 4, ... up to omp_get_max_threads(); the two
+ * sequential baselines always run on one thread. Every result is checked
+ * against sequential_flat. --csv writes run_benchmarks.sh's columns
+ * (time_seconds is the median) followed by the statistics, so
+ * plot_benchmarks.py reads it as is; --json writes the same records plus
+ * the host settings, the sorted timings of every row and a roofline
+ * model: each version's modelled traffic (passes over the volume x 4 B
+ * per element) gives its arithmetic intensity at BENCH_OPS_ELEM
+ * operations per element, and an in-cache compute ceiling (every thread
+ * scanning its own L2-resident buffer, best of 5) complements the read
+ * ceiling. perf_history.py stores these records per revision and host,
+ * detects regressions against a baseline and draws the rooflines.
+ *
+ * --perf (PERF=1 builds) adds one counted call after the timed ones and
+ * prints its per-thread counters; the JSON records then carry the totals.
+ *
+ * --tune first searches the tuning parameters (see minmax_tuning in
+ * minmax.h) for this shape at each thread count, by coordinate descent:
+ * one parameter at a time over its candidates, keeping a value only if it
+ * beats the current best median by TUNE_MARGIN, two rounds. Tile size,
+ * tiles per thread, prefetch distance and schedule are timed on
+ * novel_ultimate, the task leaf on novel_tasks. The winners are saved to
+ * the cache file (default path, or --tune-file) that the library loads at
+ * startup, and the benchmark rows that follow already use them.
+ */
+#include "common.h"
+#include <math.h>
+
+#define BENCH_MAX_THREADS 64
+#define BENCH_BW_REPS     5
+
+/* Roofline model: a min and a max compare per element; the compute
+ * ceiling scans BENCH_CACHE_ELEMS per thread (128 KB, L2-resident)
+ * BENCH_CACHE_SCANS times */
+#define BENCH_OPS_ELEM    2
+#define BENCH_CACHE_ELEMS 32768L
+#define BENCH_CACHE_SCANS 200
+
+/* A candidate must beat the incumbent's median by 2% to replace it */
+#define TUNE_MARGIN 0.98
+#define TUNE_ROUNDS 2
+
+typedef struct {
+    const char *name;       /* binary name, as in run_benchmarks.sh / the plots */
+    const char *baseline;   /* ptr, flat or novel */
+    int ptr;                /* int*** layout */
+    int strategy;           /* minmax_strategy or minmax_ptr_strategy */
+    int passes;             /* reads of the whole volume per call (two sections: 2) */
+} BenchEntry;
+
+static const BenchEntry entries[] = {
+    { "sequential",            "ptr",   1, MINMAX_PTR_SEQUENTIAL, 1 },
+    { "sequential_flat",       "flat",  0, MINMAX_SEQUENTIAL, 1 },
+    { "version1_parallel_for", "ptr",   1, MINMAX_PTR_PARALLEL_FOR, 1 },
+    { "version2_sections",     "ptr",   1, MINMAX_PTR_SECTIONS, 2 },
+    { "version3_combined",     "ptr",   1, MINMAX_PTR_COMBINED, 2 },
+    { "version1_optimized",    "flat",  0, MINMAX_PARALLEL_FOR, 1 },
+    { "version2_optimized",    "flat",  0, MINMAX_SECTIONS, 2 },
+    { "version3_optimized",    "flat",  0, MINMAX_NESTED, 2 },
+    { "novel_simd_avx2",       "novel", 0, MINMAX_SIMD, 1 },
+    { "novel_omp_simd",        "novel", 0, MINMAX_OMP_SIMD, 1 },
+    { "novel_tiled",           "novel", 0, MINMAX_TILED, 1 },
+    { "novel_tasks",           "novel", 0, MINMAX_TASKS, 1 },
+    { "novel_branchless",      "novel", 0, MINMAX_BRANCHLESS, 1 },
+    { "novel_ultimate",        "novel", 0, MINMAX_ULTIMATE, 1 },
+    { "novel_tasks_adaptive",  "novel", 0, MINMAX_TASKS_ADAPTIVE, 1 },
+    { "novel_numa",            "novel", 0, MINMAX_NUMA, 1 },
+    { "novel_stream",          "novel", 0, MINMAX_STREAM, 1 },
+    { "novel_fixed",           "novel", 0, MINMAX_FIXED, 1 },
+};
+#define NUM_ENTRIES ((int)(sizeof(entries) / sizeof(entries[0])))
+
+typedef struct {
+    const BenchEntry *e;
+    int threads;
+    int reps;
+    double min, median, mean, stddev, p95, p99, ci_lo, ci_hi;
+    double gbs, peak_gbs;   /* modelled traffic / median, and the read ceiling at this thread count */
+    double gops, peak_gops; /* compares / median, and the in-cache ceiling */
+    double *samples;        /* the reps timings, sorted */
+    int ok;
+    unsigned perf_valid;    /* events in perf, 0 without --perf */
+    minmax_perf_counts perf;
+} BenchResult;
+
+static int cmp_double(const void *x, const void *y)
+{
+    double a = *(const double *)x, b = *(const double *)y;
+    return (a > b) - (a < b);
+}
+
+/* Nearest-rank percentile of sorted t[0..n) */
+static double percentile(const double *t, int n, double q)
+{
+    int r = (int)ceil(q * n);
+    if (r < 1) r = 1;
+    if (r > n) r = n;
+    return t[r - 1];
+}
+
+/*
+ * Fill the statistics of r from n timings (sorted in place). The median's
+ * confidence interval is distribution-free: the order statistics at ranks
+ * n/2 -+ 1.96 sqrt(n)/2 bracket it with ~95% probability whatever the
+ * shape of the timing distribution (long right tails are the norm).
+ */
+static void summarise(double *t, int n, BenchResult *r)
+{
+    qsort(t, (size_t)n, sizeof(double), cmp_double);
+
+    double sum = 0;
+    for (int x = 0; x < n; x++)
+        sum += t[x];
+    double mean = sum / n, ss = 0;
+    for (int x = 0; x < n; x++)
+        ss += (t[x] - mean) * (t[x] - mean);
+
+    int lo = (int)floor(n / 2.0 - 0.98 * sqrt((double)n));
+    int hi = (int)ceil(n / 2.0 + 0.98 * sqrt((double)n));
+    if (lo < 0) lo = 0;
+    if (hi > n - 1) hi = n - 1;
+
+    r->reps   = n;
+    r->min    = t[0];
+    r->median = n % 2 ? t[n / 2] : 0.5 * (t[n / 2 - 1] + t[n / 2]);
+    r->mean   = mean;
+    r->stddev = n > 1 ? sqrt(ss / (n - 1)) : 0;
+    r->p95    = percentile(t, n, 0.95);
+    r->p99    = percentile(t, n, 0.99);
+    r->ci_lo  = t[lo];
+    r->ci_hi  = t[hi];
+}
+
+/* STREAM-style read ceiling: best-of-BENCH_BW_REPS parallel sum, in GB/s */
+static double read_bandwidth(const int *a, long total)
+{
+    double best = 0;
+    volatile unsigned sink = 0;   /* keeps the sums, and so the loop, alive */
+    for (int r = 0; r < BENCH_BW_REPS; r++) {
+        unsigned sum = 0;   /* wrapping 32-bit lanes vectorise at full width */
+        double t0 = omp_get_wtime();
+        #pragma omp parallel for simd schedule(static) reduction(+ : sum)
+        for (long x = 0; x < total; x++)
+            sum += (unsigned)a[x];
+        double dt = omp_get_wtime() - t0;
+        sink += sum;
+        if (dt > 0 && total * sizeof(int) / dt > best)
+            best = total * sizeof(int) / dt;
+    }
+    return best / 1e9;
+}
+
+/*
+ * In-cache compute ceiling in GOPS: every thread copies BENCH_CACHE_ELEMS
+ * elements into a private buffer and scans it BENCH_CACHE_SCANS times
+ * with the streaming strategy (one kernel call per scan; the call runs on
+ * the thread itself inside the region), best of BENCH_BW_REPS.
+ */
+static double compute_ceiling(const int *a, long total)
+{
+    long n = total < BENCH_CACHE_ELEMS ? total : BENCH_CACHE_ELEMS;
+    double best = 0;
+    for (int r = 0; r < BENCH_BW_REPS; r++) {
+        double t0 = 0, dt = 0;
+        int nth = 1;
+        #pragma omp parallel
+        {
+            int *buf = (int *)xmalloc((size_t)n * sizeof(int));
+            memcpy(buf, a, (size_t)n * sizeof(int));
+            MinMaxLoc vmin, vmax;
+            #pragma omp barrier
+            #pragma omp single
+            {
+                nth = omp_get_num_threads();
+                t0 = omp_get_wtime();
+            }
+            for (int s = 0; s < BENCH_CACHE_SCANS; s++)
+                minmax_loc_3d(buf, 1, 1, (int)n, MINMAX_STREAM, &vmin, &vmax);
+            #pragma omp barrier
+            #pragma omp single
+            dt = omp_get_wtime() - t0;
+            free(buf);
+        }
+        double ops = (double)BENCH_OPS_ELEM * n * BENCH_CACHE_SCANS * nth;
+        if (dt > 0 && ops / dt > best)
+            best = ops / dt;
+    }
+    return best / 1e9;
+}
+
+static int run_once(const BenchEntry *e, const int *a, int ***ap, int M, int N, int P,
+                    MinMaxLoc *vmin, MinMaxLoc *vmax)
+{
+    if (e->ptr)
+        return minmax_loc_3d_ptr((int *const *const *)ap, M, N, P,
+                                 (minmax_ptr_strategy)e->strategy, vmin, vmax);
+    return minmax_loc_3d(a, M, N, P, (minmax_strategy)e->strategy, vmin, vmax);
+}
+
+static int same_loc(const MinMaxLoc *x, const MinMaxLoc *y)
+{
+    return x->val == y->val && x->i == y->i && x->j == y->j && x->k == y->k;
+}
+
+/* ---------------- Autotuning ---------------- */
+
+static const int  tune_tile_target[]   = { 8192, 16384, 32768, 65536, 131072, 262144 };
+static const int  tune_tiles_thread[]  = { 1, 2, 4, 8, 16 };
+static const int  tune_prefetch_rows[] = { 0, 1, 2, 4, 8, 16 };
+static const long tune_task_leaf[]     = { 8192, 16384, 32768, 65536, 131072, 262144, 524288 };
+static const struct { int schedule, chunk; } tune_schedule[] = {
+    { MINMAX_SCHED_STATIC, 0 }, { MINMAX_SCHED_STATIC, 1 },
+    { MINMAX_SCHED_DYNAMIC, 1 }, { MINMAX_SCHED_DYNAMIC, 4 }, { MINMAX_SCHED_GUIDED, 0 },
+};
+#define COUNT(x) ((int)(sizeof(x) / sizeof((x)[0])))
+
+/* Median of reps flat-layout calls of strategy s after one warm-up */
+static double median_time(minmax_strategy s, const int *a, int M, int N, int P, int reps, double *t)
+{
+    MinMaxLoc vmin, vmax;
+    minmax_loc_3d(a, M, N, P, s, &vmin, &vmax);
+    for (int r = 0; r < reps; r++) {
+        double t0 = omp_get_wtime();
+        minmax_loc_3d(a, M, N, P, s, &vmin, &vmax);
+        t[r] = omp_get_wtime() - t0;
+    }
+    BenchResult br;
+    summarise(t, reps, &br);
+    return br.median;
+}
+
+/* Try candidate c for (M, N, P, T); keep it in *best if it is clearly faster */
+static void tune_try(const minmax_tuning *c, minmax_tuning *best, double *best_t,
+                     minmax_strategy s, const int *a, int M, int N, int P, int T,
+                     int reps, double *t)
+{
+    minmax_tuning_set(M, N, P, T, c);
+    double m = median_time(s, a, M, N, P, reps, t);
+    if (m < *best_t * TUNE_MARGIN) {
+        *best = *c;
+        *best_t = m;
+    }
+    minmax_tuning_set(M, N, P, T, best);
+}
+
+static void autotune(const int *a, int M, int N, int P, int T, int reps, double *t)
+{
+    omp_set_num_threads(T);
+    minmax_tuning best, c;
+    minmax_tuning_get(M, N, P, T, &best);
+    minmax_tuning_set(M, N, P, T, &best);
+
+    double best_t = median_time(MINMAX_ULTIMATE, a, M, N, P, reps, t);
+    double start_t = best_t;
+    for (int round = 0; round < TUNE_ROUNDS; round++) {
+        for (int v = 0; v < COUNT(tune_tile_target); v++) {
+            c = best; c.tile_target = tune_tile_target[v];
+            tune_try(&c, &best, &best_t, MINMAX_ULTIMATE, a, M, N, P, T, reps, t);
+        }
+        for (int v = 0; v < COUNT(tune_tiles_thread); v++) {
+            c = best; c.tiles_per_thread = tune_tiles_thread[v];
+            tune_try(&c, &best, &best_t, MINMAX_ULTIMATE, a, M, N, P, T, reps, t);
+        }
+        for (int v = 0; v < COUNT(tune_prefetch_rows); v++) {
+            c = best; c.prefetch_rows = tune_prefetch_rows[v];
+            tune_try(&c, &best, &best_t, MINMAX_ULTIMATE, a, M, N, P, T, reps, t);
+        }
+        for (int v = 0; v < COUNT(tune_schedule); v++) {
+            c = best; c.schedule = tune_schedule[v].schedule; c.chunk = tune_schedule[v].chunk;
+            tune_try(&c, &best, &best_t, MINMAX_ULTIMATE, a, M, N, P, T, reps, t);
+        }
+    }
+
+    double task_t = median_time(MINMAX_TASKS, a, M, N, P, reps, t);
+    double task_start = task_t;
+    for (int v = 0; v < COUNT(tune_task_leaf); v++) {
+        c = best; c.task_leaf = tune_task_leaf[v];
+        tune_try(&c, &best, &task_t, MINMAX_TASKS, a, M, N, P, T, reps, t);
+    }
+
+    printf("Tuned T=%d: tile_target=%d tiles_per_thread=%d prefetch_rows=%d schedule=%s,%d "
+           "task_leaf=%ld  (ultimate %.6f -> %.6f s, tasks %.6f -> %.6f s)\n",
+           T, best.tile_target, best.tiles_per_thread, best.prefetch_rows,
+           minmax_schedule_name((minmax_schedule)best.schedule), best.chunk, best.task_leaf,
+           start_t, best_t, task_start, task_t);
+}
+
+/* Is name in the comma-separated list (NULL = everything)? */
+static int selected(const char *list, const char *name)
+{
+    if (!list)
+        return 1;
+    size_t len = strlen(name);
+    for (const char *p = list; *p; ) {
+        const char *end = strchr(p, ',');
+        size_t n = end ? (size_t)(end - p) : strlen(p);
+        if (n == len && strncmp(p, name, n) == 0)
+            return 1;
+        if (!end)
+            break;
+        p = end + 1;
+    }
+    return 0;
+}
+
+static void write_csv(const char *path, const BenchResult *res, int n, int M, int N, int P)
+{
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    fprintf(f, "version,threads,time_seconds,baseline,shape,"
+               "min,mean,stddev,p95,p99,ci_lo,ci_hi,reps,gbs,peak_gbs\n");
+    for (int x = 0; x < n; x++) {
+        const BenchResult *r = &res[x];
+        fprintf(f, "%s,%d,%.6f,%s,%dx%dx%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%d,%.2f,%.2f\n",
+                r->e->name, r->threads, r->median, r->e->baseline, M, N, P,
+                r->min, r->mean, r->stddev, r->p95, r->p99, r->ci_lo, r->ci_hi,
+                r->reps, r->gbs, r->peak_gbs);
+    }
+    fclose(f);
+}
+
+static void write_json(const char *path, const BenchResult *res, int n, int M, int N, int P,
+                       int max_threads, int warmup, double dram_gbs)
+{
+    minmax_stream_params sp;
+    minmax_get_stream(&sp);
+
+    /* The CPU model goes into a JSON string: drop quotes and backslashes */
+    char json_cpu[128];
+    snprintf(json_cpu, sizeof(json_cpu), "%s", minmax_cpu_model());
+    for (char *c = json_cpu; *c; c++)
+        if (*c == '"' || *c == '\\' || (unsigned char)*c < 0x20)
+            *c = ' ';
+
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    fprintf(f, "{\n  \"shape\": \"%dx%dx%d\",\n  \"isa\": \"%s\",\n"
+               "  \"host\": {\"cpu\": \"%s\", \"procs\": %d},\n  \"merge\": \"%s\",\n"
+               "  \"stream_prefetch_bytes\": %ld,\n  \"stream_nontemporal\": %s,\n"
+               "  \"dram_gbs\": %.2f,\n  \"max_threads\": %d,\n  \"warmup\": %d,\n"
+               "  \"ops_per_element\": %d,\n  \"bytes_per_element\": %d,\n  \"results\": [\n",
+            M, N, P, minmax_isa(), json_cpu, omp_get_num_procs(), minmax_merge_name(minmax_get_merge()),
+            sp.prefetch_bytes, sp.nontemporal ? "true" : "false", dram_gbs, max_threads, warmup,
+            BENCH_OPS_ELEM, (int)sizeof(int));
+    for (int x = 0; x < n; x++) {
+        const BenchResult *r = &res[x];
+        fprintf(f, "    {\"version\": \"%s\", \"baseline\": \"%s\", \"threads\": %d, \"reps\": %d, "
+                   "\"min\": %.6f, \"median\": %.6f, \"mean\": %.6f, \"stddev\": %.6f, "
+                   "\"p95\": %.6f, \"p99\": %.6f, \"ci95\": [%.6f, %.6f], "
+                   "\"passes\": %d, \"gbs\": %.2f, \"peak_gbs\": %.2f, "
+                   "\"gops\": %.3f, \"peak_gops\": %.3f, \"correct\": %s",
+                r->e->name, r->e->baseline, r->threads, r->reps,
+                r->min, r->median, r->mean, r->stddev, r->p95, r->p99, r->ci_lo, r->ci_hi,
+                r->e->passes, r->gbs, r->peak_gbs, r->gops, r->peak_gops, r->ok ? "true" : "false");
+        fprintf(f, ", \"samples\": [");
+        for (int s = 0; s < r->reps; s++)
+            fprintf(f, "%s%.9f", s ? ", " : "", r->samples[s]);
+        fprintf(f, "]");
+        if (r->perf_valid) {
+            fprintf(f, ", \"counters\": {");
+            const char *sep = "";
+            for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++) {
+                if (!(r->perf_valid & (1u << e)))
+                    continue;
+                fprintf(f, "%s\"%s\": %llu", sep, minmax_perf_event_name((minmax_perf_event)e),
+                        (unsigned long long)r->perf.count[e]);
+                sep = ", ";
+            }
+            fprintf(f, "}");
+        }
+        fprintf(f, "}%s\n", x + 1 < n ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+    /* Pull out the harness flags; everything else goes to the shared parser */
+    int reps = 20, warmup = 3, use_perf = 0, tune = 0;
+    const char *threads_arg = NULL, *only = NULL, *csv_path = NULL, *json_path = NULL;
+    const char *tune_file = NULL;
+    double dram_gbs = 0;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+            reps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads_arg = argv[++i];
+        else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc)
+            only = argv[++i];
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            csv_path = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json_path = argv[++i];
+        else if (strcmp(argv[i], "--perf") == 0)
+            use_perf = 1;
+        else if (strcmp(argv[i], "--tune") == 0)
+            tune = 1;
+        else if (strcmp(argv[i], "--tune-file") == 0 && i + 1 < argc)
+            tune_file = argv[++i];
+        else if (strcmp(argv[i], "--dram-gbs") == 0 && i + 1 < argc)
+            dram_gbs = atof(argv[++i]);
+        else
+            argv[nargs++] = argv[i];
+    }
+    parse_args(nargs, argv);
+
+    int max_threads = omp_get_max_threads();
+    int threads[BENCH_MAX_THREADS], nthreads = 0;
+    if (threads_arg) {
+        char *end = (char *)threads_arg;
+        while (nthreads < BENCH_MAX_THREADS) {
+            long t = strtol(end, &end, 10);
+            if (t <= 0)
+                break;
+            threads[nthreads++] = (int)t;
+            if (*end != ',')
+                break;
+            end++;
+        }
+        if (*end != '\0')
+            nthreads = 0;
+    } else {
+        for (int t = 2; t <= max_threads && nthreads < BENCH_MAX_THREADS; t *= 2)
+            threads[nthreads++] = t;
+        if (nthreads == 0 || (threads[nthreads - 1] != max_threads && nthreads < BENCH_MAX_THREADS))
+            threads[nthreads++] = max_threads;
+    }
+    if (reps <= 0 || warmup < 0 || nthreads == 0 || dram_gbs < 0) {
+        fprintf(stderr, "usage: %s [--reps N] [--warmup W] [--threads T1,T2,...] [--only NAME,...] "
+                        "[--csv FILE] [--json FILE] [--perf] [--tune [--tune-file FILE]] [--dram-gbs G] "
+                        "[--shape MxNxP] [--input FILE]\n",
+                argv[0]);
+        return 2;
+    }
+
+    int need_ptr = 0;
+    for (int e = 0; e < NUM_ENTRIES; e++)
+        if (entries[e].ptr && selected(only, entries[e].name))
+            need_ptr = 1;
+
+    /* Allocate and first-touch once for the whole run */
+    int *a;
+    int ***ap = NULL;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+    if (need_ptr)
+        read_input(&ap, &M, &N, &P);
+    long total = (long)M * N * P;
+    double bytes = (double)total * sizeof(int);
+
+    MinMaxLoc rmin, rmax;
+    minmax_loc_3d(a, M, N, P, MINMAX_SEQUENTIAL, &rmin, &rmax);
+
+    /* Read and in-cache compute ceilings per thread count (and for the
+     * single-thread baselines) */
+    double peak[BENCH_MAX_THREADS + 1], peak_ops[BENCH_MAX_THREADS + 1];
+    omp_set_num_threads(1);
+    peak[BENCH_MAX_THREADS] = read_bandwidth(a, total);
+    peak_ops[BENCH_MAX_THREADS] = compute_ceiling(a, total);
+    for (int t = 0; t < nthreads; t++) {
+        omp_set_num_threads(threads[t]);
+        peak[t] = read_bandwidth(a, total);
+        peak_ops[t] = compute_ceiling(a, total);
+    }
+
+    double *t = (double *)xmalloc((size_t)reps * sizeof(double));
+    if (tune) {
+        printf("Tuning %dx%dx%d on %s\n", M, N, P, minmax_cpu_model());
+        for (int x = 0; x < nthreads; x++)
+            autotune(a, M, N, P, threads[x], reps, t);
+        if (minmax_tuning_save(tune_file) != 0)
+            fprintf(stderr, "warning: could not write the tuning cache%s%s\n",
+                    tune_file ? " " : "", tune_file ? tune_file : "");
+    }
+
+    printf("Shape %dx%dx%d (%.1f MB), ISA %s, %s merge, %d warm-up + %d timed runs\n",
+           M, N, P, bytes / 1e6, minmax_isa(), minmax_merge_name(minmax_get_merge()), warmup, reps);
+    printf("%-22s %3s %10s %10s %10s %10s %21s %7s %6s%s\n",
+           "version", "T", "min", "median", "p95", "p99", "95% CI (median)", "GB/s", "%peak",
+           dram_gbs > 0 ? "  %dram" : "");
+
+    minmax_perf *pc = NULL;
+    if (use_perf && !(pc = minmax_perf_open()))
+        fprintf(stderr, "warning: --perf needs a PERF=1 build; counters skipped\n");
+
+    BenchResult *res = (BenchResult *)xmalloc((size_t)NUM_ENTRIES * nthreads * sizeof(BenchResult));
+    int nres = 0, all_ok = 1;
+
+    for (int e = 0; e < NUM_ENTRIES; e++) {
+        const BenchEntry *be = &entries[e];
+        if (!selected(only, be->name))
+            continue;
+        int sequential = be->strategy == 0;   /* MINMAX_SEQUENTIAL / MINMAX_PTR_SEQUENTIAL */
+
+        for (int x = 0; x < (sequential ? 1 : nthreads); x++) {
+            int T = sequential ? 1 : threads[x];
+            omp_set_num_threads(T);
+
+            MinMaxLoc vmin, vmax;
+            int ok = 1;
+            for (int w = 0; w < warmup; w++)
+                run_once(be, a, ap, M, N, P, &vmin, &vmax);
+            for (int r = 0; r < reps; r++) {
+                double t0 = omp_get_wtime();
+                int rc = run_once(be, a, ap, M, N, P, &vmin, &vmax);
+                t[r] = omp_get_wtime() - t0;
+                if (rc != 0 || !same_loc(&vmin, &rmin) || !same_loc(&vmax, &rmax))
+                    ok = 0;
+            }
+
+            BenchResult *br = &res[nres++];
+            br->e = be;
+            br->threads = T;
+            br->ok = ok;
+            summarise(t, reps, br);
+            br->samples = (double *)xmalloc((size_t)reps * sizeof(double));
+            memcpy(br->samples, t, (size_t)reps * sizeof(double));
+            br->gbs = bytes * be->passes / br->median / 1e9;
+            br->peak_gbs = sequential ? peak[BENCH_MAX_THREADS] : peak[x];
+            br->gops = (double)BENCH_OPS_ELEM * total / br->median / 1e9;
+            br->peak_gops = sequential ? peak_ops[BENCH_MAX_THREADS] : peak_ops[x];
+            all_ok &= ok;
+
+            printf("%-22s %3d %10.6f %10.6f %10.6f %10.6f  [%.6f, %.6f] %7.2f %5.0f%%",
+                   be->name, T, br->min, br->median, br->p95, br->p99, br->ci_lo, br->ci_hi,
+                   br->gbs, 100 * br->gbs / br->peak_gbs);
+            if (dram_gbs > 0)
+                printf(" %6.0f%%", 100 * br->gbs / dram_gbs);
+            printf("%s\n", ok ? "" : "  FAIL");
+
+            br->perf_valid = 0;
+            if (pc) {
+                minmax_perf_start(pc);
+                double t0 = omp_get_wtime();
+                run_once(be, a, ap, M, N, P, &vmin, &vmax);
+                double dt = omp_get_wtime() - t0;
+                minmax_perf_stop(pc);
+                br->perf_valid = minmax_perf_valid(pc);
+                minmax_perf_total(pc, &br->perf);
+                print_perf(pc, dt);
+            }
+        }
+    }
+
+    printf("Read bandwidth ceiling: %.2f GB/s on 1 thread", peak[BENCH_MAX_THREADS]);
+    for (int x = 0; x < nthreads; x++)
+        if (threads[x] != 1)
+            printf(", %.2f on %d", peak[x], threads[x]);
+    if (dram_gbs > 0)
+        printf("; nominal DRAM peak %.2f GB/s", dram_gbs);
+    printf("\n");
+    printf("In-cache compute ceiling: %.2f GOPS on 1 thread", peak_ops[BENCH_MAX_THREADS]);
+    for (int x = 0; x < nthreads; x++)
+        if (threads[x] != 1)
+            printf(", %.2f on %d", peak_ops[x], threads[x]);
+    printf("\n");
+
+    if (csv_path)
+        write_csv(csv_path, res, nres, M, N, P);
+    if (json_path)
+        write_json(json_path, res, nres, M, N, P, max_threads, warmup, dram_gbs);
+    if (!all_ok)
+        fprintf(stderr, "warning: some results disagree with sequential_flat\n");
+
+    minmax_perf_close(pc);
+    free(t);
+    for (int x = 0; x < nres; x++)
+        free(res[x].samples);
+    free(res);
+    if (ap)
+        free_matrix(ap, M, N);
+    free_input_flat(a);
+    return all_ok ? 0 : 1;
+}
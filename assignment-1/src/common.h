@@ -3,25 +3,181 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 #include <omp.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "minmax.h"
 
 /* Default matrix dimensions — large enough for measurable parallelism */
 #define DEFAULT_M 500
 #define DEFAULT_N 500
 #define DEFAULT_P 500
 
+/*
+ * Problem shape used by read_input() / read_input_flat(). Defaults to
+ * DEFAULT_M x DEFAULT_N x DEFAULT_P; overridden by MINMAX_SHAPE=MxNxP in the
+ * environment, which is in turn overridden by --shape MxNxP on the command
+ * line (see parse_args()).
+ */
+static int input_m = DEFAULT_M, input_n = DEFAULT_N, input_p = DEFAULT_P;
+static int input_shape_given = 0;
+
+/*
+ * Optional volume file (--input FILE or MINMAX_INPUT): read_input_flat()
+ * maps it instead of generating data, so the drivers scan it in place.
+ */
+static const char *input_path = NULL;
+static minmax_volume input_vol;
+
+/*
+ * Set by run_flat() for MINMAX_NUMA: the generated matrix is first touched
+ * by minmax_numa_touch() so each node's slab is allocated on that node.
+ * A mapped file keeps wherever the page cache put it.
+ */
+static int input_numa = 0;
+
+/*
+ * Where generated matrices live (--alloc KIND or MINMAX_ALLOC): "thp"
+ * (default), "hugetlb" or "small" carve them from a 2 MB aligned
+ * minmax_arena with that page kind; "malloc" is the original allocation
+ * (one malloc for the flat layout, one per row and table for int***).
+ * Arena rows of the int*** layout are padded to minmax_row_stride(P) so
+ * each starts on a cache line.
+ */
+#define INPUT_ALLOC_MALLOC (-1)
+static int input_alloc = MINMAX_PAGES_THP;
+static minmax_arena input_arena;        /* flat matrix  */
+static minmax_arena input_ptr_arena;    /* int*** matrix */
+
+/* Parse "MxNxP"; returns 0 on success */
+__attribute__((unused))
+static int parse_shape(const char *s, int *M, int *N, int *P)
+{
+    long m, n, p;
+    char x1, x2, tail;
+    if (sscanf(s, "%ld%c%ld%c%ld%c", &m, &x1, &n, &x2, &p, &tail) != 5)
+        return -1;
+    if ((x1 != 'x' && x1 != 'X') || (x2 != 'x' && x2 != 'X'))
+        return -1;
+    if (m <= 0 || n <= 0 || p <= 0 || m > INT_MAX || n > INT_MAX || p > INT_MAX)
+        return -1;
+    /* The planted min (M-1, N-1, P-1) and max (M/2, N/2, P/2) must differ */
+    if (m <= 2 && n <= 2 && p <= 2)
+        return -1;
+    *M = (int)m; *N = (int)n; *P = (int)p;
+    return 0;
+}
+
+/* Apply MINMAX_SHAPE and --shape / -s; exits with a usage message on error */
+__attribute__((unused))
+static void parse_args(int argc, char **argv)
+{
+    const char *shape = getenv("MINMAX_SHAPE");
+    const char *alloc = getenv("MINMAX_ALLOC");
+    input_path = getenv("MINMAX_INPUT");
+
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--shape") == 0 || strcmp(argv[i], "-s") == 0) && i + 1 < argc) {
+            shape = argv[++i];
+        } else if (strncmp(argv[i], "--shape=", 8) == 0) {
+            shape = argv[i] + 8;
+        } else if ((strcmp(argv[i], "--input") == 0 || strcmp(argv[i], "-i") == 0) && i + 1 < argc) {
+            input_path = argv[++i];
+        } else if (strcmp(argv[i], "--alloc") == 0 && i + 1 < argc) {
+            alloc = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--shape MxNxP] [--input FILE] [--alloc malloc|thp|hugetlb|small]\n"
+                            "       (or MINMAX_SHAPE / MINMAX_INPUT / MINMAX_ALLOC)\n", argv[0]);
+            exit(2);
+        }
+    }
+
+    if (alloc && *alloc) {
+        input_alloc = INT_MIN;
+        if (strcmp(alloc, "malloc") == 0)
+            input_alloc = INPUT_ALLOC_MALLOC;
+        for (int k = 0; k < MINMAX_PAGES_NUM_KINDS; k++)
+            if (strcmp(alloc, minmax_pages_name((minmax_pages)k)) == 0)
+                input_alloc = k;
+        if (input_alloc == INT_MIN) {
+            fprintf(stderr, "%s: invalid allocation '%s' (malloc, thp, hugetlb or small)\n",
+                    argv[0], alloc);
+            exit(2);
+        }
+    }
+
+    if (shape && parse_shape(shape, &input_m, &input_n, &input_p) != 0) {
+        fprintf(stderr, "%s: invalid shape '%s' (expected MxNxP, not all dimensions <= 2)\n",
+                argv[0], shape);
+        exit(2);
+    }
+    input_shape_given = (shape != NULL);
+}
+
+/* Map the --input volume; the shape comes from its header unless --shape was given */
+__attribute__((unused))
+static const int *map_input(int *M, int *N, int *P)
+{
+    int m = input_shape_given ? input_m : 0;
+    int n = input_shape_given ? input_n : 0;
+    int p = input_shape_given ? input_p : 0;
+
+    /* Prefault only a volume that fits in the memory available now; a
+     * larger one is paged in on demand as the scan reaches it */
+    unsigned flags = 0;
+    struct stat st;
+    if (stat(input_path, &st) == 0) {
+        double avail = (double)sysconf(_SC_AVPHYS_PAGES) * sysconf(_SC_PAGESIZE);
+        if (avail > 0 && (double)st.st_size < avail)
+            flags = MINMAX_MAP_POPULATE;
+    }
+
+    if (minmax_volume_open(input_path, m, n, p, flags, &input_vol) != 0) {
+        fprintf(stderr, "cannot map volume '%s' (missing file, bad header or shape mismatch)\n",
+                input_path);
+        exit(1);
+    }
+    *M = input_vol.M;
+    *N = input_vol.N;
+    *P = input_vol.P;
+    return input_vol.data;
+}
+
+/* Abort with a clear message instead of dereferencing NULL on huge shapes */
+__attribute__((unused))
+static void *xmalloc(size_t bytes)
+{
+    void *p = malloc(bytes);
+    if (!p) {
+        fprintf(stderr, "out of memory allocating %zu bytes\n", bytes);
+        exit(1);
+    }
+    return p;
+}
+
 /* Random seed for reproducibility */
 #define SEED 42
 
 /*
- * Generate a wide-range random int in [0, 99999].
- * MinGW's RAND_MAX is only 32767, so we combine two rand() calls
- * to get enough bits for the full range.
+ * Counter-based generator: the value at flat index idx depends only on
+ * (SEED, idx), never on how many values were drawn before it. This lets
+ * every thread fill its own slice independently and still produce the exact
+ * same matrix for any thread count.
+ *
+ * The mixer is SplitMix64's finaliser applied to seed ^ index; the 64-bit
+ * result is mapped onto [0, 99999] with a multiply-shift (no modulo bias
+ * worth speaking of, and no division in the inner loop).
  */
-static int wide_rand(void)
+static inline int gen_value(unsigned long long seed, unsigned long long idx)
 {
-    return ((rand() << 15) | rand()) % 100000;
+    unsigned long long z = (seed * 0x9E3779B97F4A7C15ULL) ^ (idx + 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (int)(((z >> 32) * 100000ULL) >> 32);
 }
 
 /*
@@ -30,31 +186,75 @@ static int wide_rand(void)
  *
  * A unique minimum (-1) is planted at (M-1, N-1, P-1) and a unique
  * maximum (100000) at (M/2, N/2, P/2) so correctness can be verified
- * by checking that all versions report the same known indices.
+ * by checking that all versions report the same known indices. Both
+ * positions follow the runtime shape, so run_benchmarks.sh derives the
+ * expected output from the shape it passes in.
+ *
+ * The pointer tables and the rows are carved from one arena, each row
+ * padded to start on a cache line; --alloc malloc restores one malloc per
+ * row and table. The fill runs in parallel with the same schedule(static)
+ * split over i that the kernels use, so each row is first touched by the
+ * thread that will later scan it.
  */
 __attribute__((unused))
 static void read_input(int ****a, int *M, int *N, int *P)
 {
-    *M = DEFAULT_M;
-    *N = DEFAULT_N;
-    *P = DEFAULT_P;
+    const int *src = NULL;
+    if (input_path) {
+        src = map_input(M, N, P);
+    } else {
+        *M = input_m;
+        *N = input_n;
+        *P = input_p;
+    }
 
     int m = *M, n = *N, p = *P;
 
-    int ***arr = (int ***)malloc(m * sizeof(int **));
-    for (int i = 0; i < m; i++) {
-        arr[i] = (int **)malloc(n * sizeof(int *));
-        for (int j = 0; j < n; j++) {
-            arr[i][j] = (int *)malloc(p * sizeof(int));
+    int ***arr = NULL;
+    if (input_alloc != INPUT_ALLOC_MALLOC) {
+        /* One arena: the i table, all M*N row pointers, then padded rows */
+        long stride = minmax_row_stride(p);
+        size_t bytes = (size_t)m * sizeof(int **) + (size_t)m * n * sizeof(int *) +
+                       (size_t)m * n * stride * sizeof(int) + 3 * MINMAX_ROW_ALIGN;
+        if (minmax_arena_init(&input_ptr_arena, bytes, (minmax_pages)input_alloc) == 0) {
+            arr = (int ***)minmax_arena_alloc(&input_ptr_arena, (size_t)m * sizeof(int **), 0);
+            int **rows = (int **)minmax_arena_alloc(&input_ptr_arena, (size_t)m * n * sizeof(int *), 0);
+            int *data = (int *)minmax_arena_alloc(&input_ptr_arena,
+                                                  (size_t)m * n * stride * sizeof(int), 0);
+            for (int i = 0; i < m; i++) {
+                arr[i] = rows + (long)i * n;
+                for (int j = 0; j < n; j++)
+                    arr[i][j] = data + ((long)i * n + j) * stride;
+            }
+        }
+    }
+    if (!arr) {
+        arr = (int ***)xmalloc(m * sizeof(int **));
+        for (int i = 0; i < m; i++) {
+            arr[i] = (int **)xmalloc(n * sizeof(int *));
+            for (int j = 0; j < n; j++) {
+                arr[i][j] = (int *)xmalloc(p * sizeof(int));
+            }
         }
     }
 
+    if (src) {
+        /* Volume file: copy rows out of the mapping, no planting */
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < n; j++)
+                memcpy(arr[i][j], src + IDX(i, j, 0, n, p), (size_t)p * sizeof(int));
+        minmax_volume_close(&input_vol);
+        *a = arr;
+        return;
+    }
+
     /* Fill with deterministic pseudo-random values in [0, 99999] */
-    srand(SEED);
+    #pragma omp parallel for schedule(static)
     for (int i = 0; i < m; i++)
         for (int j = 0; j < n; j++)
             for (int k = 0; k < p; k++)
-                arr[i][j][k] = wide_rand();
+                arr[i][j][k] = gen_value(SEED, (unsigned long long)i * n * p + (unsigned long long)j * p + k);
 
     /* Plant a guaranteed unique minimum and maximum for verification */
     arr[m - 1][n - 1][p - 1] = -1;       /* unique min */
@@ -67,6 +267,10 @@ static void read_input(int ****a, int *M, int *N, int *P)
 __attribute__((unused))
 static void free_matrix(int ***a, int M, int N)
 {
+    if (input_ptr_arena.base && (char *)a == input_ptr_arena.base) {
+        minmax_arena_release(&input_ptr_arena);
+        return;
+    }
     for (int i = 0; i < M; i++) {
         for (int j = 0; j < N; j++)
             free(a[i][j]);
@@ -81,29 +285,51 @@ static void free_matrix(int ***a, int M, int N)
  *  Access element (i,j,k) as: a[i*N*P + j*P + k]
  * ================================================================ */
 
-/* Convenience macro for flat 3D indexing */
-#define IDX(i, j, k, N, P) ((i)*(N)*(P) + (j)*(P) + (k))
+/* IDX(i, j, k, N, P) — flat 3D indexing, defined in minmax.h */
 
 /*
  * Allocate a contiguous 1D block and fill it identically to read_input()
  * so that both layouts produce the same min/max results.
+ *
+ * The block comes from a 2 MB aligned huge-page arena (or malloc() with
+ * --alloc malloc). Either only reserves address space: the physical pages
+ * are placed on the NUMA node of whichever thread writes them first.
+ * Filling under the kernels' collapse(2) schedule(static) partition keeps
+ * each thread's slice on its own node instead of piling the whole array
+ * onto node 0.
+ *
+ * With --input the file is mapped read-only instead (no heap copy);
+ * release the result with free_input_flat().
  */
 __attribute__((unused))
 static void read_input_flat(int **a, int *M, int *N, int *P)
 {
-    *M = DEFAULT_M;
-    *N = DEFAULT_N;
-    *P = DEFAULT_P;
+    if (input_path) {
+        *a = (int *)map_input(M, N, P);
+        return;
+    }
+
+    *M = input_m;
+    *N = input_n;
+    *P = input_p;
 
     int m = *M, n = *N, p = *P;
 
-    int *arr = (int *)malloc((size_t)m * n * p * sizeof(int));
+    size_t bytes = (size_t)m * n * p * sizeof(int);
+    int *arr = NULL;
+    if (input_alloc != INPUT_ALLOC_MALLOC &&
+        minmax_arena_init(&input_arena, bytes, (minmax_pages)input_alloc) == 0)
+        arr = (int *)minmax_arena_alloc(&input_arena, bytes, 0);
+    if (!arr)
+        arr = (int *)xmalloc(bytes);
+    if (input_numa)
+        minmax_numa_touch(arr, (long)m * n * p);
 
-    srand(SEED);
+    #pragma omp parallel for collapse(2) schedule(static)
     for (int i = 0; i < m; i++)
         for (int j = 0; j < n; j++)
             for (int k = 0; k < p; k++)
-                arr[IDX(i, j, k, n, p)] = wide_rand();
+                arr[IDX(i, j, k, n, p)] = gen_value(SEED, IDX((unsigned long long)i, j, k, n, p));
 
     arr[IDX(m - 1, n - 1, p - 1, n, p)] = -1;       /* unique min */
     arr[IDX(m / 2, n / 2, p / 2, n, p)]  = 100000;   /* unique max */
@@ -111,33 +337,134 @@ static void read_input_flat(int **a, int *M, int *N, int *P)
     *a = arr;
 }
 
+/* Release a matrix from read_input_flat() (heap or mapped file) */
+__attribute__((unused))
+static void free_input_flat(int *a)
+{
+    if (input_vol.map && a == input_vol.data)
+        minmax_volume_close(&input_vol);
+    else if (input_arena.base && (char *)a == input_arena.base)
+        minmax_arena_release(&input_arena);
+    else
+        free(a);
+}
+
 /* ================================================================
- *  MinMaxLoc struct + declare reduction — used by optimized V1.
- *  Replaces critical sections with an efficient tree reduction.
+ *  Thin driver bodies. Every binary builds the input, times one call
+ *  into libminmax (lib/minmax.h) and prints the same three lines, which
+ *  run_benchmarks.sh parses for correctness and timing.
  * ================================================================ */
 
-typedef struct {
-    int val;
-    int i, j, k;
-} MinMaxLoc;
+__attribute__((unused))
+static void print_result(const MinMaxLoc *vmin, const MinMaxLoc *vmax, double seconds)
+{
+    printf("Min = %d at (%d, %d, %d)\n", vmin->val, vmin->i, vmin->j, vmin->k);
+    printf("Max = %d at (%d, %d, %d)\n", vmax->val, vmax->i, vmax->j, vmax->k);
+    printf("Time: %.6f seconds\n", seconds);
+}
 
-/* Combiners (used by declare reduction; may appear unused in some translation units) */
+/*
+ * Per-thread counter table for a region of `seconds` (PERF=1 builds only;
+ * pc is NULL otherwise and nothing is printed). Events the host could not
+ * count show as "-"; memory traffic is estimated as LLC misses x 64 B.
+ */
 __attribute__((unused))
-static void minloc_combine(MinMaxLoc *out, MinMaxLoc *in) {
-    if (in->val < out->val) *out = *in;
+static void print_perf(const minmax_perf *pc, double seconds)
+{
+    int nt = minmax_perf_threads(pc);
+    if (nt == 0)
+        return;
+    unsigned valid = minmax_perf_valid(pc);
+    int ipc = (valid & (1u << MINMAX_PERF_CYCLES)) && (valid & (1u << MINMAX_PERF_INSTRUCTIONS));
+
+    printf("Counters:%-6s", "");
+    for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++)
+        printf(" %14s", minmax_perf_event_name((minmax_perf_event)e));
+    printf(" %6s\n", "IPC");
+
+    minmax_perf_counts sum;
+    minmax_perf_total(pc, &sum);
+    for (int t = 0; t <= nt; t++) {
+        const minmax_perf_counts *c = t < nt ? minmax_perf_thread(pc, t) : &sum;
+        if (t < nt)
+            printf("  thread %-6d", t);
+        else
+            printf("  %-13s", "total");
+        for (int e = 0; e < MINMAX_PERF_NUM_EVENTS; e++) {
+            if (valid & (1u << e))
+                printf(" %14llu", (unsigned long long)c->count[e]);
+            else
+                printf(" %14s", "-");
+        }
+        if (ipc && c->count[MINMAX_PERF_CYCLES])
+            printf(" %6.2f", (double)c->count[MINMAX_PERF_INSTRUCTIONS] / c->count[MINMAX_PERF_CYCLES]);
+        printf("\n");
+    }
+    if ((valid & (1u << MINMAX_PERF_LLC_MISSES)) && seconds > 0)
+        printf("  memory traffic ~ %.2f GB/s (LLC misses x %d B)\n",
+               (double)sum.count[MINMAX_PERF_LLC_MISSES] * MINMAX_PERF_LINE_BYTES / seconds / 1e9,
+               MINMAX_PERF_LINE_BYTES);
 }
+
+/* Driver for the contiguous layout */
 __attribute__((unused))
-static void maxloc_combine(MinMaxLoc *out, MinMaxLoc *in) {
-    if (in->val > out->val) *out = *in;
+static int run_flat(int argc, char **argv, minmax_strategy s)
+{
+    parse_args(argc, argv);
+    input_numa = (s == MINMAX_NUMA);
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+
+    MinMaxLoc vmin, vmax;
+    minmax_perf *pc = minmax_perf_open();   /* NULL unless built with PERF=1 */
+
+    minmax_perf_start(pc);
+    double t_start = omp_get_wtime();
+    int rc = minmax_loc_3d(a, M, N, P, s, &vmin, &vmax);
+    double t_end = omp_get_wtime();
+    minmax_perf_stop(pc);
+
+    if (rc == 0)
+        print_result(&vmin, &vmax, t_end - t_start);
+    else
+        fprintf(stderr, "minmax_loc_3d(%s) failed\n", minmax_strategy_name(s));
+    print_perf(pc, t_end - t_start);
+    minmax_perf_close(pc);
+
+    free_input_flat(a);
+    return rc == 0 ? 0 : 1;
 }
 
-/* Custom reductions */
-#pragma omp declare reduction(minloc : MinMaxLoc : \
-        minloc_combine(&omp_out, &omp_in)) \
-        initializer(omp_priv = (MinMaxLoc){ .val = INT_MAX, .i = 0, .j = 0, .k = 0 })
+/* Driver for the int*** layout */
+__attribute__((unused))
+static int run_ptr(int argc, char **argv, minmax_ptr_strategy s)
+{
+    parse_args(argc, argv);
+
+    int ***a;
+    int M, N, P;
+    read_input(&a, &M, &N, &P);
+
+    MinMaxLoc vmin, vmax;
+    minmax_perf *pc = minmax_perf_open();   /* NULL unless built with PERF=1 */
+
+    minmax_perf_start(pc);
+    double t_start = omp_get_wtime();
+    int rc = minmax_loc_3d_ptr((int *const *const *)a, M, N, P, s, &vmin, &vmax);
+    double t_end = omp_get_wtime();
+    minmax_perf_stop(pc);
 
-#pragma omp declare reduction(maxloc : MinMaxLoc : \
-        maxloc_combine(&omp_out, &omp_in)) \
-        initializer(omp_priv = (MinMaxLoc){ .val = INT_MIN, .i = 0, .j = 0, .k = 0 })
+    if (rc == 0)
+        print_result(&vmin, &vmax, t_end - t_start);
+    else
+        fprintf(stderr, "minmax_loc_3d_ptr(%s) failed\n", minmax_ptr_strategy_name(s));
+    print_perf(pc, t_end - t_start);
+    minmax_perf_close(pc);
+
+    free_matrix(a, M, N);
+    return rc == 0 ? 0 : 1;
+}
 
 #endif /* COMMON_H */
@@ -0,0 +1,213 @@
+/*
+ * Tool: distributed min/max over a volume sharded along M across MPI ranks.
+ *
+ *     mpirun -np R mpi_scan [--reps K] [--strategy NAME] [--shape MxNxP] [--input FILE]
+ *
+ * Rank r owns the i-planes [M*r/R, M*(r+1)/R). Without --input every rank
+ * generates its own slab from the global indices, so the data (and the
+ * planted min/max) are exactly those of the single-node drivers; with
+ * --input each rank reads its slab straight from the shared file with
+ * collective MPI-IO (headed or raw, as elsewhere). Each rank then runs the
+ * OpenMP + SIMD kernel (default ultimate) on its slab, shifts the winners'
+ * i by the slab origin and the ranks are combined with MPI_Reduce and a
+ * user-defined MPI_Op over the (min, max) pair. The op applies the library
+ * rule: smaller (larger) value first, then the lower (i, j, k), so the
+ * answer and its position match minmax_loc_3d() on the whole volume.
+ *
+ * Timing starts after a barrier and stops when the root has the reduced
+ * result; with --reps K rank 0 reports the median and the minimum of K
+ * runs (after one warm-up) and the median of the slowest rank's local
+ * scan, so the gap between the two is the cost of the reduction. Only
+ * the master thread calls MPI (MPI_THREAD_FUNNELED).
+ */
+#include "common.h"
+#include <mpi.h>
+
+typedef struct {
+    MinMaxLoc min, max;
+} MinMaxPair;
+
+/* Lexicographic (i, j, k), i.e. global flat order */
+static int loc_before(const MinMaxLoc *a, const MinMaxLoc *b)
+{
+    if (a->i != b->i) return a->i < b->i;
+    if (a->j != b->j) return a->j < b->j;
+    return a->k < b->k;
+}
+
+static void pair_combine(void *in_, void *inout_, int *len, MPI_Datatype *type)
+{
+    (void)type;
+    const MinMaxPair *in = in_;
+    MinMaxPair *io = inout_;
+    for (int x = 0; x < *len; x++) {
+        if (in[x].min.val < io[x].min.val ||
+            (in[x].min.val == io[x].min.val && loc_before(&in[x].min, &io[x].min)))
+            io[x].min = in[x].min;
+        if (in[x].max.val > io[x].max.val ||
+            (in[x].max.val == io[x].max.val && loc_before(&in[x].max, &io[x].max)))
+            io[x].max = in[x].max;
+    }
+}
+
+static int cmp_double(const void *x, const void *y)
+{
+    double a = *(const double *)x, b = *(const double *)y;
+    return (a > b) - (a < b);
+}
+
+/* Read planes [i0, i1) of the file into slab with collective MPI-IO */
+static int read_slab(const char *path, long data_off, int i0, int i1, int N, int P, int *slab)
+{
+    if ((long)N * P > INT_MAX)
+        return -1;
+
+    MPI_File fh;
+    if (MPI_File_open(MPI_COMM_WORLD, path, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+        return -1;
+
+    /* One element of the plane type is a whole i-plane, so the count fits an int */
+    MPI_Datatype plane;
+    MPI_Type_contiguous(N * P, MPI_INT, &plane);
+    MPI_Type_commit(&plane);
+    MPI_Offset off = (MPI_Offset)data_off + (MPI_Offset)i0 * N * P * (MPI_Offset)sizeof(int);
+    int rc = MPI_File_read_at_all(fh, off, slab, i1 - i0, plane, MPI_STATUS_IGNORE);
+    MPI_Type_free(&plane);
+    MPI_File_close(&fh);
+    return rc == MPI_SUCCESS ? 0 : -1;
+}
+
+int main(int argc, char **argv)
+{
+    int provided, rank, nranks;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+
+    /* Pull out --reps / --strategy; everything else goes to the shared parser */
+    int reps = 1;
+    minmax_strategy strategy = MINMAX_ULTIMATE;
+    int nargs = 1, bad_args = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            bad_args = 1;
+            for (int s = 0; s < MINMAX_NUM_STRATEGIES; s++)
+                if (strcmp(name, minmax_strategy_name(s)) == 0) {
+                    strategy = s;
+                    bad_args = 0;
+                }
+        } else {
+            argv[nargs++] = argv[i];
+        }
+    }
+    parse_args(nargs, argv);
+    if (reps <= 0 || bad_args) {
+        if (rank == 0)
+            fprintf(stderr, "usage: %s [--reps K>0] [--strategy NAME] [--shape MxNxP] [--input FILE]\n",
+                    argv[0]);
+        MPI_Finalize();
+        return 2;
+    }
+
+    int M = input_m, N = input_n, P = input_p;
+    long data_off = 0;
+    if (input_path) {
+        if (!input_shape_given)
+            M = N = P = 0;
+        if (minmax_volume_probe(input_path, &M, &N, &P, &data_off) != 0) {
+            if (rank == 0)
+                fprintf(stderr, "cannot read volume '%s' (missing file, bad header or shape mismatch)\n",
+                        input_path);
+            MPI_Finalize();
+            return 1;
+        }
+    }
+
+    /* This rank's slab of i-planes */
+    int i0 = (int)((long)M * rank / nranks);
+    int i1 = (int)((long)M * (rank + 1) / nranks);
+    int mine = i1 - i0;
+    int *slab = mine > 0 ? (int *)xmalloc((size_t)mine * N * P * sizeof(int)) : NULL;
+    int load_rc = 0;
+
+    if (input_path) {
+        load_rc = read_slab(input_path, data_off, i0, i1, N, P, slab);
+    } else if (mine > 0) {
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int i = i0; i < i1; i++)
+            for (int j = 0; j < N; j++)
+                for (int k = 0; k < P; k++)
+                    slab[IDX(i - i0, j, k, N, P)] =
+                        gen_value(SEED, IDX((unsigned long long)i, j, k, N, P));
+        if (M - 1 >= i0 && M - 1 < i1)
+            slab[IDX(M - 1 - i0, N - 1, P - 1, N, P)] = -1;        /* unique min */
+        if (M / 2 >= i0 && M / 2 < i1)
+            slab[IDX(M / 2 - i0, N / 2, P / 2, N, P)] = 100000;    /* unique max */
+    }
+
+    int any_failed;
+    MPI_Allreduce(&load_rc, &any_failed, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (any_failed) {
+        if (rank == 0)
+            fprintf(stderr, "MPI-IO read of '%s' failed (planes over 2^31 elements are not supported)\n",
+                    input_path);
+        free(slab);
+        MPI_Finalize();
+        return 1;
+    }
+
+    MPI_Datatype pair_type;
+    MPI_Type_contiguous(sizeof(MinMaxPair) / sizeof(int), MPI_INT, &pair_type);
+    MPI_Type_commit(&pair_type);
+    MPI_Op pair_op;
+    MPI_Op_create(pair_combine, 1, &pair_op);
+
+    double *times = (double *)xmalloc((size_t)reps * sizeof(double));
+    double *local = (double *)xmalloc((size_t)reps * sizeof(double));
+    MinMaxPair global;
+
+    for (int r = -1; r < reps; r++) {           /* r = -1: warm-up */
+        /* Identity for ranks without planes: loses to any real position */
+        MinMaxPair part = { { INT_MAX, INT_MAX, INT_MAX, INT_MAX },
+                            { INT_MIN, INT_MAX, INT_MAX, INT_MAX } };
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        double t0 = MPI_Wtime();
+        if (mine > 0) {
+            minmax_loc_3d(slab, mine, N, P, strategy, &part.min, &part.max);
+            part.min.i += i0;
+            part.max.i += i0;
+        }
+        double t_local = MPI_Wtime() - t0;
+        MPI_Reduce(&part, &global, 1, pair_type, pair_op, 0, MPI_COMM_WORLD);
+        double t = MPI_Wtime() - t0;
+
+        double t_max, tl_max;
+        MPI_Reduce(&t, &t_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&t_local, &tl_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (r >= 0) {
+            times[r] = t_max;
+            local[r] = tl_max;
+        }
+    }
+
+    if (rank == 0) {
+        qsort(times, (size_t)reps, sizeof(double), cmp_double);
+        qsort(local, (size_t)reps, sizeof(double), cmp_double);
+        print_result(&global.min, &global.max, times[reps / 2]);
+        printf("Ranks: %d x %d threads, %s, %dx%dx%d; min %.6f s, slowest local scan %.6f s\n",
+               nranks, omp_get_max_threads(), minmax_strategy_name(strategy), M, N, P,
+               times[0], local[reps / 2]);
+    }
+
+    MPI_Op_free(&pair_op);
+    MPI_Type_free(&pair_type);
+    free(times);
+    free(local);
+    free(slab);
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,25 @@
+/*
+ * Novel Approach: Compile-Time Specialised Kernels for Fixed Shapes
+ *
+ * Production volumes come in a few fixed shapes, yet the generic kernels
+ * recompute row offsets and test for a tail on every row. For each
+ * (N, P) listed in MINMAX_FIXED_SHAPES (256^3, 512^3, 1024x1024x64):
+ *   - the row length and block size are constants, so the row scan is
+ *     fully unrolled and, with P % 8 == 0, has no scalar tail
+ *   - a 16 KB block is folded by value only (vpminsd / vpmaxsd); the
+ *     first index is recovered with cmpeq + movemask only in blocks that
+ *     beat the running best
+ *   - block offsets and the final (i, j, k) conversion fold into
+ *     constants
+ * Any other shape (including the default 500^3) runs novel_ultimate;
+ * try --shape 512x512x512.
+ *
+ * The kernels live in lib/minmax_fixed*.c; this file is a thin driver
+ * over minmax_loc_3d(MINMAX_FIXED).
+ */
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+    return run_flat(argc, argv, MINMAX_FIXED);
+}
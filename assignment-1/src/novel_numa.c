@@ -0,0 +1,30 @@
+/*
+ * Novel Approach: NUMA-Aware Slabs with a Two-Level Reduction
+ *
+ * On a multi-socket machine novel_ultimate stops scaling at one socket:
+ * the matrix is filled by whichever threads the runtime happened to put
+ * where, so most threads stream their tiles over the interconnect, and
+ * all partial results meet in one flat reduction.
+ *
+ * Here the threads are pinned node by node and each node owns one
+ * contiguous slab of the volume:
+ *   - first touch: the driver zeroes the buffer from the pinned threads
+ *     (minmax_numa_touch) before filling it, so every page lives on the
+ *     node whose threads scan it
+ *   - scan: each thread runs the dispatched SIMD kernel over its part of
+ *     its node's slab, from local memory only
+ *   - reduce: per node first (threads on the same socket, shared L3),
+ *     then across nodes (one value per socket crosses the interconnect)
+ *
+ * On a single-node host this is a pinned static SIMD scan; set
+ * MINMAX_NUMA_NODES=2 to exercise the hierarchy anyway.
+ *
+ * The kernel lives in lib/minmax_numa.c; this file is a thin driver over
+ * minmax_loc_3d(MINMAX_NUMA).
+ */
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+    return run_flat(argc, argv, MINMAX_NUMA);
+}
@@ -0,0 +1,26 @@
+/*
+ * Novel Approach: Bandwidth-Bound Streaming Scan
+ *
+ * novel_ultimate is built around cache tiles; on a full scan with many
+ * threads the limit is DRAM bandwidth instead, and what matters is keeping
+ * enough loads in flight. Here:
+ *   - each thread scans one contiguous, cache-line-aligned range in a
+ *     single kernel call (no tiles, no partial rows)
+ *   - the kernel keeps four independent accumulator sets, so the compare
+ *     of one vector never waits on the blend of the previous one
+ *   - software prefetch runs MINMAX_PREFETCH bytes ahead (default 4096)
+ *   - with MINMAX_NT=1 loads are non-temporal (NTA prefetch, MOVNTDQA),
+ *     since every element is read exactly once
+ *
+ * bench reports each version's GB/s against the measured read ceiling
+ * (and against a nominal DRAM peak with --dram-gbs).
+ *
+ * The kernel lives in lib/minmax_stream.c and lib/scan_*.c; this file is
+ * a thin driver over minmax_loc_3d(MINMAX_STREAM).
+ */
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+    return run_flat(argc, argv, MINMAX_STREAM);
+}
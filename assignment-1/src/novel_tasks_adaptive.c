@@ -0,0 +1,22 @@
+/*
+ * Novel Approach: Task-Based Divide & Conquer with an Adaptive Cut-off
+ *
+ * Same fused min+max task tree as novel_tasks.c, but the leaf size is not a
+ * fixed 64K elements: it is total / (threads * 16), so each thread always
+ * has about 16 leaves in the pool regardless of array size (never below 8K
+ * elements, where spawn cost starts to rival the scan).
+ *
+ * With static parallel for a thread that is slowed down (SMT sibling busy,
+ * lower clock, noisy neighbour) holds up the whole loop; here idle threads
+ * steal its remaining leaves. On uniform hardware it should match
+ * novel_ultimate; when thread speeds differ it should beat it.
+ *
+ * The kernel lives in lib/minmax_tasks.c; this file is a thin driver over
+ * minmax_loc_3d(MINMAX_TASKS_ADAPTIVE).
+ */
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+    return run_flat(argc, argv, MINMAX_TASKS_ADAPTIVE);
+}
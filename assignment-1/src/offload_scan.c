@@ -0,0 +1,139 @@
+/*
+ * Tool: accelerator offload vs the CPU kernel, transfer and kernel timed apart.
+ *
+ *     offload_scan [--backend openmp|cuda] [--reps K] [--shape MxNxP] [--input FILE]
+ *
+ * Uploads the volume once with minmax_dev_upload(), then runs K queries
+ * (default 10, after one warm-up) on the resident copy, and K calls of
+ * minmax_loc_3d(MINMAX_ULTIMATE) on the host array. Prints the transfer,
+ * the median kernel and the median CPU time with their bandwidths, and the
+ * number of queries after which the one-off transfer has paid for itself
+ * (never if the device kernel is not faster than the CPU). Every device
+ * result is checked against the CPU one, and so are the results on small
+ * volumes holding only INT_MAX or only INT_MIN.
+ */
+#include "common.h"
+
+static int cmp_double(const void *x, const void *y)
+{
+    double a = *(const double *)x, b = *(const double *)y;
+    return (a > b) - (a < b);
+}
+
+static int same_loc(const MinMaxLoc *a, const MinMaxLoc *b)
+{
+    return a->val == b->val && a->i == b->i && a->j == b->j && a->k == b->k;
+}
+
+/* A volume of one identity value: the reductions never leave their seed */
+static int check_uniform(minmax_dev_backend backend, int value)
+{
+    enum { UM = 3, UN = 17, UP = 19 };          /* n % 4 != 0: vector and tail paths */
+    static int u[UM * UN * UP];
+    for (int x = 0; x < UM * UN * UP; x++)
+        u[x] = value;
+
+    MinMaxLoc cmin, cmax, dmin, dmax;
+    minmax_dev *d = minmax_dev_upload(backend, u, UM, UN, UP, NULL);
+    if (!d || minmax_dev_query(d, &dmin, &dmax, NULL) != 0) {
+        minmax_dev_free(d);
+        return 1;
+    }
+    minmax_dev_free(d);
+    minmax_loc_3d(u, UM, UN, UP, MINMAX_ULTIMATE, &cmin, &cmax);
+    return !same_loc(&dmin, &cmin) || !same_loc(&dmax, &cmax);
+}
+
+int main(int argc, char **argv)
+{
+    /* Pull out --backend / --reps; everything else goes to the shared parser */
+    minmax_dev_backend backend = MINMAX_DEV_OPENMP;
+    int reps = 10, bad_args = 0;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            bad_args = 1;
+            for (int b = 0; b < MINMAX_DEV_NUM_BACKENDS; b++)
+                if (strcmp(name, minmax_dev_backend_name(b)) == 0) {
+                    backend = b;
+                    bad_args = 0;
+                }
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else {
+            argv[nargs++] = argv[i];
+        }
+    }
+    parse_args(nargs, argv);
+
+    if (reps <= 0 || bad_args) {
+        fprintf(stderr, "usage: %s [--backend openmp|cuda] [--reps K>0] [--shape MxNxP] [--input FILE]\n",
+                argv[0]);
+        return 2;
+    }
+
+    int devices = minmax_dev_count(backend);
+    if (devices < 0 || (backend == MINMAX_DEV_CUDA && devices == 0)) {
+        fprintf(stderr, "backend '%s' is not available (%s)\n", minmax_dev_backend_name(backend),
+                devices < 0 ? "not built, see make CUDA=1" : "no device");
+        return 1;
+    }
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+    double gb = (double)M * N * P * sizeof(int) / 1e9;
+
+    minmax_dev_timing up, q;
+    minmax_dev *d = minmax_dev_upload(backend, a, M, N, P, &up);
+    if (!d) {
+        fprintf(stderr, "minmax_dev_upload() failed (out of device memory?)\n");
+        return 1;
+    }
+
+    MinMaxLoc cmin, cmax, dmin, dmax;
+    double *t_dev = (double *)xmalloc((size_t)reps * sizeof(double));
+    double *t_cpu = (double *)xmalloc((size_t)reps * sizeof(double));
+    int bad = 0;
+
+    for (int r = -1; r < reps; r++) {           /* r = -1: warm-up */
+        if (minmax_dev_query(d, &dmin, &dmax, &q) != 0) {
+            fprintf(stderr, "minmax_dev_query() failed\n");
+            return 1;
+        }
+        double t0 = omp_get_wtime();
+        minmax_loc_3d(a, M, N, P, MINMAX_ULTIMATE, &cmin, &cmax);
+        double t = omp_get_wtime() - t0;
+        if (r >= 0) {
+            t_dev[r] = q.kernel;
+            t_cpu[r] = t;
+        }
+        bad |= !same_loc(&dmin, &cmin) || !same_loc(&dmax, &cmax);
+    }
+    bad |= check_uniform(backend, INT_MAX) || check_uniform(backend, INT_MIN);
+    qsort(t_dev, (size_t)reps, sizeof(double), cmp_double);
+    qsort(t_cpu, (size_t)reps, sizeof(double), cmp_double);
+    double kern = t_dev[reps / 2], cpu = t_cpu[reps / 2];
+
+    print_result(&dmin, &dmax, kern);
+    printf("Backend %s on %s (%d device%s)\n", minmax_dev_backend_name(backend),
+           devices > 0 ? "device" : "host fallback", devices, devices == 1 ? "" : "s");
+    printf("Transfer    %10.6f s  %7.2f GB/s\n", up.transfer, gb / up.transfer);
+    printf("Kernel      %10.6f s  %7.2f GB/s  (median of %d)\n", kern, gb / kern, reps);
+    printf("CPU         %10.6f s  %7.2f GB/s  (ultimate, %d threads)\n", cpu, gb / cpu,
+           omp_get_max_threads());
+    if (kern < cpu)
+        printf("Offload pays off from query %ld (one-shot: %.6f s vs %.6f s)\n",
+               (long)(up.transfer / (cpu - kern)) + 1, up.transfer + kern, cpu);
+    else
+        printf("Offload does not pay off: the kernel is not faster than the CPU\n");
+    if (bad)
+        fprintf(stderr, "warning: device result differs from the CPU kernel\n");
+
+    free(t_dev);
+    free(t_cpu);
+    minmax_dev_free(d);
+    free_input_flat(a);
+    return bad != 0;
+}
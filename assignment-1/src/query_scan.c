@@ -0,0 +1,89 @@
+/*
+ * Tool: latency of many small repeated scans, one-shot vs a query context.
+ *
+ *     query_scan [--queries Q] [--shape MxNxP] [--input FILE]
+ *
+ * Runs Q queries (default 10000) over the same volume, default 100x100x100
+ * (1M elements, 4 MB), first with minmax_loc_3d(MINMAX_ULTIMATE), which
+ * opens a parallel region per call, then with one minmax_ctx created up
+ * front. Prints median / p99 / max latency per query for both, and checks
+ * that every context result matches the one-shot one.
+ */
+#include "common.h"
+
+static int cmp_double(const void *x, const void *y)
+{
+    double a = *(const double *)x, b = *(const double *)y;
+    return (a > b) - (a < b);
+}
+
+static void report(const char *label, double *lat, int q)
+{
+    qsort(lat, (size_t)q, sizeof(double), cmp_double);
+    int p99 = (int)((q * 99L + 99) / 100) - 1;     /* nearest rank */
+    printf("%-10s median %8.2f us   p99 %8.2f us   max %8.2f us\n",
+           label, lat[q / 2] * 1e6, lat[p99] * 1e6, lat[q - 1] * 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    /* Pull out --queries; everything else goes to the shared parser */
+    int queries = 10000;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc)
+            queries = atoi(argv[++i]);
+        else
+            argv[nargs++] = argv[i];
+    }
+    input_m = input_n = input_p = 100;
+    parse_args(nargs, argv);
+
+    if (queries <= 0) {
+        fprintf(stderr, "usage: %s [--queries Q>0] [--shape MxNxP] [--input FILE]\n", argv[0]);
+        return 2;
+    }
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+
+    double *lat = (double *)xmalloc((size_t)queries * sizeof(double));
+    MinMaxLoc vmin, vmax, cmin, cmax;
+
+    for (int q = 0; q < queries; q++) {
+        double t0 = omp_get_wtime();
+        minmax_loc_3d(a, M, N, P, MINMAX_ULTIMATE, &vmin, &vmax);
+        lat[q] = omp_get_wtime() - t0;
+    }
+    report("ultimate", lat, queries);
+
+    double t0 = omp_get_wtime();
+    minmax_ctx *ctx = minmax_ctx_create(M, N, P, 0);
+    double t_create = omp_get_wtime() - t0;
+    if (!ctx) {
+        fprintf(stderr, "minmax_ctx_create() failed\n");
+        return 1;
+    }
+
+    int bad = 0;
+    for (int q = 0; q < queries; q++) {
+        t0 = omp_get_wtime();
+        minmax_ctx_query(ctx, a, &cmin, &cmax);
+        lat[q] = omp_get_wtime() - t0;
+        if (cmin.val != vmin.val || cmin.i != vmin.i || cmin.j != vmin.j || cmin.k != vmin.k ||
+            cmax.val != vmax.val || cmax.i != vmax.i || cmax.j != vmax.j || cmax.k != vmax.k)
+            bad++;
+    }
+    report("context", lat, queries);
+    printf("Context: %d threads, created in %.1f us\n", minmax_ctx_threads(ctx), t_create * 1e6);
+    print_result(&cmin, &cmax, lat[queries / 2]);
+    if (bad)
+        fprintf(stderr, "warning: %d of %d context queries disagree with minmax_loc_3d()\n",
+                bad, queries);
+
+    minmax_ctx_free(ctx);
+    free(lat);
+    free_input_flat(a);
+    return bad != 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Tool: many concurrent clients, direct kernel calls vs the query service.
+ *
+ *     service_scan [--clients C] [--queries Q] [--workers W] [--threads T]
+ *                  [--batch B] [--box-edge E] [--mix F] [--index]
+ *                  [--shape MxNxP] [--input FILE]
+ *
+ * Starts C client threads (default 8), each issuing Q queries (default 200)
+ * back to back: min/max over a box of edge E (default 64) at a
+ * pseudo-random offset, or with probability F (default 0.25) a count above
+ * a random threshold over such a box. First every client calls
+ * minmax_query_batch() with its one query directly, so each call forks its
+ * own OpenMP team; then the same queries go through one minmax_service
+ * (config from W, T, B and --index). Prints throughput and p50 / p95 / p99 /
+ * max latency for both, the service counters, and checks that every
+ * service answer matches the direct one.
+ */
+#include "common.h"
+#include <pthread.h>
+
+typedef struct {
+    const int      *a;
+    int             M, N, P;
+    minmax_service *svc;        /* NULL: direct calls */
+    minmax_query   *q;          /* this client's queries, answered in place */
+    double         *lat;
+    int             nq;
+} Client;
+
+static int cmp_double(const void *x, const void *y)
+{
+    double a = *(const double *)x, b = *(const double *)y;
+    return (a > b) - (a < b);
+}
+
+static void report(const char *label, double *lat, long n, double wall)
+{
+    qsort(lat, (size_t)n, sizeof(double), cmp_double);
+    long p50 = (n * 50 + 99) / 100 - 1, p95 = (n * 95 + 99) / 100 - 1,
+         p99 = (n * 99 + 99) / 100 - 1;                   /* nearest rank */
+    printf("%-8s %9.0f q/s   p50 %9.1f us   p95 %9.1f us   p99 %9.1f us   max %9.1f us\n",
+           label, n / wall, lat[p50] * 1e6, lat[p95] * 1e6, lat[p99] * 1e6, lat[n - 1] * 1e6);
+}
+
+static void *client_run(void *arg)
+{
+    Client *c = (Client *)arg;
+    for (int x = 0; x < c->nq; x++) {
+        double t0 = omp_get_wtime();
+        if (c->svc) {
+            minmax_request r = { .q = c->q[x] };
+            if (minmax_service_query(c->svc, &r) == 0)
+                c->q[x] = r.q;
+        } else {
+            minmax_query_batch(c->a, c->M, c->N, c->P, &c->q[x], 1);
+        }
+        c->lat[x] = omp_get_wtime() - t0;
+    }
+    return NULL;
+}
+
+/* Run every client to completion; returns the wall time */
+static double run_clients(Client *cl, pthread_t *tid, int nc)
+{
+    double t0 = omp_get_wtime();
+    for (int c = 0; c < nc; c++)
+        if (pthread_create(&tid[c], NULL, client_run, &cl[c]) != 0) {
+            fprintf(stderr, "pthread_create failed\n");
+            exit(1);
+        }
+    for (int c = 0; c < nc; c++)
+        pthread_join(tid[c], NULL);
+    return omp_get_wtime() - t0;
+}
+
+/* Edge-e range at a pseudo-random offset inside [0, len) */
+static void random_range(int len, int e, unsigned *seed, int *lo, int *hi)
+{
+    int ext = e < len ? e : len;
+    *lo = (int)(rand_r(seed) % (unsigned)(len - ext + 1));
+    *hi = *lo + ext;
+}
+
+static int same_answer(const minmax_query *x, const minmax_query *y)
+{
+    if (x->kind == MINMAX_QUERY_COUNT_ABOVE)
+        return x->count == y->count;
+    return x->min.val == y->min.val && x->min.i == y->min.i && x->min.j == y->min.j &&
+           x->min.k == y->min.k && x->max.val == y->max.val && x->max.i == y->max.i &&
+           x->max.j == y->max.j && x->max.k == y->max.k;
+}
+
+int main(int argc, char **argv)
+{
+    /* Pull out the service flags; everything else goes to the shared parser */
+    int clients = 8, queries = 200, edge = 64;
+    double mix = 0.25;
+    minmax_service_config cfg = { 0 };
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc)
+            clients = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc)
+            queries = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc)
+            cfg.workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            cfg.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+            cfg.batch_max = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--box-edge") == 0 && i + 1 < argc)
+            edge = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--mix") == 0 && i + 1 < argc)
+            mix = atof(argv[++i]);
+        else if (strcmp(argv[i], "--index") == 0)
+            cfg.index = 1;
+        else
+            argv[nargs++] = argv[i];
+    }
+    parse_args(nargs, argv);
+    if (clients <= 0 || queries <= 0 || edge <= 0 || mix < 0 || mix > 1) {
+        fprintf(stderr, "usage: %s [--clients C>0] [--queries Q>0] [--workers W] [--threads T]\n"
+                        "       [--batch B] [--box-edge E>0] [--mix F in 0..1] [--index]\n"
+                        "       [--shape MxNxP] [--input FILE]\n", argv[0]);
+        return 2;
+    }
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+
+    long total = (long)clients * queries;
+    minmax_query *direct = (minmax_query *)xmalloc((size_t)total * sizeof(minmax_query));
+    minmax_query *served = (minmax_query *)xmalloc((size_t)total * sizeof(minmax_query));
+    double *lat = (double *)xmalloc((size_t)total * sizeof(double));
+    Client *cl = (Client *)xmalloc((size_t)clients * sizeof(Client));
+    pthread_t *tid = (pthread_t *)xmalloc((size_t)clients * sizeof(pthread_t));
+
+    /* Deterministic per-client query streams */
+    for (int c = 0; c < clients; c++) {
+        unsigned seed = 12345u + 7919u * (unsigned)c;
+        for (int x = 0; x < queries; x++) {
+            minmax_query *q = &direct[(long)c * queries + x];
+            memset(q, 0, sizeof(*q));
+            q->kind = rand_r(&seed) < mix * ((double)RAND_MAX + 1) ? MINMAX_QUERY_COUNT_ABOVE
+                                                                    : MINMAX_QUERY_MINMAX;
+            random_range(M, edge, &seed, &q->box.i0, &q->box.i1);
+            random_range(N, edge, &seed, &q->box.j0, &q->box.j1);
+            random_range(P, edge, &seed, &q->box.k0, &q->box.k1);
+            q->threshold = rand_r(&seed) % 100000;
+        }
+    }
+    memcpy(served, direct, (size_t)total * sizeof(minmax_query));
+
+    printf("Shape %dx%dx%d, %d clients x %d queries, box edge %d, %.0f%% counts\n",
+           M, N, P, clients, queries, edge, 100 * mix);
+
+    for (int c = 0; c < clients; c++)
+        cl[c] = (Client){ a, M, N, P, NULL, direct + (long)c * queries,
+                          lat + (long)c * queries, queries };
+    double wall = run_clients(cl, tid, clients);
+    report("direct", lat, total, wall);
+
+    double t0 = omp_get_wtime();
+    minmax_service *svc = minmax_service_create(a, M, N, P, &cfg);
+    double t_create = omp_get_wtime() - t0;
+    if (!svc) {
+        fprintf(stderr, "minmax_service_create() failed\n");
+        return 1;
+    }
+    for (int c = 0; c < clients; c++)
+        cl[c] = (Client){ a, M, N, P, svc, served + (long)c * queries,
+                          lat + (long)c * queries, queries };
+    wall = run_clients(cl, tid, clients);
+    report("service", lat, total, wall);
+
+    minmax_service_stats st;
+    minmax_service_get_stats(svc, &st);
+    printf("Service: %d workers x %d threads (of %d), created in %.1f us%s\n",
+           st.workers, st.share, st.threads, t_create * 1e6, cfg.index ? " with zone map" : "");
+    printf("  %ld requests, %ld passes, %ld coalesced, %ld index hits, %ld failed\n",
+           st.completed, st.passes, st.coalesced, st.index_hits, st.failed);
+    minmax_service_free(svc);
+
+    long bad = 0;
+    for (long x = 0; x < total; x++)
+        bad += !same_answer(&direct[x], &served[x]);
+    if (bad)
+        fprintf(stderr, "warning: %ld of %ld service answers disagree with direct calls\n",
+                bad, total);
+
+    free(tid);
+    free(cl);
+    free(lat);
+    free(served);
+    free(direct);
+    free_input_flat(a);
+    return bad != 0 || st.failed != 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Tool: fused statistics pass vs one pass per statistic.
+ *
+ *     stats_scan [--bins B] [--range LO:HI] [--shape MxNxP] [--input FILE]
+ *
+ * Runs minmax_stats_3d() with a B-bin histogram over [LO, HI] (default 256
+ * bins over the generator's 0:99999), then the pipeline it replaces:
+ * minmax_loc_3d(MINMAX_ULTIMATE), a sum pass, a squared-deviation pass
+ * and a histogram pass. Prints both times and checks that min/max, sum
+ * and histogram agree exactly and the variance to 1e-9 relative.
+ */
+#include "common.h"
+#include <math.h>
+
+int main(int argc, char **argv)
+{
+    /* Pull out --bins / --range; everything else goes to the shared parser */
+    int nbins = 256, lo = 0, hi = 99999;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bins") == 0 && i + 1 < argc)
+            nbins = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--range") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d:%d", &lo, &hi) != 2)
+                lo = 1, hi = 0;
+        } else
+            argv[nargs++] = argv[i];
+    }
+    parse_args(nargs, argv);
+
+    if (nbins <= 0 || nbins > MINMAX_HIST_MAX_BINS || lo > hi) {
+        fprintf(stderr, "usage: %s [--bins B] [--range LO:HI] [--shape MxNxP] [--input FILE]\n",
+                argv[0]);
+        return 2;
+    }
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+    long total = (long)M * N * P;
+
+    long *bins = (long *)xmalloc((size_t)nbins * sizeof(long));
+    long *ref  = (long *)xmalloc((size_t)nbins * sizeof(long));
+    minmax_hist h = { .lo = lo, .hi = hi, .nbins = nbins, .bins = bins };
+    minmax_stats st;
+
+    double t_start = omp_get_wtime();
+    if (minmax_stats_3d(a, M, N, P, &st, &h) != 0) {
+        fprintf(stderr, "minmax_stats_3d() failed\n");
+        return 1;
+    }
+    double t_fused = omp_get_wtime() - t_start;
+
+    /* The separate passes */
+    MinMaxLoc vmin, vmax;
+    long long sum = 0;
+    double m2 = 0;
+    long below = 0, above = 0;
+    long range = (long)hi - lo + 1;
+    memset(ref, 0, (size_t)nbins * sizeof(long));
+
+    t_start = omp_get_wtime();
+    minmax_loc_3d(a, M, N, P, MINMAX_ULTIMATE, &vmin, &vmax);
+
+    #pragma omp parallel for reduction(+ : sum)
+    for (long x = 0; x < total; x++)
+        sum += a[x];
+
+    double mean = (double)sum / total;
+    #pragma omp parallel for reduction(+ : m2)
+    for (long x = 0; x < total; x++)
+        m2 += (a[x] - mean) * (a[x] - mean);
+
+    #pragma omp parallel for reduction(+ : ref[:nbins], below, above)
+    for (long x = 0; x < total; x++) {
+        if (a[x] < lo)      below++;
+        else if (a[x] > hi) above++;
+        else                ref[((long)a[x] - lo) * nbins / range]++;
+    }
+    double t_sep = omp_get_wtime() - t_start;
+
+    int bad = st.min.val != vmin.val || st.min.i != vmin.i || st.min.j != vmin.j ||
+              st.min.k != vmin.k || st.max.val != vmax.val || st.max.i != vmax.i ||
+              st.max.j != vmax.j || st.max.k != vmax.k;
+    bad |= (st.sum != sum) << 1;
+    bad |= (fabs(st.variance - m2 / total) > 1e-9 * (m2 / total)) << 2;
+    bad |= (memcmp(bins, ref, (size_t)nbins * sizeof(long)) != 0 ||
+            h.below != below || h.above != above) << 3;
+
+    print_result(&st.min, &st.max, t_fused);
+    printf("Sum = %lld, mean = %.6f, variance = %.6f, %d bins over [%d, %d] (%ld below, %ld above)\n",
+           st.sum, st.mean, st.variance, nbins, lo, hi, h.below, h.above);
+    printf("Fused pass: %.6f s, four passes: %.6f s (%.1fx)\n", t_fused, t_sep, t_sep / t_fused);
+    if (bad)
+        fprintf(stderr, "warning: fused result differs from the separate passes (mask %d)\n", bad);
+
+    free(bins);
+    free(ref);
+    free_input_flat(a);
+    return bad != 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * Tool: the K coldest and hottest voxels.
+ *
+ *     topk_scan [--k K] [--shape MxNxP] [--input FILE]
+ *
+ * Runs minmax_topk_3d() (default K = 10) on the usual generated volume, or
+ * a volume file, and prints both lists followed by the time. The first
+ * entry of each list is the planted min / max.
+ */
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+    /* Pull out --k; everything else goes to the shared parser */
+    int k = 10;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--k") == 0 && i + 1 < argc)
+            k = atoi(argv[++i]);
+        else
+            argv[nargs++] = argv[i];
+    }
+    parse_args(nargs, argv);
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+
+    MinMaxLoc *smallest = (MinMaxLoc *)xmalloc((size_t)(k > 0 ? k : 1) * sizeof(MinMaxLoc));
+    MinMaxLoc *largest  = (MinMaxLoc *)xmalloc((size_t)(k > 0 ? k : 1) * sizeof(MinMaxLoc));
+
+    double t_start = omp_get_wtime();
+    int rc = minmax_topk_3d(a, M, N, P, k, smallest, largest);
+    double t_end = omp_get_wtime();
+
+    if (rc == 0) {
+        for (int r = 0; r < k; r++)
+            printf("Min[%d] = %d at (%d, %d, %d)\n", r, smallest[r].val,
+                   smallest[r].i, smallest[r].j, smallest[r].k);
+        for (int r = 0; r < k; r++)
+            printf("Max[%d] = %d at (%d, %d, %d)\n", r, largest[r].val,
+                   largest[r].i, largest[r].j, largest[r].k);
+        printf("Time: %.6f seconds\n", t_end - t_start);
+    } else {
+        fprintf(stderr, "minmax_topk_3d(k = %d) failed\n", k);
+    }
+
+    free(smallest);
+    free(largest);
+    free_input_flat(a);
+    return rc == 0 ? 0 : 1;
+}
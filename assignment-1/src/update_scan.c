@@ -0,0 +1,96 @@
+/*
+ * Tool: keep min/max current under batched point updates.
+ *
+ *     update_scan [--updates U] [--steps S] [--shape MxNxP] [--input FILE]
+ *
+ * Builds a zone map over the usual volume, then S times (default 10)
+ * applies a batch of U random writes (default 10000) with
+ * minmax_index_update() and queries the whole volume. Every batch also
+ * overwrites the current min and max cells with ordinary values, the case
+ * that forces a tile rescan. Prints the mean time per batch + query next
+ * to a full minmax_loc_3d(MINMAX_ULTIMATE) rescan, and checks that both
+ * agree after every step.
+ */
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+    /* Pull out --updates / --steps; everything else goes to the shared parser */
+    long nupd = 10000;
+    int steps = 10;
+    int nargs = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--updates") == 0 && i + 1 < argc)
+            nupd = atol(argv[++i]);
+        else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+            steps = atoi(argv[++i]);
+        else
+            argv[nargs++] = argv[i];
+    }
+    parse_args(nargs, argv);
+
+    if (nupd < 2 || steps <= 0) {
+        fprintf(stderr, "usage: %s [--updates U>=2] [--steps S] [--shape MxNxP] [--input FILE]\n",
+                argv[0]);
+        return 2;
+    }
+
+    int *a;
+    int M, N, P;
+    read_input_flat(&a, &M, &N, &P);
+    long total = (long)M * N * P;
+
+    double t_start = omp_get_wtime();
+    minmax_index *ix = minmax_index_build(a, M, N, P);
+    double t_build = omp_get_wtime() - t_start;
+    if (!ix) {
+        fprintf(stderr, "minmax_index_build() failed\n");
+        return 1;
+    }
+    minmax_update *u = (minmax_update *)xmalloc((size_t)nupd * sizeof(minmax_update));
+
+    MinMaxLoc vmin, vmax, fmin, fmax;
+    minmax_index_query(ix, NULL, &vmin, &vmax);
+
+    double t_update = 0, t_full = 0;
+    int bad = 0;
+    unsigned long long draw = 0;
+    for (int s = 0; s < steps; s++) {
+        /* Knock out the current extremes, then scatter the rest */
+        u[0] = (minmax_update){ vmin.i, vmin.j, vmin.k, gen_value(SEED + s, draw++) };
+        u[1] = (minmax_update){ vmax.i, vmax.j, vmax.k, gen_value(SEED + s, draw++) };
+        for (long q = 2; q < nupd; q++) {
+            unsigned long long hi = gen_value(SEED + s, draw++);
+            long at = (long)((hi * 100000ULL + gen_value(SEED + s, draw++)) % total);
+            u[q] = (minmax_update){ (int)(at / ((long)N * P)), (int)(at / P % N), (int)(at % P),
+                                    gen_value(SEED + s, draw++) };
+        }
+
+        t_start = omp_get_wtime();
+        if (minmax_index_update(ix, a, u, nupd) != 0) {
+            fprintf(stderr, "minmax_index_update() failed\n");
+            return 1;
+        }
+        minmax_index_query(ix, NULL, &vmin, &vmax);
+        t_update += omp_get_wtime() - t_start;
+
+        t_start = omp_get_wtime();
+        minmax_loc_3d(a, M, N, P, MINMAX_ULTIMATE, &fmin, &fmax);
+        t_full += omp_get_wtime() - t_start;
+
+        if (vmin.val != fmin.val || vmin.i != fmin.i || vmin.j != fmin.j || vmin.k != fmin.k ||
+            vmax.val != fmax.val || vmax.i != fmax.i || vmax.j != fmax.j || vmax.k != fmax.k)
+            bad++;
+    }
+
+    print_result(&vmin, &vmax, t_update / steps);
+    printf("Batch of %ld updates + query: %.6f s, full rescan: %.6f s (build %.6f)\n",
+           nupd, t_update / steps, t_full / steps, t_build);
+    if (bad)
+        fprintf(stderr, "warning: %d of %d steps disagree with a full rescan\n", bad, steps);
+
+    free(u);
+    minmax_index_free(ix);
+    free_input_flat(a);
+    return bad != 0;
+}